@@ -0,0 +1,223 @@
+// Copyright © 2023 Apple Inc.
+
+// Measures tasks/sec of core::ThreadPool against the previous single-queue
+// pool (reproduced below as QueuePool) on tiny tasks, which is where
+// scheduling overhead dominates (e.g. prefetch on tokenization samples).
+//
+// Usage: thread_pool [num_tasks] [thread_count...]
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mlx/data/core/ThreadPool.h"
+
+namespace {
+
+// The pool before the work-stealing rewrite: a single mutex and std::queue,
+// with the same task containers and per task thread limits as its enqueue
+// and workers.
+class QueuePool {
+ public:
+  QueuePool(size_t thread_count) {
+    if (!thread_controller_) {
+      thread_controller_ =
+          std::make_shared<mlx::data::core::ThreadController>();
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+      threads_.emplace_back([this]() {
+        std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+        while (true) {
+          lock.lock();
+          cv_.wait(lock, [this]() { return !tasks_.empty() || stop_; });
+          if (stop_ && tasks_.empty()) {
+            return;
+          }
+          auto task = std::move(tasks_.front());
+          tasks_.pop();
+          lock.unlock();
+
+          auto thread_state = thread_controller_->limit();
+          (*task)();
+          thread_controller_->restore(thread_state);
+        }
+      });
+    }
+  }
+  ~QueuePool() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  template <typename F>
+  auto enqueue(F&& f) {
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    std::packaged_task<std::invoke_result_t<F>()> task_pkg(
+        [f = std::move(f)]() mutable { return f(); });
+    auto future = task_pkg.get_future();
+
+    lock.lock();
+    tasks_.emplace(new TaskContainer(
+        [task(std::move(task_pkg))]() mutable { task(); }));
+    lock.unlock();
+
+    cv_.notify_one();
+    return future;
+  }
+
+ private:
+  class TaskContainerBase {
+   public:
+    virtual ~TaskContainerBase() {};
+
+    virtual void operator()() = 0;
+  };
+
+  template <typename F>
+  class TaskContainer : public TaskContainerBase {
+   public:
+    TaskContainer(F&& func) : f_(std::forward<F>(func)) {}
+
+    void operator()() override {
+      f_();
+    }
+
+   private:
+    F f_;
+  };
+
+  std::vector<std::thread> threads_;
+  std::queue<std::unique_ptr<TaskContainerBase>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+  static std::shared_ptr<mlx::data::core::ThreadController> thread_controller_;
+};
+
+std::shared_ptr<mlx::data::core::ThreadController>
+    QueuePool::thread_controller_ = nullptr;
+
+volatile int64_t sink;
+
+// A few hundred nanoseconds of work, about what a small transform costs.
+int64_t work(int64_t seed) {
+  int64_t x = seed;
+  for (int i = 0; i < 64; i++) {
+    x = x * 6364136223846793005LL + 1442695040888963407LL;
+  }
+  return x;
+}
+
+// Prefetch-like: keep `window` tasks in flight, consume them in order.
+template <typename Pool>
+double bench_window(Pool& pool, int64_t num_tasks, int64_t window) {
+  auto start = std::chrono::steady_clock::now();
+  std::queue<std::future<int64_t>> futures;
+  int64_t checksum = 0;
+  for (int64_t i = 0; i < num_tasks; i++) {
+    if (static_cast<int64_t>(futures.size()) == window) {
+      checksum += futures.front().get();
+      futures.pop();
+    }
+    futures.push(pool.enqueue([i]() { return work(i); }));
+  }
+  while (!futures.empty()) {
+    checksum += futures.front().get();
+    futures.pop();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  // keeps the work from being optimized away
+  sink = checksum;
+  return num_tasks / elapsed.count();
+}
+
+// Several producers enqueueing concurrently, as when multiple prefetch
+// stages share a pool.
+template <typename Pool>
+double bench_producers(Pool& pool, int64_t num_tasks, int num_producers) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (int p = 0; p < num_producers; p++) {
+    producers.emplace_back([&pool, num_tasks, num_producers]() {
+      std::vector<std::future<int64_t>> futures;
+      futures.reserve(num_tasks / num_producers);
+      for (int64_t i = 0; i < num_tasks / num_producers; i++) {
+        futures.push_back(pool.enqueue([i]() { return work(i); }));
+      }
+      for (auto& future : futures) {
+        future.get();
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return num_tasks / elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  int64_t num_tasks = (argc > 1) ? std::atoll(argv[1]) : 1000000;
+  std::vector<size_t> thread_counts;
+  for (int i = 2; i < argc; i++) {
+    thread_counts.push_back(std::atoll(argv[i]));
+  }
+  if (thread_counts.empty()) {
+    thread_counts = {1, 4, 16, 32};
+  }
+
+  std::cout << "threads  benchmark        queue (tasks/s)  "
+            << "work-stealing (tasks/s)  speedup" << std::endl;
+  for (auto thread_count : thread_counts) {
+    auto report = [thread_count](
+                      const std::string& name, double base, double ws) {
+      std::cout << thread_count << "\t " << name << "\t  " << int64_t(base)
+                << "\t\t   " << int64_t(ws) << "\t\t\t    " << ws / base
+                << "x" << std::endl;
+    };
+    {
+      double base, ws;
+      {
+        QueuePool pool(thread_count);
+        base = bench_window(pool, num_tasks, 2 * thread_count);
+      }
+      {
+        mlx::data::core::ThreadPool pool(thread_count);
+        ws = bench_window(pool, num_tasks, 2 * thread_count);
+      }
+      report("window       ", base, ws);
+    }
+    {
+      double base, ws;
+      {
+        QueuePool pool(thread_count);
+        base = bench_producers(pool, num_tasks, 4);
+      }
+      {
+        mlx::data::core::ThreadPool pool(thread_count);
+        ws = bench_producers(pool, num_tasks, 4);
+      }
+      report("4 producers  ", base, ws);
+    }
+  }
+
+  return 0;
+}
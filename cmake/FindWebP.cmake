@@ -0,0 +1,47 @@
+# Try to find libwebp
+#
+# Provides the cmake config target - WebP::webp
+#
+# Inputs: WebP_INC_DIR: include directory for webp headers WebP_LIB_DIR:
+# directory containing webp libraries WebP_ROOT_DIR: directory containing webp
+# installation
+#
+# Defines: WebP_FOUND - system has libwebp WebP_INCLUDE_DIRS - the libwebp
+# include directory WebP_LIBRARIES - Link these to use libwebp
+#
+
+find_package(WebP CONFIG QUIET)
+
+if(NOT TARGET WebP::webp)
+  find_path(
+    WebP_INCLUDE_DIR webp/decode.h
+    PATHS ${WebP_INC_DIR} ${WebP_ROOT_DIR}/include
+    PATH_SUFFIXES include)
+
+  find_library(
+    WebP_LIBRARY webp
+    PATHS ${WebP_LIB_DIR} ${WebP_ROOT_DIR}
+    PATH_SUFFIXES lib)
+
+  set(WebP_INCLUDE_DIRS ${WebP_INCLUDE_DIR})
+  set(WebP_LIBRARIES ${WebP_LIBRARY})
+
+  mark_as_advanced(WebP_INCLUDE_DIRS WebP_LIBRARIES)
+  include(FindPackageHandleStandardArgs)
+  find_package_handle_standard_args(WebP DEFAULT_MSG WebP_INCLUDE_DIRS
+                                    WebP_LIBRARIES)
+
+  if(WebP_FOUND)
+    add_library(WebP::webp UNKNOWN IMPORTED)
+    set_target_properties(
+      WebP::webp PROPERTIES INTERFACE_INCLUDE_DIRECTORIES "${WebP_INCLUDE_DIRS}"
+                            IMPORTED_LOCATION "${WebP_LIBRARIES}")
+    message(
+      STATUS
+        "Found libwebp: (lib: ${WebP_LIBRARIES} include: ${WebP_INCLUDE_DIRS})")
+  else()
+    message(STATUS "libwebp not found.")
+  endif()
+else()
+  set(WebP_FOUND TRUE)
+endif() # NOT TARGET WebP::webp
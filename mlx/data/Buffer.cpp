@@ -7,6 +7,7 @@
 #include "mlx/data/buffer/DynamicBatch.h"
 #include "mlx/data/buffer/FilesFromTAR.h"
 #include "mlx/data/buffer/FromVector.h"
+#include "mlx/data/buffer/ImageResizeBatch.h"
 #include "mlx/data/buffer/Partition.h"
 #include "mlx/data/buffer/Perm.h"
 #include "mlx/data/buffer/Shuffle.h"
@@ -42,6 +43,27 @@ Buffer Buffer::batch(
       self_, batch_sizes, pad_values, batch_dims));
 }
 
+Buffer Buffer::image_resize_batch(
+    int64_t batch_size,
+    const std::string& key,
+    int64_t w,
+    int64_t h,
+    const std::string& filter,
+    int num_threads,
+    const std::unordered_map<std::string, double>& pad_values,
+    const std::unordered_map<std::string, int>& batch_dims) const {
+  return Buffer(std::make_shared<buffer::ImageResizeBatch>(
+      self_,
+      batch_size,
+      key,
+      w,
+      h,
+      filter,
+      num_threads,
+      pad_values,
+      batch_dims));
+}
+
 Buffer Buffer::dynamic_batch(
     const std::string& key,
     int64_t min_data_size,
@@ -27,6 +27,19 @@ class Buffer : public Dataset<Buffer, buffer::Buffer> {
       const std::unordered_map<std::string, double>& pad_values = {},
       const std::unordered_map<std::string, int>& batch_dims = {}) const;
 
+  /// Batches like batch(), but resizes the images at key to (w, h) into a
+  /// single [B, h, w, C] array using the given filter ("box", "bilinear",
+  /// "bicubic" or "lanczos") and up to num_threads threads.
+  Buffer image_resize_batch(
+      int64_t batch_size,
+      const std::string& key,
+      int64_t w,
+      int64_t h,
+      const std::string& filter = "bilinear",
+      int num_threads = 0,
+      const std::unordered_map<std::string, double>& pad_values = {},
+      const std::unordered_map<std::string, int>& batch_dims = {}) const;
+
   Buffer dynamic_batch(
       const std::string& key,
       int64_t min_data_size = 0, // ignore if <= 0
@@ -8,6 +8,7 @@
 #include "mlx/data/stream/Stream.h"
 #include "mlx/data/stream/Transform.h"
 
+#include "mlx/data/op/AudioFeatures.h"
 #include "mlx/data/op/FilterByShape.h"
 #include "mlx/data/op/FilterKey.h"
 #include "mlx/data/op/ImageTransform.h"
@@ -117,6 +118,33 @@ T Dataset<T, B>::image_channel_reduction_if(
   }
 }
 
+template <class T, class B>
+T Dataset<T, B>::image_normalize(
+    const std::string& ikey,
+    const std::vector<float>& mean,
+    const std::vector<float>& stddev,
+    bool channels_first,
+    const std::string& okey) const {
+  return transform_(std::make_shared<op::ImageNormalize>(
+      ikey, mean, stddev, channels_first, okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_normalize_if(
+    bool cond,
+    const std::string& ikey,
+    const std::vector<float>& mean,
+    const std::vector<float>& stddev,
+    bool channels_first,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::ImageNormalize>(
+        ikey, mean, stddev, channels_first, okey));
+  } else {
+    return T(self_);
+  }
+}
+
 template <class T, class B>
 T Dataset<T, B>::image_random_area_crop(
     const std::string& ikey,
@@ -239,8 +267,10 @@ T Dataset<T, B>::image_rotate(
     const std::string& ikey,
     double angle,
     bool crop,
+    const std::string& interpolation,
     const std::string& okey) const {
-  return transform_(std::make_shared<op::ImageRotate>(ikey, angle, crop, okey));
+  return transform_(std::make_shared<op::ImageRotate>(
+      ikey, angle, crop, interpolation, okey));
 }
 
 template <class T, class B>
@@ -249,10 +279,162 @@ T Dataset<T, B>::image_rotate_if(
     const std::string& ikey,
     double angle,
     bool crop,
+    const std::string& interpolation,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::ImageRotate>(
+        ikey, angle, crop, interpolation, okey));
+  } else {
+    return T(self_);
+  }
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_affine(
+    const std::string& ikey,
+    const std::vector<float>& matrix,
+    bool crop,
+    const std::string& interpolation,
+    const std::string& okey) const {
+  return transform_(std::make_shared<op::ImageAffine>(
+      ikey, matrix, crop, interpolation, okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_affine_if(
+    bool cond,
+    const std::string& ikey,
+    const std::vector<float>& matrix,
+    bool crop,
+    const std::string& interpolation,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::ImageAffine>(
+        ikey, matrix, crop, interpolation, okey));
+  } else {
+    return T(self_);
+  }
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_random_affine(
+    const std::string& ikey,
+    std::pair<float, float> rotation_range,
+    std::pair<float, float> scale_range,
+    std::pair<float, float> shear_range,
+    std::pair<float, float> translate_range,
+    bool crop,
+    const std::string& interpolation,
+    const std::string& okey) const {
+  return transform_(std::make_shared<op::ImageRandomAffine>(
+      ikey,
+      rotation_range,
+      scale_range,
+      shear_range,
+      translate_range,
+      crop,
+      interpolation,
+      okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_random_affine_if(
+    bool cond,
+    const std::string& ikey,
+    std::pair<float, float> rotation_range,
+    std::pair<float, float> scale_range,
+    std::pair<float, float> shear_range,
+    std::pair<float, float> translate_range,
+    bool crop,
+    const std::string& interpolation,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::ImageRandomAffine>(
+        ikey,
+        rotation_range,
+        scale_range,
+        shear_range,
+        translate_range,
+        crop,
+        interpolation,
+        okey));
+  } else {
+    return T(self_);
+  }
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_random_color_jitter(
+    const std::string& ikey,
+    float brightness,
+    float contrast,
+    float saturation,
+    float hue,
+    const std::string& okey) const {
+  return transform_(std::make_shared<op::ImageRandomColorJitter>(
+      ikey, brightness, contrast, saturation, hue, okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_random_color_jitter_if(
+    bool cond,
+    const std::string& ikey,
+    float brightness,
+    float contrast,
+    float saturation,
+    float hue,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::ImageRandomColorJitter>(
+        ikey, brightness, contrast, saturation, hue, okey));
+  } else {
+    return T(self_);
+  }
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_random_grayscale(
+    const std::string& ikey,
+    float prob,
+    const std::string& okey) const {
+  return transform_(
+      std::make_shared<op::ImageRandomGrayscale>(ikey, prob, okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_random_grayscale_if(
+    bool cond,
+    const std::string& ikey,
+    float prob,
     const std::string& okey) const {
   if (cond) {
     return transform_(
-        std::make_shared<op::ImageRotate>(ikey, angle, crop, okey));
+        std::make_shared<op::ImageRandomGrayscale>(ikey, prob, okey));
+  } else {
+    return T(self_);
+  }
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_gaussian_blur(
+    const std::string& ikey,
+    std::pair<float, float> sigma_range,
+    int kernel_size,
+    const std::string& okey) const {
+  return transform_(std::make_shared<op::ImageGaussianBlur>(
+      ikey, sigma_range, kernel_size, okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::image_gaussian_blur_if(
+    bool cond,
+    const std::string& ikey,
+    std::pair<float, float> sigma_range,
+    int kernel_size,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::ImageGaussianBlur>(
+        ikey, sigma_range, kernel_size, okey));
   } else {
     return T(self_);
   }
@@ -308,6 +490,9 @@ T Dataset<T, B>::load_audio(
     int sampleRate,
     LoadAudioResamplingQuality resamplingQuality,
     const std::string& info_key,
+    double offsetSeconds,
+    double durationSeconds,
+    bool randomCrop,
     const std::string& okey) const {
   return transform_(std::make_shared<op::LoadAudio>(
       ikey,
@@ -318,6 +503,9 @@ T Dataset<T, B>::load_audio(
       sampleRate,
       resamplingQuality,
       info_key,
+      offsetSeconds,
+      durationSeconds,
+      randomCrop,
       okey));
 }
 
@@ -332,6 +520,9 @@ T Dataset<T, B>::load_audio_if(
     int sampleRate,
     LoadAudioResamplingQuality resamplingQuality,
     const std::string& info_key,
+    double offsetSeconds,
+    double durationSeconds,
+    bool randomCrop,
     const std::string& okey) const {
   if (cond) {
     return transform_(std::make_shared<op::LoadAudio>(
@@ -343,6 +534,9 @@ T Dataset<T, B>::load_audio_if(
         sampleRate,
         resamplingQuality,
         info_key,
+        offsetSeconds,
+        durationSeconds,
+        randomCrop,
         okey));
   } else {
     return T(self_);
@@ -388,6 +582,113 @@ T Dataset<T, B>::resample_audio_if(
   }
 }
 
+template <class T, class B>
+T Dataset<T, B>::audio_mel_filterbank(
+    const std::string& ikey,
+    int sampleRate,
+    int numFilters,
+    float lowFreq,
+    float highFreq,
+    const std::string& scale,
+    float floor,
+    bool log,
+    const std::string& okey) const {
+  return transform_(std::make_shared<op::AudioMelFilterbank>(
+      ikey,
+      sampleRate,
+      numFilters,
+      lowFreq,
+      highFreq,
+      scale,
+      floor,
+      log,
+      okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::audio_mel_filterbank_if(
+    bool cond,
+    const std::string& ikey,
+    int sampleRate,
+    int numFilters,
+    float lowFreq,
+    float highFreq,
+    const std::string& scale,
+    float floor,
+    bool log,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::AudioMelFilterbank>(
+        ikey,
+        sampleRate,
+        numFilters,
+        lowFreq,
+        highFreq,
+        scale,
+        floor,
+        log,
+        okey));
+  } else {
+    return T(self_);
+  }
+}
+
+template <class T, class B>
+T Dataset<T, B>::audio_mfcc(
+    const std::string& ikey,
+    int numCoefficients,
+    const std::string& okey) const {
+  return transform_(
+      std::make_shared<op::AudioMFCC>(ikey, numCoefficients, okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::audio_mfcc_if(
+    bool cond,
+    const std::string& ikey,
+    int numCoefficients,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(
+        std::make_shared<op::AudioMFCC>(ikey, numCoefficients, okey));
+  } else {
+    return T(self_);
+  }
+}
+
+template <class T, class B>
+T Dataset<T, B>::audio_stft(
+    const std::string& ikey,
+    int64_t nFFT,
+    int64_t frameLength,
+    int64_t hopLength,
+    const std::string& window,
+    float preEmphasis,
+    float power,
+    const std::string& okey) const {
+  return transform_(std::make_shared<op::AudioSTFT>(
+      ikey, nFFT, frameLength, hopLength, window, preEmphasis, power, okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::audio_stft_if(
+    bool cond,
+    const std::string& ikey,
+    int64_t nFFT,
+    int64_t frameLength,
+    int64_t hopLength,
+    const std::string& window,
+    float preEmphasis,
+    float power,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::AudioSTFT>(
+        ikey, nFFT, frameLength, hopLength, window, preEmphasis, power, okey));
+  } else {
+    return T(self_);
+  }
+}
+
 template <class T, class B>
 T Dataset<T, B>::load_file(
     const std::string& ikey,
@@ -416,9 +717,18 @@ T Dataset<T, B>::load_image(
     bool info,
     const std::string& format,
     bool fromMemory,
+    int64_t resizeSmallestSide,
+    std::shared_ptr<core::image::ImageCache> cache,
     const std::string& okey) const {
   return transform_(std::make_shared<op::LoadImage>(
-      ikey, prefix, info, format, fromMemory, okey));
+      ikey,
+      prefix,
+      info,
+      format,
+      fromMemory,
+      resizeSmallestSide,
+      cache,
+      okey));
 }
 
 template <class T, class B>
@@ -429,10 +739,70 @@ T Dataset<T, B>::load_image_if(
     bool info,
     const std::string& format,
     bool fromMemory,
+    int64_t resizeSmallestSide,
+    std::shared_ptr<core::image::ImageCache> cache,
     const std::string& okey) const {
   if (cond) {
     return transform_(std::make_shared<op::LoadImage>(
-        ikey, prefix, info, format, fromMemory, okey));
+        ikey,
+        prefix,
+        info,
+        format,
+        fromMemory,
+        resizeSmallestSide,
+        cache,
+        okey));
+  } else {
+    return T(self_);
+  }
+}
+
+template <class T, class B>
+T Dataset<T, B>::load_image_random_area_crop(
+    const std::string& ikey,
+    std::pair<float, float> area_range,
+    std::pair<float, float> aspect_ratio_range,
+    int num_trial,
+    const std::string& prefix,
+    bool fromMemory,
+    int64_t resizeWidth,
+    int64_t resizeHeight,
+    const std::string& okey) const {
+  return transform_(std::make_shared<op::LoadImageRandomAreaCrop>(
+      ikey,
+      area_range,
+      aspect_ratio_range,
+      num_trial,
+      prefix,
+      fromMemory,
+      resizeWidth,
+      resizeHeight,
+      okey));
+}
+
+template <class T, class B>
+T Dataset<T, B>::load_image_random_area_crop_if(
+    bool cond,
+    const std::string& ikey,
+    std::pair<float, float> area_range,
+    std::pair<float, float> aspect_ratio_range,
+    int num_trial,
+    const std::string& prefix,
+    bool fromMemory,
+    int64_t resizeWidth,
+    int64_t resizeHeight,
+    const std::string& okey) const {
+  if (cond) {
+    return transform_(std::make_shared<op::LoadImageRandomAreaCrop>(
+        ikey,
+        area_range,
+        aspect_ratio_range,
+        num_trial,
+        prefix,
+        fromMemory,
+        resizeWidth,
+        resizeHeight,
+        okey));
   } else {
     return T(self_);
   }
@@ -469,9 +839,25 @@ T Dataset<T, B>::load_video(
     const std::string& prefix,
     bool info,
     bool fromMemory,
+    int64_t numFrames,
+    int64_t stride,
+    double clipDuration,
+    bool randomOffset,
+    int64_t resizeSmallestSide,
+    int numThreads,
     const std::string& okey) const {
-  return transform_(
-      std::make_shared<op::LoadVideo>(ikey, prefix, info, fromMemory, okey));
+  return transform_(std::make_shared<op::LoadVideo>(
+      ikey,
+      prefix,
+      info,
+      fromMemory,
+      numFrames,
+      stride,
+      clipDuration,
+      randomOffset,
+      resizeSmallestSide,
+      numThreads,
+      okey));
 }
 
 template <class T, class B>
@@ -481,10 +867,26 @@ T Dataset<T, B>::load_video_if(
     const std::string& prefix,
     bool info,
     bool fromMemory,
+    int64_t numFrames,
+    int64_t stride,
+    double clipDuration,
+    bool randomOffset,
+    int64_t resizeSmallestSide,
+    int numThreads,
     const std::string& okey) const {
   if (cond) {
-    return transform_(
-        std::make_shared<op::LoadVideo>(ikey, prefix, info, fromMemory, okey));
+    return transform_(std::make_shared<op::LoadVideo>(
+        ikey,
+        prefix,
+        info,
+        fromMemory,
+        numFrames,
+        stride,
+        clipDuration,
+        randomOffset,
+        resizeSmallestSide,
+        numThreads,
+        okey));
   } else {
     return T(self_);
   }
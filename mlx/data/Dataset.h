@@ -8,6 +8,7 @@
 #include "mlx/data/Array.h"
 #include "mlx/data/core/FileFetcher.h"
 #include "mlx/data/core/Trie.h"
+#include "mlx/data/core/image/ImageCache.h"
 #include "mlx/data/op/LoadAudio.h"
 #include "mlx/data/op/Op.h"
 #include "mlx/data/op/Tokenize.h"
@@ -61,6 +62,20 @@ class Dataset {
       std::string preset = "default",
       const std::string& okey = "") const;
 
+  T image_normalize(
+      const std::string& ikey,
+      const std::vector<float>& mean,
+      const std::vector<float>& stddev,
+      bool channels_first = false,
+      const std::string& okey = "") const;
+  T image_normalize_if(
+      bool cond,
+      const std::string& ikey,
+      const std::vector<float>& mean,
+      const std::vector<float>& stddev,
+      bool channels_first = false,
+      const std::string& okey = "") const;
+
   T image_random_area_crop(
       const std::string& ikey,
       std::pair<float, float> area_range,
@@ -123,12 +138,86 @@ class Dataset {
       const std::string& ikey,
       double angle,
       bool crop = false,
+      const std::string& interpolation = "nearest",
       const std::string& okey = "") const;
   T image_rotate_if(
       bool cond,
       const std::string& ikey,
       double angle,
       bool crop = false,
+      const std::string& interpolation = "nearest",
+      const std::string& okey = "") const;
+
+  T image_affine(
+      const std::string& ikey,
+      const std::vector<float>& matrix,
+      bool crop = false,
+      const std::string& interpolation = "nearest",
+      const std::string& okey = "") const;
+  T image_affine_if(
+      bool cond,
+      const std::string& ikey,
+      const std::vector<float>& matrix,
+      bool crop = false,
+      const std::string& interpolation = "nearest",
+      const std::string& okey = "") const;
+
+  T image_random_affine(
+      const std::string& ikey,
+      std::pair<float, float> rotation_range,
+      std::pair<float, float> scale_range = {1, 1},
+      std::pair<float, float> shear_range = {0, 0},
+      std::pair<float, float> translate_range = {0, 0},
+      bool crop = true,
+      const std::string& interpolation = "bilinear",
+      const std::string& okey = "") const;
+  T image_random_affine_if(
+      bool cond,
+      const std::string& ikey,
+      std::pair<float, float> rotation_range,
+      std::pair<float, float> scale_range = {1, 1},
+      std::pair<float, float> shear_range = {0, 0},
+      std::pair<float, float> translate_range = {0, 0},
+      bool crop = true,
+      const std::string& interpolation = "bilinear",
+      const std::string& okey = "") const;
+
+  T image_random_color_jitter(
+      const std::string& ikey,
+      float brightness,
+      float contrast = 0,
+      float saturation = 0,
+      float hue = 0,
+      const std::string& okey = "") const;
+  T image_random_color_jitter_if(
+      bool cond,
+      const std::string& ikey,
+      float brightness,
+      float contrast = 0,
+      float saturation = 0,
+      float hue = 0,
+      const std::string& okey = "") const;
+
+  T image_random_grayscale(
+      const std::string& ikey,
+      float prob,
+      const std::string& okey = "") const;
+  T image_random_grayscale_if(
+      bool cond,
+      const std::string& ikey,
+      float prob,
+      const std::string& okey = "") const;
+
+  T image_gaussian_blur(
+      const std::string& ikey,
+      std::pair<float, float> sigma_range,
+      int kernel_size = 0,
+      const std::string& okey = "") const;
+  T image_gaussian_blur_if(
+      bool cond,
+      const std::string& ikey,
+      std::pair<float, float> sigma_range,
+      int kernel_size = 0,
       const std::string& okey = "") const;
 
   T key_transform(
@@ -157,6 +246,9 @@ class Dataset {
       LoadAudioResamplingQuality resampling_quality =
           LoadAudioResamplingQuality::SincFastest,
       const std::string& info_key = "",
+      double offset_seconds = 0,
+      double duration_seconds = 0,
+      bool random_crop = false,
       const std::string& okey = "") const;
   T load_audio_if(
       bool cond,
@@ -169,6 +261,9 @@ class Dataset {
       LoadAudioResamplingQuality resampling_quality =
           LoadAudioResamplingQuality::SincFastest,
       const std::string& info_key = "",
+      double offset_seconds = 0,
+      double duration_seconds = 0,
+      bool random_crop = false,
       const std::string& okey = "") const;
 
   T resample_audio(
@@ -189,6 +284,58 @@ class Dataset {
           LoadAudioResamplingQuality::SincFastest,
       const std::string& okey = "") const;
 
+  T audio_mel_filterbank(
+      const std::string& ikey,
+      int sample_rate,
+      int num_filters = 80,
+      float low_freq = 0,
+      float high_freq = 0,
+      const std::string& scale = "mel",
+      float floor = 0,
+      bool log = true,
+      const std::string& okey = "") const;
+  T audio_mel_filterbank_if(
+      bool cond,
+      const std::string& ikey,
+      int sample_rate,
+      int num_filters = 80,
+      float low_freq = 0,
+      float high_freq = 0,
+      const std::string& scale = "mel",
+      float floor = 0,
+      bool log = true,
+      const std::string& okey = "") const;
+
+  T audio_mfcc(
+      const std::string& ikey,
+      int num_coefficients = 13,
+      const std::string& okey = "") const;
+  T audio_mfcc_if(
+      bool cond,
+      const std::string& ikey,
+      int num_coefficients = 13,
+      const std::string& okey = "") const;
+
+  T audio_stft(
+      const std::string& ikey,
+      int64_t n_fft = 512,
+      int64_t frame_length = 0,
+      int64_t hop_length = 0,
+      const std::string& window = "hann",
+      float pre_emphasis = 0,
+      float power = 1,
+      const std::string& okey = "") const;
+  T audio_stft_if(
+      bool cond,
+      const std::string& ikey,
+      int64_t n_fft = 512,
+      int64_t frame_length = 0,
+      int64_t hop_length = 0,
+      const std::string& window = "hann",
+      float pre_emphasis = 0,
+      float power = 1,
+      const std::string& okey = "") const;
+
   T load_file(
       const std::string& ikey,
       const std::filesystem::path& prefix = "",
@@ -205,6 +352,8 @@ class Dataset {
       bool info = false,
       const std::string& format = "RGB",
       bool from_memory = false,
+      int64_t resize_smallest_side = 0,
+      std::shared_ptr<core::image::ImageCache> cache = nullptr,
       const std::string& okey = "") const;
   T load_image_if(
       bool cond,
@@ -213,6 +362,30 @@ class Dataset {
       bool info = false,
       const std::string& format = "RGB",
       bool from_memory = false,
+      int64_t resize_smallest_side = 0,
+      std::shared_ptr<core::image::ImageCache> cache = nullptr,
+      const std::string& okey = "") const;
+
+  T load_image_random_area_crop(
+      const std::string& ikey,
+      std::pair<float, float> area_range,
+      std::pair<float, float> aspect_ratio_range,
+      int num_trial = 10,
+      const std::string& prefix = "",
+      bool from_memory = false,
+      int64_t resize_width = 0,
+      int64_t resize_height = 0,
+      const std::string& okey = "") const;
+  T load_image_random_area_crop_if(
+      bool cond,
+      const std::string& ikey,
+      std::pair<float, float> area_range,
+      std::pair<float, float> aspect_ratio_range,
+      int num_trial = 10,
+      const std::string& prefix = "",
+      bool from_memory = false,
+      int64_t resize_width = 0,
+      int64_t resize_height = 0,
       const std::string& okey = "") const;
 
   T load_numpy(
@@ -232,6 +405,12 @@ class Dataset {
       const std::string& prefix = "",
       bool info = false,
       bool from_memory = false,
+      int64_t num_frames = 0,
+      int64_t stride = 0,
+      double clip_duration = 0,
+      bool random_offset = false,
+      int64_t resize_smallest_side = 0,
+      int num_threads = 1,
       const std::string& okey = "") const;
   T load_video_if(
       bool cond,
@@ -239,6 +418,12 @@ class Dataset {
       const std::string& prefix = "",
       bool info = false,
       bool from_memory = false,
+      int64_t num_frames = 0,
+      int64_t stride = 0,
+      double clip_duration = 0,
+      bool random_offset = false,
+      int64_t resize_smallest_side = 0,
+      int num_threads = 1,
       const std::string& okey = "") const;
 
   T pad(
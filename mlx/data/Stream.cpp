@@ -9,12 +9,15 @@
 #include "mlx/data/stream/Buffered.h"
 #include "mlx/data/stream/CSVReader.h"
 #include "mlx/data/stream/DynamicBatch.h"
+#include "mlx/data/stream/ImageResizeBatch.h"
 #include "mlx/data/stream/LineReader.h"
 #include "mlx/data/stream/Partition.h"
 #include "mlx/data/stream/Prefetch.h"
 #include "mlx/data/stream/Repeat.h"
 #include "mlx/data/stream/Shuffle.h"
 #include "mlx/data/stream/SlidingWindow.h"
+#include "mlx/data/stream/TARReader.h"
+#include "mlx/data/stream/VideoClipReader.h"
 
 namespace mlx {
 namespace data {
@@ -38,6 +41,27 @@ Stream Stream::batch(
       self_, batch_size, pad_values, batch_dims));
 }
 
+Stream Stream::image_resize_batch(
+    int64_t batch_size,
+    const std::string& key,
+    int64_t w,
+    int64_t h,
+    const std::string& filter,
+    int num_threads,
+    const std::unordered_map<std::string, double>& pad_values,
+    const std::unordered_map<std::string, int>& batch_dims) const {
+  return Stream(std::make_shared<stream::ImageResizeBatch>(
+      self_,
+      batch_size,
+      key,
+      w,
+      h,
+      filter,
+      num_threads,
+      pad_values,
+      batch_dims));
+}
+
 Stream Stream::buffered(
     int64_t buffer_size,
     std::function<Buffer(const Buffer)> on_refill,
@@ -149,6 +173,42 @@ Stream Stream::sliding_window(
       self_, key, size, stride, dim, index_key));
 }
 
+Stream Stream::tar_reader_from_key(
+    const std::string& key,
+    bool from_memory,
+    const std::filesystem::path& local_prefix,
+    std::shared_ptr<core::FileFetcher> fetcher) const {
+  return Stream(std::make_shared<stream::TARReaderFromKey>(
+      self_, key, from_memory, local_prefix, fetcher));
+}
+
+Stream Stream::video_clips_from_key(
+    const std::string& key,
+    const std::string& dst_key,
+    int64_t clip_length,
+    int64_t stride,
+    bool from_memory,
+    const std::string& index_key,
+    int64_t resize_smallest_side,
+    int num_threads,
+    const std::filesystem::path& local_prefix,
+    std::shared_ptr<core::FileFetcher> fetcher) const {
+  core::video::VideoDecodeOptions options;
+  options.num_threads = num_threads;
+  options.resize_smallest_side = resize_smallest_side;
+  return Stream(std::make_shared<stream::VideoClipReaderFromKey>(
+      self_,
+      key,
+      dst_key,
+      clip_length,
+      stride,
+      from_memory,
+      index_key,
+      options,
+      local_prefix,
+      fetcher));
+}
+
 Buffer Stream::to_buffer() {
   return Buffer(std::make_shared<buffer::FromStream>(self_));
 }
@@ -199,5 +259,19 @@ Stream stream_line_reader(
       std::make_shared<stream::LineReader>(f, key, unzip, file_handle));
 }
 
+Stream stream_tar_reader(
+    const std::string& filename,
+    const std::filesystem::path& local_prefix,
+    std::shared_ptr<core::FileFetcher> fetcher) {
+  return Stream(
+      std::make_shared<stream::TARReader>(filename, local_prefix, fetcher));
+}
+
+Stream stream_tar_reader(
+    const std::shared_ptr<std::istream>& f,
+    std::shared_ptr<core::FileFetcherHandle> file_handle) {
+  return Stream(std::make_shared<stream::TARReader>(f, file_handle));
+}
+
 } // namespace data
 } // namespace mlx
@@ -23,6 +23,17 @@ class Stream : public Dataset<Stream, stream::Stream> {
       const std::unordered_map<std::string, double>& pad_values = {},
       const std::unordered_map<std::string, int>& batch_dims = {}) const;
 
+  /// See Buffer::image_resize_batch().
+  Stream image_resize_batch(
+      int64_t batch_size,
+      const std::string& key,
+      int64_t w,
+      int64_t h,
+      const std::string& filter = "bilinear",
+      int num_threads = 0,
+      const std::unordered_map<std::string, double>& pad_values = {},
+      const std::unordered_map<std::string, int>& batch_dims = {}) const;
+
   Stream buffered(
       int64_t buffer_size,
       std::function<Buffer(const Buffer)> on_refill,
@@ -75,6 +86,24 @@ class Stream : public Dataset<Stream, stream::Stream> {
       int dim = -1,
       const std::string& index_key = "") const;
 
+  Stream tar_reader_from_key(
+      const std::string& key,
+      bool from_memory = false,
+      const std::filesystem::path& local_prefix = "",
+      std::shared_ptr<core::FileFetcher> fetcher = nullptr) const;
+
+  Stream video_clips_from_key(
+      const std::string& key,
+      const std::string& dst_key,
+      int64_t clip_length,
+      int64_t stride = 0,
+      bool from_memory = false,
+      const std::string& index_key = "",
+      int64_t resize_smallest_side = 0,
+      int num_threads = 1,
+      const std::filesystem::path& local_prefix = "",
+      std::shared_ptr<core::FileFetcher> fetcher = nullptr) const;
+
   Buffer to_buffer();
 };
 
@@ -109,5 +138,14 @@ Stream stream_line_reader(
     bool unzip = false,
     std::shared_ptr<core::FileFetcherHandle> file_handle = nullptr);
 
+Stream stream_tar_reader(
+    const std::string& filename,
+    const std::filesystem::path& local_prefix = "",
+    std::shared_ptr<core::FileFetcher> fetcher = nullptr);
+
+Stream stream_tar_reader(
+    const std::shared_ptr<std::istream>& f,
+    std::shared_ptr<core::FileFetcherHandle> file_handle = nullptr);
+
 } // namespace data
 } // namespace mlx
@@ -18,6 +18,7 @@ Batch::Batch(
   if (batch_size <= 0) {
     throw std::runtime_error("Batch: batch size must be positive");
   }
+  init_transform_();
   size_ = op->size() / batch_size;
   if (op->size() % batch_size) {
     size_++;
@@ -47,6 +48,14 @@ Batch::Batch(
     throw std::runtime_error("Batch: sum of batch sizes exceeds buffer size");
   }
   size_ = batch_sizes.size();
+  init_transform_();
+}
+
+void Batch::init_transform_() {
+  transform_ = std::dynamic_pointer_cast<Transform>(op_);
+  if (transform_) {
+    keyTransform_ = transform_->last_key_transform();
+  }
 }
 
 Sample Batch::get(int64_t idx) const {
@@ -57,6 +66,14 @@ Sample Batch::get(int64_t idx) const {
       (batchSize_ ? std::min(batchSize_, op_->size() - idx * batchSize_)
                   : batchSizes_[idx]);
   auto batch_offset = (batchSize_ ? idx * batchSize_ : batchOffsets_[idx]);
+  if (keyTransform_) {
+    int64_t i = 0;
+    return keyTransform_->apply_batch(
+        [&]() { return transform_->get_partial(batch_offset + i++); },
+        batch_size,
+        padValues_,
+        batchDims_);
+  }
   std::vector<Sample> samples(batch_size);
   for (int64_t i = 0; i < batch_size; i++) {
     samples[i] = op_->get(batch_offset + i);
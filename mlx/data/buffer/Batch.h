@@ -3,6 +3,7 @@
 #pragma once
 
 #include "mlx/data/buffer/Buffer.h"
+#include "mlx/data/buffer/Transform.h"
 
 namespace mlx {
 namespace data {
@@ -25,6 +26,8 @@ class Batch : public Buffer {
   virtual int64_t size() const override;
 
  private:
+  void init_transform_();
+
   std::shared_ptr<Buffer> op_;
   int64_t batchSize_;
   std::vector<int64_t> batchOffsets_;
@@ -32,6 +35,11 @@ class Batch : public Buffer {
   std::unordered_map<std::string, double> padValues_;
   std::unordered_map<std::string, int> batchDims_;
   int64_t size_;
+
+  // Set when the upstream is a Transform ending with a KeyTransformOp, which
+  // is then applied directly into the batch.
+  std::shared_ptr<Transform> transform_;
+  std::shared_ptr<op::KeyTransformOp> keyTransform_;
 };
 
 } // namespace buffer
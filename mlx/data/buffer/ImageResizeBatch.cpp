@@ -0,0 +1,84 @@
+// Copyright © 2023 Apple Inc.
+
+#include "mlx/data/buffer/ImageResizeBatch.h"
+#include "mlx/data/core/Utils.h"
+
+namespace mlx {
+namespace data {
+namespace buffer {
+
+ImageResizeBatch::ImageResizeBatch(
+    const std::shared_ptr<Buffer>& op,
+    int64_t batch_size,
+    const std::string& key,
+    int64_t w,
+    int64_t h,
+    const std::string& filter,
+    int num_threads,
+    const std::unordered_map<std::string, double>& pad_values,
+    const std::unordered_map<std::string, int>& batch_dims)
+    : op_(op),
+      batchSize_(batch_size),
+      key_(key),
+      w_(w),
+      h_(h),
+      filter_(core::image::resize_filter(filter)),
+      numThreads_(num_threads),
+      padValues_(pad_values),
+      batchDims_(batch_dims) {
+  if (batch_size <= 0) {
+    throw std::runtime_error("ImageResizeBatch: batch size must be positive");
+  }
+  if (w <= 0 || h <= 0) {
+    throw std::runtime_error("ImageResizeBatch: target size must be positive");
+  }
+  size_ = (op->size() + batch_size - 1) / batch_size;
+}
+
+Sample ImageResizeBatch::get(int64_t idx) const {
+  if (idx < 0 || idx >= size_) {
+    throw std::runtime_error("ImageResizeBatch: index out of range");
+  }
+  auto batch_size = std::min(batchSize_, op_->size() - idx * batchSize_);
+  std::vector<Sample> samples(batch_size);
+  for (int64_t i = 0; i < batch_size; i++) {
+    samples[i] = op_->get(idx * batchSize_ + i);
+  }
+  return merge_batch(
+      samples,
+      key_,
+      w_,
+      h_,
+      filter_,
+      numThreads_,
+      padValues_,
+      batchDims_);
+}
+
+int64_t ImageResizeBatch::size() const {
+  return size_;
+}
+
+Sample ImageResizeBatch::merge_batch(
+    const std::vector<Sample>& samples,
+    const std::string& key,
+    int64_t w,
+    int64_t h,
+    core::image::ResizeFilter filter,
+    int num_threads,
+    const std::unordered_map<std::string, double>& pad_values,
+    const std::unordered_map<std::string, int>& batch_dims) {
+  std::vector<std::shared_ptr<const Array>> images(samples.size());
+  std::vector<Sample> others(samples);
+  for (int64_t i = 0; i < samples.size(); i++) {
+    images[i] = sample::check_key(samples[i], key, ArrayType::UInt8);
+    others[i].erase(key);
+  }
+  auto res = core::merge_batch(others, pad_values, batch_dims);
+  res[key] = core::image::resize_batch(images, w, h, filter, num_threads);
+  return res;
+}
+
+} // namespace buffer
+} // namespace data
+} // namespace mlx
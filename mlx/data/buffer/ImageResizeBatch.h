@@ -0,0 +1,57 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include "mlx/data/buffer/Buffer.h"
+#include "mlx/data/core/image/Image.h"
+
+namespace mlx {
+namespace data {
+namespace buffer {
+
+/// Batches like Batch, except that the images at key (of any size) are
+/// resized to (w, h) straight into a [B, h, w, C] array, the rows of the
+/// whole batch being spread across the thread pool.
+class ImageResizeBatch : public Buffer {
+ public:
+  ImageResizeBatch(
+      const std::shared_ptr<Buffer>& op,
+      int64_t batch_size,
+      const std::string& key,
+      int64_t w,
+      int64_t h,
+      const std::string& filter = "bilinear",
+      int num_threads = 0,
+      const std::unordered_map<std::string, double>& pad_values = {},
+      const std::unordered_map<std::string, int>& batch_dims = {});
+
+  virtual Sample get(int64_t idx) const override;
+  virtual int64_t size() const override;
+
+  /// Merges the samples into a batch, the images at key being resized.
+  static Sample merge_batch(
+      const std::vector<Sample>& samples,
+      const std::string& key,
+      int64_t w,
+      int64_t h,
+      core::image::ResizeFilter filter,
+      int num_threads,
+      const std::unordered_map<std::string, double>& pad_values,
+      const std::unordered_map<std::string, int>& batch_dims);
+
+ private:
+  std::shared_ptr<Buffer> op_;
+  int64_t batchSize_;
+  std::string key_;
+  int64_t w_;
+  int64_t h_;
+  core::image::ResizeFilter filter_;
+  int numThreads_;
+  std::unordered_map<std::string, double> padValues_;
+  std::unordered_map<std::string, int> batchDims_;
+  int64_t size_;
+};
+
+} // namespace buffer
+} // namespace data
+} // namespace mlx
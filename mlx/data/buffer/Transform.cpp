@@ -19,12 +19,27 @@ Transform::Transform(
     : od_(od), ops_(ops) {};
 
 Sample Transform::get(const int64_t idx) const {
+  return get_(idx, ops_.size());
+}
+
+std::shared_ptr<op::KeyTransformOp> Transform::last_key_transform() const {
+  if (ops_.empty()) {
+    return nullptr;
+  }
+  return std::dynamic_pointer_cast<op::KeyTransformOp>(ops_.back());
+}
+
+Sample Transform::get_partial(int64_t idx) const {
+  return get_(idx, ops_.size() - 1);
+}
+
+Sample Transform::get_(int64_t idx, int64_t num_ops) const {
   auto t_sample = od_->get(idx);
   if (t_sample.empty()) {
     throw std::runtime_error("Transform: cannot return empty sample");
   }
-  for (auto& op : ops_) {
-    t_sample = op->apply(t_sample);
+  for (int64_t i = 0; i < num_ops; i++) {
+    t_sample = ops_[i]->apply(t_sample);
     if (t_sample.empty()) {
       throw std::runtime_error("Transform: cannot return empty sample");
     }
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "mlx/data/buffer/Buffer.h"
+#include "mlx/data/op/KeyTransform.h"
 #include "mlx/data/op/Op.h"
 
 namespace mlx {
@@ -26,9 +27,20 @@ class Transform : public Buffer {
 
   virtual int64_t size() const override;
 
+  /// The last op if it is a KeyTransformOp, nullptr otherwise. Batch then
+  /// applies it itself with get_partial(), such that it can write its output
+  /// in place into the batch (see op::KeyTransformOp::apply_batch()).
+  std::shared_ptr<op::KeyTransformOp> last_key_transform() const;
+
+  /// Returns the sample idx transformed by all the ops but the last one.
+  Sample get_partial(int64_t idx) const;
+
  protected:
   std::shared_ptr<Buffer> od_;
   std::vector<std::shared_ptr<op::Op>> ops_;
+
+ private:
+  Sample get_(int64_t idx, int64_t num_ops) const;
 };
 
 } // namespace buffer
@@ -4,12 +4,11 @@
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
 
+#include <algorithm>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
 
 #include "mlx/data/core/AWSFileFetcher.h"
-#include "mlx/data/core/ThreadPool.h"
 
 namespace mlx {
 namespace data {
@@ -48,12 +47,15 @@ AWSFileFetcher::AWSFileFetcher(
           opt.num_prefetch_max,
           opt.num_prefetch_threads,
           opt.num_kept_files,
-          opt.verbose),
+          opt.verbose,
+          opt.max_cached_bytes,
+          opt.in_memory),
       bucket_(bucket),
       prefix_(opt.prefix),
       local_prefix_(opt.local_prefix),
       buffer_size_(opt.buffer_size),
       num_threads_(opt.num_threads),
+      preallocate_(opt.preallocate),
       dtor_called_(false) {
   config_ = std::make_unique<Aws::Client::ClientConfiguration>();
   config_->endpointOverride = opt.endpoint;
@@ -204,6 +206,44 @@ int64_t AWSFileFetcher::get_size(const std::string& filename) const {
   }
 }
 
+void AWSFileFetcher::read_part_(
+    const std::string& remote_file_path,
+    int64_t begin,
+    int64_t end,
+    const PartWriter& write) const {
+  check_credentials();
+  Aws::S3::Model::GetObjectOutcome outcome;
+  {
+    std::shared_lock slock(client_mutex_);
+    std::stringstream range;
+    range << "bytes=" << begin << '-' << (end - 1); // inclusive
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(remote_file_path);
+    request.SetRange(range.str());
+    outcome = client_->GetObject(request);
+  }
+  if (!outcome.IsSuccess()) {
+    const Aws::S3::S3Error& err = outcome.GetError();
+    throw std::runtime_error(
+        "AWSFileFetcher: unable to fetch <s3://" + bucket_ + "/" +
+        remote_file_path + "> : " + err.GetExceptionName() + " : " +
+        err.GetMessage());
+  }
+
+  auto& body = outcome.GetResult().GetBody();
+  std::vector<char> chunk(std::min<int64_t>(end - begin, 1 << 20));
+  for (int64_t offset = begin; offset < end;) {
+    body.read(chunk.data(), std::min<int64_t>(chunk.size(), end - offset));
+    int64_t chunkSize = body.gcount();
+    if (chunkSize <= 0) {
+      break;
+    }
+    write(chunk.data(), chunkSize);
+    offset += chunkSize;
+  }
+}
+
 void AWSFileFetcher::backend_fetch(const std::string& filename) const {
   // Do not fetch a file already present on disk
   auto remoteFilePath = (prefix_ / filename);
@@ -218,123 +258,50 @@ void AWSFileFetcher::backend_fetch(const std::string& filename) const {
   }
 
   auto size = get_size(filename);
-  auto numPart = size / buffer_size_;
-  if (size % buffer_size_) {
-    numPart++;
-  }
   if (verbose_) {
     std::cout << "AWSFileFetcher (" << std::hex << this << std::dec
               << ") : fetching s3://" << bucket_ << "/" << remoteFilePath
               << " (" << size << " bytes) into " << localFilePath << std::endl;
   }
 
-  // Note: the threads might fetch data faster than what
-  // the disk can write, in which case memory might blow up
-  // for large files. Could have gone with another approach,
-  // but here one can control number of threads.
-  std::deque<std::future<Aws::S3::Model::GetObjectOutcome>> parts;
-  ThreadPool threadPool(num_threads_);
-  {
-    for (int64_t part = 0; part < numPart; part++) {
-      parts.emplace_back(
-          threadPool.enqueue([part, size, this, remoteFilePath]() {
-            if (dtor_called_.load()) {
-              return Aws::S3::Model::GetObjectOutcome();
-            }
-            check_credentials();
-            {
-              std::shared_lock slock(client_mutex_);
-              auto beg = part * buffer_size_;
-              auto end = (part + 1) * buffer_size_;
-              if (end > size) {
-                end = size;
-              }
-              end--; // inclusive;
-              std::stringstream range;
-              range << "bytes=" << beg << '-' << end;
-              Aws::S3::Model::GetObjectRequest request;
-              request.SetBucket(bucket_);
-              request.SetKey(remoteFilePath.string());
-              request.SetRange(range.str());
-              return client_->GetObject(request);
-            }
-          }));
-    }
-  }
+  bool done = download_to_file_(
+      localFilePath,
+      size,
+      buffer_size_,
+      num_threads_,
+      preallocate_,
+      [&](int64_t begin, int64_t end, const PartWriter& write) {
+        read_part_(remoteFilePath.string(), begin, end, write);
+      },
+      dtor_called_);
 
-  auto localDir = localFilePath.parent_path();
-  if (!localDir.empty() && !std::filesystem::exists(localDir)) {
-    if (verbose_) {
-      std::cout << "AWSFileFetcher (" << std::hex << this << std::dec
-                << ") : creating directory " << localDir << std::endl;
-    }
-    std::filesystem::create_directories(localDir);
-  }
-  auto localFilePathTmp = localFilePath;
-  localFilePathTmp += ".download";
-  std::ofstream f(
-      localFilePathTmp,
-      std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
-  if (!f.good()) {
-    throw std::runtime_error(
-        "AWSFileFetcher: could not open <" + localFilePathTmp.string() +
-        "> for writing");
-  }
-  int64_t part = 0;
-  int64_t totalWrittenSize = 0;
-  while (!parts.empty() && !dtor_called_) {
-    auto beg = part * buffer_size_;
-    auto end = (part + 1) * buffer_size_;
-    if (end > size) {
-      end = size;
-    }
-    auto partSize = end - beg;
-
-    if (dtor_called_) {
-      return; // empty result, we are ending anyways
-    }
-
-    if (!parts.front().valid()) {
-      throw std::runtime_error(
-          "AWSFileFetcher: invalid future (internal error, please report)");
-    }
-    auto outcome = parts.front().get();
-    parts.pop_front();
-    if (!outcome.IsSuccess()) {
-      const Aws::S3::S3Error& err = outcome.GetError();
-      throw std::runtime_error(
-          "AWSFileFetcher: unable to fetch <s3://" + bucket_ + "/" +
-          remoteFilePath.string() + "> : " + err.GetExceptionName() + " : " +
-          err.GetMessage());
-    } else {
-      auto& buf = outcome.GetResult().GetBody();
-      f << buf.rdbuf();
-      totalWrittenSize += partSize;
-      if (!f.good()) {
-        throw std::runtime_error(
-            "AWSFileFetcher: could not write in <" + localFilePathTmp.string() +
-            ">");
-      }
-      if (f.tellp() != totalWrittenSize) {
-        throw std::runtime_error(
-            "AWSFileFetcher: unexpected write size in <" +
-            localFilePathTmp.string() + ">");
-      }
-    }
-    part++;
+  if (verbose_) {
+    std::cout << "AWSFileFetcher (" << std::hex << this << std::dec
+              << ") : " << (done ? "done" : "aborted") << " fetching s3://"
+              << bucket_ << "/" << remoteFilePath << " into "
+              << localFilePath << std::endl;
   }
+}
 
-  // rename file when done
-  f.close();
-  std::filesystem::rename(localFilePathTmp, localFilePath);
-
+std::shared_ptr<Array> AWSFileFetcher::backend_fetch_memory(
+    const std::string& filename) const {
+  auto remoteFilePath = (prefix_ / filename);
+  auto size = get_size(filename);
   if (verbose_) {
     std::cout << "AWSFileFetcher (" << std::hex << this << std::dec
-              << ") : " << (dtor_called_.load() ? "aborted" : "done")
-              << " fetching s3://" << bucket_ << "/" << remoteFilePath << " ("
-              << totalWrittenSize << "/" << size << " bytes) into "
-              << localFilePath << std::endl;
+              << ") : fetching s3://" << bucket_ << "/" << remoteFilePath
+              << " (" << size << " bytes) in memory" << std::endl;
   }
+
+  // nullptr if aborted, we are ending anyways
+  return download_to_memory_(
+      size,
+      buffer_size_,
+      num_threads_,
+      [&](int64_t begin, int64_t end, const PartWriter& write) {
+        read_part_(remoteFilePath.string(), begin, end, write);
+      },
+      dtor_called_);
 }
 
 void AWSFileFetcher::backend_erase(const std::string& filename) const {
@@ -347,6 +314,12 @@ void AWSFileFetcher::backend_erase(const std::string& filename) const {
   }
 }
 
+int64_t AWSFileFetcher::backend_size(const std::string& filename) const {
+  std::error_code ec;
+  auto size = std::filesystem::file_size(local_prefix_ / filename, ec);
+  return ec ? 0 : size;
+}
+
 AWSFileFetcher::~AWSFileFetcher() {
   dtor_called_ = true;
   cancel_prefetch();
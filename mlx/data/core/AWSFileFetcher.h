@@ -46,6 +46,9 @@ struct AWSFileFetcherOptions {
   std::string session_token = "";
   std::string expiration = "";
   bool verbose = false;
+  int64_t max_cached_bytes = 0;
+  bool preallocate = false;
+  bool in_memory = false;
 };
 
 class AWSFileFetcher : public FileFetcher {
@@ -57,7 +60,10 @@ class AWSFileFetcher : public FileFetcher {
   int64_t get_size(const std::string& filename) const;
 
   virtual void backend_fetch(const std::string& filename) const override;
+  virtual std::shared_ptr<Array> backend_fetch_memory(
+      const std::string& filename) const override;
   virtual void backend_erase(const std::string& filename) const override;
+  virtual int64_t backend_size(const std::string& filename) const override;
 
   void update_credentials(
       const std::string& access_key_id = "",
@@ -78,6 +84,14 @@ class AWSFileFetcher : public FileFetcher {
  protected:
   void check_credentials() const;
 
+  // Fetch the bytes [begin, end) of the object, passed to write() by chunks
+  // as they are received.
+  void read_part_(
+      const std::string& remote_file_path,
+      int64_t begin,
+      int64_t end,
+      const PartWriter& write) const;
+
   std::string bucket_;
   std::filesystem::path prefix_;
   std::filesystem::path local_prefix_;
@@ -85,6 +99,7 @@ class AWSFileFetcher : public FileFetcher {
   bool config_virtual_host_;
   int64_t buffer_size_;
   int num_threads_;
+  bool preallocate_;
   mutable std::unique_ptr<Aws::Auth::AWSCredentials> credentials_;
   mutable std::unique_ptr<Aws::S3::S3Client> client_;
   mutable std::atomic<bool> dtor_called_;
@@ -179,6 +179,33 @@ std::vector<std::string> CSVReader::next() {
   return fields;
 }
 
+bool CSVReader::skip() {
+  // A record ends at the first line feed outside of a quoted field. Doubled
+  // quotes toggle the state twice, so counting quotes is enough.
+  std::string line;
+  bool quoted = false;
+  int numRead = 0;
+  do {
+    if (!std::getline(*f_, line)) {
+      if (numRead == 0) {
+        return false;
+      }
+      throw std::runtime_error(
+          "CSVReader: unexpected end of stream at line " +
+          std::to_string(numLine_) + " in file <" + filename_ + ">");
+    }
+    numLine_++;
+    numRead++;
+    for (auto c : line) {
+      if (c == quote_) {
+        quoted = !quoted;
+      }
+    }
+  } while (quoted);
+
+  return true;
+}
+
 void CSVReader::reset() {
   f_->clear();
   f_->seekg(0);
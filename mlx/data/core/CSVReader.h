@@ -24,6 +24,10 @@ class CSVReader {
       const char sep = ',',
       const char quote = '"');
   std::vector<std::string> next();
+
+  // skip the next record without parsing its fields, returns false at the
+  // end of the stream
+  bool skip();
   void reset();
 
  private:
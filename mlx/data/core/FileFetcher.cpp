@@ -2,9 +2,74 @@
 
 #include "mlx/data/core/FileFetcher.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 
+namespace {
+
+// Runs fetch_part(begin, end) on all the parts of [0, size) with at most
+// num_threads parts in flight: each task fetches one part after the other
+// until there is none left, such that memory is bounded by the number of
+// tasks, whatever the speed of the network and of the writes.
+void download_parts(
+    int64_t size,
+    int64_t part_size,
+    int num_threads,
+    const std::function<void(int64_t, int64_t)>& fetch_part,
+    const std::atomic<bool>& abort) {
+  part_size = std::max<int64_t>(part_size, 1);
+  auto num_parts = size / part_size;
+  if (size % part_size) {
+    num_parts++;
+  }
+
+  std::atomic<int64_t> next_part = 0;
+  std::atomic<bool> failed = false;
+  auto worker = [&]() {
+    try {
+      while (!failed && !abort) {
+        int64_t part = next_part++;
+        if (part >= num_parts) {
+          return;
+        }
+        fetch_part(part * part_size, std::min((part + 1) * part_size, size));
+      }
+    } catch (...) {
+      failed = true;
+      throw;
+    }
+  };
+
+  auto num_tasks = std::min<int64_t>(std::max(num_threads, 1), num_parts);
+  mlx::data::core::TaskGroup threadPool(num_tasks);
+  std::vector<std::future<void>> tasks;
+  for (int64_t i = 0; i < num_tasks; i++) {
+    tasks.push_back(threadPool.enqueue(worker));
+  }
+
+  // all the tasks must be done before returning, as they refer to this frame
+  std::exception_ptr error;
+  for (auto& task : tasks) {
+    try {
+      mlx::data::core::ThreadPool::get(task);
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace
+
 namespace mlx {
 namespace data {
 namespace core {
@@ -13,13 +78,24 @@ FileFetcher::FileFetcher(
     int num_prefetch_max,
     int num_prefetch_threads,
     int num_kept_files,
-    bool verbose)
-    : threadPool_(std::make_unique<ThreadPool>(num_prefetch_threads)),
+    bool verbose,
+    int64_t max_cached_bytes,
+    bool in_memory)
+    : threadPool_(std::make_unique<TaskGroup>(num_prefetch_threads)),
       numPrefetchMax_(num_prefetch_max),
       numKeptFiles_(num_kept_files),
-      fileRank_(0),
+      maxCachedBytes_(max_cached_bytes),
+      inMemory_(in_memory),
       verbose_(verbose) {}
 
+std::shared_ptr<Array> FileFetcher::fetch_(const std::string& filename) const {
+  if (inMemory_) {
+    return backend_fetch_memory(filename);
+  }
+  backend_fetch(filename);
+  return nullptr;
+}
+
 void FileFetcher::fill_queue_() const {
   while ((prefetchFilenames_.size()) > 0 &&
          ((numPrefetchMax_ < 0) || (queuedFiles_.size() < numPrefetchMax_))) {
@@ -35,7 +111,7 @@ void FileFetcher::fill_queue_() const {
       }
       queuedFiles_.emplace(
           std::make_pair(filename, threadPool_->enqueue([this, filename]() {
-            this->backend_fetch(filename);
+            return this->fetch_(filename);
           })));
     } else {
       if (verbose_) {
@@ -57,16 +133,15 @@ void FileFetcher::prefetch(const std::vector<std::string>& filenames) {
 
 std::shared_ptr<FileFetcherHandle> FileFetcher::fetch(
     const std::string& filename) const {
-  // cached?
+  // cached and most recent (or nothing is ever evicted)?
   {
     std::shared_lock slock(mutex_);
     auto it = cachedFiles_.find(filename);
-    if (it != cachedFiles_.end()) {
-      auto handle = it->second;
-      // Note: if numKeptFiles == 0, fileRank_ stays at 0
-      if (handle->rank_ == fileRank_) {
-        return handle;
-      }
+    if (it != cachedFiles_.end() &&
+        ((it->second.lru == lru_.begin()) ||
+         (numKeptFiles_ <= 0 && maxCachedBytes_ <= 0))) {
+      numHits_++;
+      return it->second.handle;
     }
   }
   {
@@ -74,18 +149,16 @@ std::shared_ptr<FileFetcherHandle> FileFetcher::fetch(
     // cached?
     auto it = cachedFiles_.find(filename);
     if (it != cachedFiles_.end()) {
-      auto handle = it->second;
-      if (handle->rank_ == fileRank_) {
-        return handle;
-      } else {
-        handle->rank_ = ++fileRank_;
-        return handle;
-      }
+      numHits_++;
+      lru_.splice(lru_.begin(), lru_, it->second.lru);
+      return it->second.handle;
     }
+    numMisses_++;
     // queued?
+    std::shared_ptr<Array> data;
     auto qit = queuedFiles_.find(filename);
     if (qit == queuedFiles_.end()) {
-      backend_fetch(filename);
+      data = fetch_(filename);
       if (verbose_) {
         std::cout << "FileFetcher (" << std::hex << this << std::dec
                   << ") : fetching \"" << filename
@@ -101,44 +174,185 @@ std::shared_ptr<FileFetcherHandle> FileFetcher::fetch(
         throw std::runtime_error(
             "FileFetcher: invalid future (internal error, please report)");
       }
-      qit->second.get();
+      data = ThreadPool::get(qit->second);
       queuedFiles_.erase(qit);
       fill_queue_();
     }
-    auto handle = std::make_shared<FileFetcherHandle>(
-        ((numKeptFiles_ <= 0) ? 0 : ++fileRank_));
-    cachedFiles_[filename] = handle;
-    if (numKeptFiles_ > 0) {
-      while (cachedFiles_.size() > numKeptFiles_) {
-        std::string min_key;
-        int64_t min_rank = fileRank_;
-        for (auto& e : cachedFiles_) {
-          // Note: use_count cannot go lower than 1
-          if ((e.second.use_count() == 1) && (e.second->rank_ < min_rank)) {
-            min_key = e.first;
-            min_rank = e.second->rank_;
-          }
+    auto handle = std::make_shared<FileFetcherHandle>(data);
+    auto size = data ? data->size() : backend_size(filename);
+    lru_.push_front(filename);
+    cachedFiles_[filename] = {handle, size, lru_.begin()};
+    cachedBytes_ += size;
+    evict_();
+    return handle;
+  }
+}
+
+// Must be called with mutex_ held
+void FileFetcher::evict_() const {
+  auto over_budget = [this]() {
+    return ((numKeptFiles_ > 0) && (cachedFiles_.size() > numKeptFiles_)) ||
+        ((maxCachedBytes_ > 0) && (cachedBytes_ > maxCachedBytes_));
+  };
+  auto lit = lru_.end();
+  while (over_budget() && lit != lru_.begin()) {
+    --lit;
+    auto it = cachedFiles_.find(*lit);
+    // Note: use_count cannot go lower than 1, files in use are skipped
+    if (it->second.handle.use_count() > 1) {
+      continue;
+    }
+    if (verbose_) {
+      std::cout << "FileFetcher (" << std::hex << this << std::dec
+                << ") : evicting \"" << *lit << "\"" << std::endl;
+    }
+    auto filename = *lit;
+    cachedBytes_ -= it->second.size;
+    cachedFiles_.erase(it);
+    lit = lru_.erase(lit);
+    numEvictions_++;
+    if (!inMemory_) {
+      backend_erase(filename);
+    }
+  }
+}
+
+void FileFetcher::erase(const std::string& filename) const {
+  std::unique_lock ulock(mutex_);
+  auto it = cachedFiles_.find(filename);
+  if (it != cachedFiles_.end()) {
+    cachedBytes_ -= it->second.size;
+    lru_.erase(it->second.lru);
+    cachedFiles_.erase(it);
+  }
+  if (!inMemory_) {
+    backend_erase(filename);
+  }
+}
+
+FileFetcherStats FileFetcher::stats() const {
+  std::shared_lock slock(mutex_);
+  FileFetcherStats stats;
+  stats.num_hits = numHits_;
+  stats.num_misses = numMisses_;
+  stats.num_evictions = numEvictions_;
+  stats.num_cached_files = cachedFiles_.size();
+  stats.num_cached_bytes = cachedBytes_;
+  return stats;
+}
+
+bool FileFetcher::download_to_file_(
+    const std::filesystem::path& path,
+    int64_t size,
+    int64_t part_size,
+    int num_threads,
+    bool preallocate,
+    const PartReader& read_part,
+    const std::atomic<bool>& abort) const {
+  auto dir = path.parent_path();
+  if (!dir.empty() && !std::filesystem::exists(dir)) {
+    if (verbose_) {
+      std::cout << "FileFetcher (" << std::hex << this << std::dec
+                << ") : creating directory " << dir << std::endl;
+    }
+    std::filesystem::create_directories(dir);
+  }
+  auto tmp_path = path;
+  tmp_path += ".download";
+  int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error(
+        "FileFetcher: could not open <" + tmp_path.string() + "> for writing");
+  }
+  if (preallocate && size > 0) {
+    // reserve the space upfront to limit fragmentation, best effort
+#ifdef __linux__
+    fallocate(fd, 0, 0, size);
+#else
+    ftruncate(fd, size);
+#endif
+  }
+
+  // parts are written at their offset as they arrive
+  auto fetch_part = [&](int64_t begin, int64_t end) {
+    int64_t offset = begin;
+    read_part(begin, end, [&](const char* data, int64_t data_size) {
+      if (offset + data_size > end) {
+        throw std::runtime_error(
+            "FileFetcher: unexpected write size in <" + tmp_path.string() +
+            ">");
+      }
+      for (int64_t n = 0; n < data_size;) {
+        auto res = pwrite(fd, data + n, data_size - n, offset + n);
+        if (res < 0 && errno == EINTR) {
+          continue;
         }
-        if (min_key.empty()) {
-          break;
-        } else {
-          cachedFiles_.erase(min_key);
-          backend_erase(min_key);
+        if (res <= 0) {
+          throw std::runtime_error(
+              "FileFetcher: could not write in <" + tmp_path.string() + ">");
         }
+        n += res;
       }
+      offset += data_size;
+    });
+    if (offset != end) {
+      throw std::runtime_error(
+          "FileFetcher: unexpected write size in <" + tmp_path.string() + ">");
     }
-    return handle;
+  };
+
+  try {
+    download_parts(size, part_size, num_threads, fetch_part, abort);
+  } catch (...) {
+    close(fd);
+    std::filesystem::remove(tmp_path);
+    throw;
+  }
+
+  // rename file when done, unless we were interrupted
+  if (close(fd) != 0 || abort) {
+    std::filesystem::remove(tmp_path);
+    return false;
   }
+  std::filesystem::rename(tmp_path, path);
+  return true;
 }
 
-void FileFetcher::erase(const std::string& filename) const {
-  std::unique_lock ulock(mutex_);
-  cachedFiles_.erase(filename);
-  backend_erase(filename);
+std::shared_ptr<Array> FileFetcher::download_to_memory_(
+    int64_t size,
+    int64_t part_size,
+    int num_threads,
+    const PartReader& read_part,
+    const std::atomic<bool>& abort) const {
+  auto array = std::make_shared<Array>(ArrayType::UInt8, size);
+  auto dst = static_cast<char*>(array->data());
+  auto fetch_part = [&](int64_t begin, int64_t end) {
+    int64_t offset = begin;
+    read_part(begin, end, [&](const char* data, int64_t data_size) {
+      if (offset + data_size > end) {
+        throw std::runtime_error("FileFetcher: unexpected part size");
+      }
+      std::memcpy(dst + offset, data, data_size);
+      offset += data_size;
+    });
+    if (offset != end) {
+      throw std::runtime_error("FileFetcher: unexpected part size");
+    }
+  };
+  download_parts(size, part_size, num_threads, fetch_part, abort);
+  return abort ? nullptr : array;
 }
 
 void FileFetcher::backend_fetch(const std::string& filename) const {}
+std::shared_ptr<Array> FileFetcher::backend_fetch_memory(
+    const std::string& filename) const {
+  throw std::runtime_error(
+      "FileFetcher: fetching in memory is not supported by this fetcher");
+}
 void FileFetcher::backend_erase(const std::string& filename) const {}
+int64_t FileFetcher::backend_size(const std::string& filename) const {
+  return 0;
+}
 
 void FileFetcher::cancel_prefetch() {
   prefetchFilenames_.clear();
@@ -146,7 +360,7 @@ void FileFetcher::cancel_prefetch() {
     if (!future.second.valid()) {
       std::cout << "FileFetcher: invalid future (cancelPrefetch)" << std::endl;
     }
-    future.second.get();
+    ThreadPool::get(future.second);
   }
   queuedFiles_.clear();
 }
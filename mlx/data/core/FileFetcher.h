@@ -3,9 +3,13 @@
 #pragma once
 
 #include "mlx/data/Array.h"
-#include "mlx/data/core/ThreadPool.h"
+#include "mlx/data/core/TaskGroup.h"
 
+#include <atomic>
 #include <deque>
+#include <filesystem>
+#include <functional>
+#include <list>
 #include <memory>
 #include <shared_mutex>
 #include <string>
@@ -17,13 +21,26 @@ namespace mlx {
 namespace data {
 namespace core {
 
+// A file is not evicted from the local cache while a handle on it is alive.
 class FileFetcherHandle {
  public:
-  FileFetcherHandle(int64_t rank) : rank_(rank) {};
+  FileFetcherHandle(std::shared_ptr<Array> data = nullptr) : data_(data) {};
+
+  // The contents of the file if it was fetched in memory, nullptr otherwise.
+  const std::shared_ptr<Array>& data() const {
+    return data_;
+  }
 
  private:
-  int64_t rank_;
-  friend class FileFetcher;
+  std::shared_ptr<Array> data_;
+};
+
+struct FileFetcherStats {
+  int64_t num_hits = 0;
+  int64_t num_misses = 0;
+  int64_t num_evictions = 0;
+  int64_t num_cached_files = 0;
+  int64_t num_cached_bytes = 0;
 };
 
 // Note that FileFetcher holds a weak reference on a given filename
@@ -33,11 +50,21 @@ class FileFetcher {
   // In a multi-threaded environment, use numKeptFiles with caution: Make
   // sure it is large enough, to ensure threads won't compete on the files
   // to keep locally.
+  //
+  // The least recently fetched files (and not in use) are evicted when there
+  // are more than num_kept_files or they take more than max_cached_bytes on
+  // disk (as reported by backend_size()). 0 means no limit.
+  //
+  // If in_memory is true, files are fetched in memory (see
+  // backend_fetch_memory()) instead of being written to disk, and their
+  // contents are available from the handles.
   FileFetcher(
       int num_prefetch_max = 1,
       int num_prefetch_threads = 1,
       int num_kept_files = 0,
-      bool verbose = false);
+      bool verbose = false,
+      int64_t max_cached_bytes = 0,
+      bool in_memory = false);
 
   void prefetch(const std::vector<std::string>& filenames);
 
@@ -51,26 +78,73 @@ class FileFetcher {
   // Erase a file from cache, and call backend erase
   void erase(const std::string& filename) const;
 
+  FileFetcherStats stats() const;
+
   virtual void backend_fetch(const std::string& filename) const;
 
+  virtual std::shared_ptr<Array> backend_fetch_memory(
+      const std::string& filename) const;
+
   virtual void backend_erase(const std::string& filename) const;
 
+  // Size of a fetched file in the local cache (0 if unknown)
+  virtual int64_t backend_size(const std::string& filename) const;
+
   virtual ~FileFetcher();
 
  protected:
+  // Receives the consecutive bytes of a part of a file.
+  typedef std::function<void(const char* data, int64_t size)> PartWriter;
+  // Fetches the bytes [begin, end) of a file and passes them to write().
+  typedef std::function<void(int64_t begin, int64_t end, const PartWriter&)>
+      PartReader;
+
+  // Download a file of the given size in parts of part_size bytes, with at
+  // most num_threads parts in flight, each part being written as soon as it
+  // is received. The file is written in a temporary file renamed to path once
+  // complete. Both return false/nullptr if aborted by setting abort.
+  bool download_to_file_(
+      const std::filesystem::path& path,
+      int64_t size,
+      int64_t part_size,
+      int num_threads,
+      bool preallocate,
+      const PartReader& read_part,
+      const std::atomic<bool>& abort) const;
+  std::shared_ptr<Array> download_to_memory_(
+      int64_t size,
+      int64_t part_size,
+      int num_threads,
+      const PartReader& read_part,
+      const std::atomic<bool>& abort) const;
+
   void fill_queue_() const;
-  std::unique_ptr<ThreadPool> threadPool_;
+  std::shared_ptr<Array> fetch_(const std::string& filename) const;
+  std::unique_ptr<TaskGroup> threadPool_;
   mutable std::deque<std::string> prefetchFilenames_;
   mutable std::shared_mutex mutex_;
   int numPrefetchMax_;
   int numKeptFiles_;
-  mutable int64_t fileRank_;
+  int64_t maxCachedBytes_;
+  bool inMemory_;
   bool verbose_;
 
-  mutable std::unordered_map<std::string, std::future<void>> queuedFiles_;
-
-  mutable std::unordered_map<std::string, std::shared_ptr<FileFetcherHandle>>
-      cachedFiles_;
+  mutable std::unordered_map<std::string, std::future<std::shared_ptr<Array>>>
+      queuedFiles_;
+
+  // Cached files, from the most to the least recently fetched one.
+  struct CachedFile {
+    std::shared_ptr<FileFetcherHandle> handle;
+    int64_t size;
+    std::list<std::string>::iterator lru;
+  };
+  void evict_() const;
+  mutable std::list<std::string> lru_;
+  mutable std::unordered_map<std::string, CachedFile> cachedFiles_;
+  mutable int64_t cachedBytes_ = 0;
+  mutable std::atomic<int64_t> numHits_ = 0;
+  mutable std::atomic<int64_t> numMisses_ = 0;
+  mutable std::atomic<int64_t> numEvictions_ = 0;
 };
 
 } // namespace core
@@ -0,0 +1,254 @@
+// Copyright © 2023 Apple Inc.
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+#include "mlx/data/core/HTTPFileFetcher.h"
+
+namespace {
+
+// One handle per thread, such that connections are reused across the
+// requests of a thread.
+struct CURLHandle {
+  CURLHandle() : curl(curl_easy_init()) {}
+  ~CURLHandle() {
+    if (curl) {
+      curl_easy_cleanup(curl);
+    }
+  }
+  CURL* curl;
+};
+
+struct Transfer {
+  CURL* curl;
+  std::function<void(const char*, int64_t)> write;
+  int64_t begin;
+  int64_t end;
+  // offset in the file of the next received byte, -1 before the first one
+  int64_t pos = -1;
+  std::exception_ptr error;
+};
+
+size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
+  auto t = static_cast<Transfer*>(userdata);
+  int64_t n = size * nmemb;
+  try {
+    if (t->pos < 0) {
+      long code = 0;
+      curl_easy_getinfo(t->curl, CURLINFO_RESPONSE_CODE, &code);
+      if (code == 206) {
+        t->pos = t->begin;
+      } else if (code == 200) {
+        // the server ignored the range and sends the whole file
+        t->pos = 0;
+      } else {
+        throw std::runtime_error(
+            "HTTPFileFetcher: unexpected HTTP response code " +
+            std::to_string(code));
+      }
+    }
+    auto data_begin = std::max(t->pos, t->begin);
+    auto data_end = std::min(t->pos + n, t->end);
+    if (data_end > data_begin) {
+      t->write(ptr + (data_begin - t->pos), data_end - data_begin);
+    }
+    t->pos += n;
+  } catch (...) {
+    t->error = std::current_exception();
+    return 0;
+  }
+  // stop the transfer once we got the part (when the range was ignored)
+  return (t->pos > t->end) ? 0 : n;
+}
+
+} // namespace
+
+namespace mlx {
+namespace data {
+namespace core {
+
+HTTPFileFetcher::HTTPFileFetcher(
+    const std::string& base_url,
+    const HTTPFileFetcherOptions& opt)
+    : FileFetcher(
+          opt.num_prefetch_max,
+          opt.num_prefetch_threads,
+          opt.num_kept_files,
+          opt.verbose,
+          opt.max_cached_bytes,
+          opt.in_memory),
+      base_url_(base_url),
+      prefix_(opt.prefix),
+      local_prefix_(opt.local_prefix),
+      ca_bundle_(opt.ca_bundle),
+      verify_ssl_(opt.verify_ssl),
+      connect_timeout_ms_(opt.connect_timeout_ms),
+      buffer_size_(opt.buffer_size),
+      num_threads_(opt.num_threads),
+      preallocate_(opt.preallocate),
+      dtor_called_(false) {
+  static std::once_flag init_flag;
+  std::call_once(init_flag, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+  while (!base_url_.empty() && base_url_.back() == '/') {
+    base_url_.pop_back();
+  }
+}
+
+std::string HTTPFileFetcher::url_(const std::string& filename) const {
+  auto path = (prefix_ / filename).string();
+  return base_url_ + ((path.empty() || path[0] != '/') ? "/" : "") + path;
+}
+
+void* HTTPFileFetcher::prepare_(const std::string& url, char* error) const {
+  static thread_local CURLHandle handle;
+  if (!handle.curl) {
+    throw std::runtime_error("HTTPFileFetcher: could not initialize curl");
+  }
+  auto curl = handle.curl;
+  curl_easy_reset(curl);
+  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+  curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, error);
+  curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, (long)connect_timeout_ms_);
+  curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, verify_ssl_ ? 1L : 0L);
+  curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, verify_ssl_ ? 2L : 0L);
+  if (!ca_bundle_.empty()) {
+    curl_easy_setopt(curl, CURLOPT_CAINFO, ca_bundle_.c_str());
+  }
+  error[0] = 0;
+  return curl;
+}
+
+int64_t HTTPFileFetcher::get_size(const std::string& filename) const {
+  auto url = url_(filename);
+  char error[CURL_ERROR_SIZE];
+  auto curl = static_cast<CURL*>(prepare_(url, error));
+  curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+  auto res = curl_easy_perform(curl);
+  curl_off_t size = -1;
+  if (res == CURLE_OK) {
+    curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &size);
+  }
+  if (size < 0) {
+    std::string msg = "unknown content length";
+    if (res != CURLE_OK) {
+      msg = error[0] ? error : curl_easy_strerror(res);
+    }
+    throw std::runtime_error(
+        "HTTPFileFetcher: unable to fetch <" + url + "> header: " + msg);
+  }
+  return size;
+}
+
+void HTTPFileFetcher::read_part_(
+    const std::string& url,
+    int64_t begin,
+    int64_t end,
+    const PartWriter& write) const {
+  char error[CURL_ERROR_SIZE];
+  auto curl = static_cast<CURL*>(prepare_(url, error));
+  Transfer t = {curl, write, begin, end, -1, nullptr};
+  auto range = std::to_string(begin) + "-" + std::to_string(end - 1);
+  curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &t);
+  auto res = curl_easy_perform(curl);
+  if (t.error) {
+    std::rethrow_exception(t.error);
+  }
+  // a write error is expected if we stopped the transfer ourselves
+  if (res != CURLE_OK && !(res == CURLE_WRITE_ERROR && t.pos >= end)) {
+    throw std::runtime_error(
+        "HTTPFileFetcher: unable to fetch <" + url + "> : " +
+        std::string(error[0] ? error : curl_easy_strerror(res)));
+  }
+}
+
+void HTTPFileFetcher::backend_fetch(const std::string& filename) const {
+  // Do not fetch a file already present on disk
+  auto url = url_(filename);
+  auto localFilePath = (local_prefix_ / filename);
+  if (std::filesystem::exists(localFilePath)) {
+    if (verbose_) {
+      std::cout << "HTTPFileFetcher (" << std::hex << this << std::dec
+                << ") : file " << url << " already exists in "
+                << localFilePath << std::endl;
+    }
+    return;
+  }
+
+  auto size = get_size(filename);
+  if (verbose_) {
+    std::cout << "HTTPFileFetcher (" << std::hex << this << std::dec
+              << ") : fetching " << url << " (" << size << " bytes) into "
+              << localFilePath << std::endl;
+  }
+
+  bool done = download_to_file_(
+      localFilePath,
+      size,
+      buffer_size_,
+      num_threads_,
+      preallocate_,
+      [&](int64_t begin, int64_t end, const PartWriter& write) {
+        read_part_(url, begin, end, write);
+      },
+      dtor_called_);
+
+  if (verbose_) {
+    std::cout << "HTTPFileFetcher (" << std::hex << this << std::dec
+              << ") : " << (done ? "done" : "aborted") << " fetching " << url
+              << " into " << localFilePath << std::endl;
+  }
+}
+
+std::shared_ptr<Array> HTTPFileFetcher::backend_fetch_memory(
+    const std::string& filename) const {
+  auto url = url_(filename);
+  auto size = get_size(filename);
+  if (verbose_) {
+    std::cout << "HTTPFileFetcher (" << std::hex << this << std::dec
+              << ") : fetching " << url << " (" << size << " bytes) in memory"
+              << std::endl;
+  }
+
+  // nullptr if aborted, we are ending anyways
+  return download_to_memory_(
+      size,
+      buffer_size_,
+      num_threads_,
+      [&](int64_t begin, int64_t end, const PartWriter& write) {
+        read_part_(url, begin, end, write);
+      },
+      dtor_called_);
+}
+
+void HTTPFileFetcher::backend_erase(const std::string& filename) const {
+  auto localFilePath = (local_prefix_ / filename);
+  auto status = std::filesystem::remove(localFilePath);
+  if (verbose_) {
+    std::cout << "HTTPFileFetcher (" << std::hex << this << std::dec
+              << ") : erasing " << localFilePath
+              << (status ? " (done)" : " (file does not exist)") << std::endl;
+  }
+}
+
+int64_t HTTPFileFetcher::backend_size(const std::string& filename) const {
+  std::error_code ec;
+  auto size = std::filesystem::file_size(local_prefix_ / filename, ec);
+  return ec ? 0 : size;
+}
+
+HTTPFileFetcher::~HTTPFileFetcher() {
+  dtor_called_ = true;
+  cancel_prefetch();
+}
+
+} // namespace core
+} // namespace data
+} // namespace mlx
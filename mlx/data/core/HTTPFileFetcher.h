@@ -0,0 +1,76 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+
+#include "mlx/data/core/FileFetcher.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+
+struct HTTPFileFetcherOptions {
+  std::filesystem::path prefix = "";
+  std::filesystem::path local_prefix = "";
+  std::string ca_bundle = "";
+  bool verify_ssl = true;
+  int64_t connect_timeout_ms = 1000;
+  int64_t buffer_size = 64 * 1024 * 1024; // 64MB
+  int num_threads = 4;
+  bool preallocate = false;
+  int num_prefetch_max = 1;
+  int num_prefetch_threads = 1;
+  int64_t num_kept_files = 0;
+  int64_t max_cached_bytes = 0;
+  bool in_memory = false;
+  bool verbose = false;
+};
+
+// Fetches files from an HTTP(S) server with parallel range requests. Servers
+// which do not support range requests are handled as well (each part then
+// transfers the beginning of the file), but are better used with a
+// buffer_size larger than the files.
+class HTTPFileFetcher : public FileFetcher {
+ public:
+  HTTPFileFetcher(
+      const std::string& base_url,
+      const HTTPFileFetcherOptions& opt = HTTPFileFetcherOptions());
+
+  int64_t get_size(const std::string& filename) const;
+
+  virtual void backend_fetch(const std::string& filename) const override;
+  virtual std::shared_ptr<Array> backend_fetch_memory(
+      const std::string& filename) const override;
+  virtual void backend_erase(const std::string& filename) const override;
+  virtual int64_t backend_size(const std::string& filename) const override;
+
+  virtual ~HTTPFileFetcher();
+
+ protected:
+  std::string url_(const std::string& filename) const;
+  // Sets the options shared by all the requests on the calling thread's
+  // handle (connections are kept alive across requests) and returns it.
+  void* prepare_(const std::string& url, char* error) const;
+  void read_part_(
+      const std::string& url,
+      int64_t begin,
+      int64_t end,
+      const PartWriter& write) const;
+
+  std::string base_url_;
+  std::filesystem::path prefix_;
+  std::filesystem::path local_prefix_;
+  std::string ca_bundle_;
+  bool verify_ssl_;
+  int64_t connect_timeout_ms_;
+  int64_t buffer_size_;
+  int num_threads_;
+  bool preallocate_;
+  mutable std::atomic<bool> dtor_called_;
+};
+
+} // namespace core
+} // namespace data
+} // namespace mlx
@@ -0,0 +1,173 @@
+// Copyright © 2023 Apple Inc.
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+
+#include "mlx/data/core/LocalFileFetcher.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+
+LocalFileFetcher::LocalFileFetcher(const LocalFileFetcherOptions& opt)
+    : FileFetcher(
+          opt.num_prefetch_max,
+          opt.num_prefetch_threads,
+          opt.num_kept_files,
+          opt.verbose,
+          opt.max_cached_bytes,
+          opt.in_memory),
+      prefix_(opt.prefix),
+      local_prefix_(opt.local_prefix),
+      buffer_size_(opt.buffer_size),
+      num_threads_(opt.num_threads),
+      preallocate_(opt.preallocate),
+      dtor_called_(false) {
+  // erasing a file from the cache would erase the original file
+  if (!inMemory_ &&
+      std::filesystem::absolute(prefix_).lexically_normal() ==
+          std::filesystem::absolute(local_prefix_).lexically_normal()) {
+    throw std::runtime_error(
+        "LocalFileFetcher: prefix and local_prefix must be different");
+  }
+}
+
+std::pair<int, int64_t> LocalFileFetcher::open_(
+    const std::filesystem::path& path) const {
+  int fd = open(path.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    throw std::runtime_error(
+        "LocalFileFetcher: could not open <" + path.string() + ">");
+  }
+  return {fd, st.st_size};
+}
+
+void LocalFileFetcher::read_part_(
+    int fd,
+    const std::filesystem::path& path,
+    int64_t begin,
+    int64_t end,
+    const PartWriter& write) const {
+  std::vector<char> chunk(std::min<int64_t>(end - begin, 1 << 20));
+  for (int64_t offset = begin; offset < end;) {
+    auto res = pread(
+        fd,
+        chunk.data(),
+        std::min<int64_t>(chunk.size(), end - offset),
+        offset);
+    if (res < 0 && errno == EINTR) {
+      continue;
+    }
+    if (res <= 0) {
+      throw std::runtime_error(
+          "LocalFileFetcher: could not read <" + path.string() + ">");
+    }
+    write(chunk.data(), res);
+    offset += res;
+  }
+}
+
+void LocalFileFetcher::backend_fetch(const std::string& filename) const {
+  // Do not fetch a file already present on disk
+  auto remoteFilePath = (prefix_ / filename);
+  auto localFilePath = (local_prefix_ / filename);
+  if (std::filesystem::exists(localFilePath)) {
+    if (verbose_) {
+      std::cout << "LocalFileFetcher (" << std::hex << this << std::dec
+                << ") : file " << remoteFilePath << " already exists in "
+                << localFilePath << std::endl;
+    }
+    return;
+  }
+
+  auto [fd, size] = open_(remoteFilePath);
+  if (verbose_) {
+    std::cout << "LocalFileFetcher (" << std::hex << this << std::dec
+              << ") : copying " << remoteFilePath << " (" << size
+              << " bytes) into " << localFilePath << std::endl;
+  }
+  bool done;
+  try {
+    done = download_to_file_(
+        localFilePath,
+        size,
+        buffer_size_,
+        num_threads_,
+        preallocate_,
+        [&, fd = fd](int64_t begin, int64_t end, const PartWriter& write) {
+          read_part_(fd, remoteFilePath, begin, end, write);
+        },
+        dtor_called_);
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+
+  if (verbose_) {
+    std::cout << "LocalFileFetcher (" << std::hex << this << std::dec
+              << ") : " << (done ? "done" : "aborted") << " copying "
+              << remoteFilePath << " into " << localFilePath << std::endl;
+  }
+}
+
+std::shared_ptr<Array> LocalFileFetcher::backend_fetch_memory(
+    const std::string& filename) const {
+  auto remoteFilePath = (prefix_ / filename);
+  auto [fd, size] = open_(remoteFilePath);
+  if (verbose_) {
+    std::cout << "LocalFileFetcher (" << std::hex << this << std::dec
+              << ") : reading " << remoteFilePath << " (" << size
+              << " bytes) in memory" << std::endl;
+  }
+  std::shared_ptr<Array> array;
+  try {
+    array = download_to_memory_(
+        size,
+        buffer_size_,
+        num_threads_,
+        [&, fd = fd](int64_t begin, int64_t end, const PartWriter& write) {
+          read_part_(fd, remoteFilePath, begin, end, write);
+        },
+        dtor_called_);
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+  return array;
+}
+
+void LocalFileFetcher::backend_erase(const std::string& filename) const {
+  auto localFilePath = (local_prefix_ / filename);
+  auto status = std::filesystem::remove(localFilePath);
+  if (verbose_) {
+    std::cout << "LocalFileFetcher (" << std::hex << this << std::dec
+              << ") : erasing " << localFilePath
+              << (status ? " (done)" : " (file does not exist)") << std::endl;
+  }
+}
+
+int64_t LocalFileFetcher::backend_size(const std::string& filename) const {
+  std::error_code ec;
+  auto size = std::filesystem::file_size(local_prefix_ / filename, ec);
+  return ec ? 0 : size;
+}
+
+LocalFileFetcher::~LocalFileFetcher() {
+  dtor_called_ = true;
+  cancel_prefetch();
+}
+
+} // namespace core
+} // namespace data
+} // namespace mlx
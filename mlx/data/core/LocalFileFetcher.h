@@ -0,0 +1,63 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+
+#include "mlx/data/core/FileFetcher.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+
+struct LocalFileFetcherOptions {
+  std::filesystem::path prefix = "";
+  std::filesystem::path local_prefix = "";
+  int64_t buffer_size = 64 * 1024 * 1024; // 64MB
+  int num_threads = 4;
+  bool preallocate = false;
+  int num_prefetch_max = 1;
+  int num_prefetch_threads = 1;
+  int64_t num_kept_files = 0;
+  int64_t max_cached_bytes = 0;
+  bool in_memory = false;
+  bool verbose = false;
+};
+
+// Copies files from a (typically slow, network mounted) directory prefix to a
+// local cache directory local_prefix, reading them in parallel parts.
+class LocalFileFetcher : public FileFetcher {
+ public:
+  LocalFileFetcher(
+      const LocalFileFetcherOptions& opt = LocalFileFetcherOptions());
+
+  virtual void backend_fetch(const std::string& filename) const override;
+  virtual std::shared_ptr<Array> backend_fetch_memory(
+      const std::string& filename) const override;
+  virtual void backend_erase(const std::string& filename) const override;
+  virtual int64_t backend_size(const std::string& filename) const override;
+
+  virtual ~LocalFileFetcher();
+
+ protected:
+  // Opens the remote file and returns its file descriptor and size.
+  std::pair<int, int64_t> open_(const std::filesystem::path& path) const;
+  void read_part_(
+      int fd,
+      const std::filesystem::path& path,
+      int64_t begin,
+      int64_t end,
+      const PartWriter& write) const;
+
+  std::filesystem::path prefix_;
+  std::filesystem::path local_prefix_;
+  int64_t buffer_size_;
+  int num_threads_;
+  bool preallocate_;
+  mutable std::atomic<bool> dtor_called_;
+};
+
+} // namespace core
+} // namespace data
+} // namespace mlx
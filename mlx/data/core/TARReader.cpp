@@ -1,12 +1,24 @@
 // Copyright © 2023 Apple Inc.
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cstring>
+#include <filesystem>
 #include <functional>
+#include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "mlx/data/core/TARReader.h"
-#include "mlx/data/core/ThreadPool.h"
+#include "mlx/data/core/TaskGroup.h"
+#include "mlx/data/core/imemstream.h"
 
 namespace {
 size_t strnlength(const char* s, size_t n) {
@@ -34,7 +46,7 @@ size_t parse_payload_size(unsigned char* str, int len) {
   }
 }
 void check_stream(
-    const std::ifstream& f,
+    const std::istream& f,
     const std::string filename,
     const std::string action) {
   if (!f.good()) {
@@ -65,8 +77,19 @@ struct TARHeader {
   char padding[12];
 };
 
+// Opens a new stream on the archive (file or memory) for each worker
+typedef std::function<std::shared_ptr<std::istream>()> ArchiveOpener;
+
+ArchiveOpener file_opener(const std::string& tarfilename) {
+  return [tarfilename]() {
+    return std::make_shared<std::ifstream>(
+        tarfilename, std::ios_base::in | std::ios_base::binary);
+  };
+}
+
 // Index a TAR file and return the index
 mlx::data::core::TARFileIndex index_worker(
+    const ArchiveOpener& open,
     const std::string& tarfilename,
     std::string prefix,
     int64_t start_offset) {
@@ -74,7 +97,8 @@ mlx::data::core::TARFileIndex index_worker(
   char zero_header[512];
   std::memset(zero_header, 0, 512);
 
-  std::ifstream f(tarfilename, std::ios_base::in | std::ios_base::binary);
+  auto fp = open();
+  auto& f = *fp;
   f.seekg(start_offset, std::ios_base::beg);
   check_stream(f, tarfilename, "opening");
 
@@ -131,56 +155,357 @@ mlx::data::core::TARFileIndex index_worker(
   return index;
 }
 
+mlx::data::core::TARFileIndex index_archive(
+    const ArchiveOpener& open,
+    const std::string& tarfilename,
+    bool nested,
+    int num_threads) {
+  using mlx::data::core::TARFileIndex;
+  using mlx::data::core::TaskGroup;
+  using mlx::data::core::ThreadPool;
+
+  // If nested TARs are not supported scan the tar in order
+  if (!nested) {
+    return index_worker(open, tarfilename, "", 0);
+  }
+
+  // Otherwise make a threadpool to scan each nested tar in parallel
+  TARFileIndex res;
+  TaskGroup pool(num_threads);
+  std::queue<std::future<TARFileIndex>> index_futures;
+
+  index_futures.push(
+      pool.enqueue(std::bind(index_worker, open, tarfilename, "", 0)));
+  while (!index_futures.empty()) {
+    auto index = ThreadPool::get(index_futures.front());
+    index_futures.pop();
+
+    for (auto& item : index) {
+      auto& path = item.first;
+      auto& offset = item.second.first;
+
+      // If it ends in .tar untar it inline
+      if (path.size() > 4 && path.substr(path.size() - 4) == ".tar") {
+        auto prefix = path.substr(0, path.size() - 4) + "/";
+        index_futures.push(pool.enqueue(
+            std::bind(index_worker, open, tarfilename, prefix, offset)));
+      }
+
+      // Otherwise just add it to the index
+      else {
+        res.insert(item);
+      }
+    }
+  }
+  return res;
+}
+
+// Index sidecar file layout (native endianness): an IndexHeader, followed by
+// num_entries IndexEntry and the concatenated file names.
+constexpr char index_magic[8] = {'M', 'L', 'X', 'T', 'A', 'R', 'I', 'X'};
+constexpr uint32_t index_version = 1;
+
+struct IndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t nested;
+  uint64_t archive_size;
+  int64_t archive_mtime;
+  uint64_t num_entries;
+  uint64_t names_size;
+};
+
+struct IndexEntry {
+  int64_t offset;
+  uint64_t size;
+  uint64_t name_offset;
+  uint64_t name_size;
+};
+
+// Size and modification time of the archive, which the sidecar must match.
+bool archive_stamp(
+    const std::string& tarfilename,
+    uint64_t& size,
+    int64_t& mtime) {
+  std::error_code ec;
+  size = std::filesystem::file_size(tarfilename, ec);
+  if (ec) {
+    return false;
+  }
+  auto time = std::filesystem::last_write_time(tarfilename, ec);
+  if (ec) {
+    return false;
+  }
+  mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+              time.time_since_epoch())
+              .count();
+  return true;
+}
+
+bool load_index(
+    const std::string& tarfilename,
+    const std::string& idxfilename,
+    bool nested,
+    mlx::data::core::TARFileIndex& index) {
+  uint64_t archive_size;
+  int64_t archive_mtime;
+  if (!archive_stamp(tarfilename, archive_size, archive_mtime)) {
+    return false;
+  }
+
+  int fd = open(idxfilename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  void* data = MAP_FAILED;
+  size_t size = 0;
+  if (fstat(fd, &st) == 0 &&
+      st.st_size >= static_cast<off_t>(sizeof(IndexHeader))) {
+    size = st.st_size;
+    data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  auto ptr = static_cast<const char*>(data);
+  IndexHeader header;
+  std::memcpy(&header, ptr, sizeof(IndexHeader));
+  bool valid =
+      (std::memcmp(header.magic, index_magic, sizeof(index_magic)) == 0) &&
+      (header.version == index_version) &&
+      (header.nested == static_cast<uint32_t>(nested)) &&
+      (header.archive_size == archive_size) &&
+      (header.archive_mtime == archive_mtime) &&
+      (header.num_entries <=
+       (size - sizeof(IndexHeader)) / sizeof(IndexEntry)) &&
+      (header.names_size ==
+       size - sizeof(IndexHeader) - header.num_entries * sizeof(IndexEntry));
+  if (valid) {
+    auto entries = ptr + sizeof(IndexHeader);
+    auto names = entries + header.num_entries * sizeof(IndexEntry);
+    index.clear();
+    index.reserve(header.num_entries);
+    for (uint64_t i = 0; i < header.num_entries && valid; i++) {
+      IndexEntry entry;
+      std::memcpy(
+          &entry, entries + i * sizeof(IndexEntry), sizeof(IndexEntry));
+      valid = (entry.name_offset <= header.names_size) &&
+          (entry.name_size <= header.names_size - entry.name_offset) &&
+          (entry.offset >= 0) &&
+          (static_cast<uint64_t>(entry.offset) <= archive_size) &&
+          (entry.size <= archive_size - entry.offset);
+      if (valid) {
+        index[std::string(names + entry.name_offset, entry.name_size)] =
+            std::make_pair(entry.offset, entry.size);
+      }
+    }
+  }
+  munmap(data, size);
+  if (!valid) {
+    index.clear();
+  }
+  return valid;
+}
+
+// Writes the index of the archive with the given stamp, returns false if it
+// could not be written.
+bool save_index(
+    const std::string& idxfilename,
+    bool nested,
+    uint64_t archive_size,
+    int64_t archive_mtime,
+    const mlx::data::core::TARFileIndex& index) {
+  IndexHeader header;
+  std::memcpy(header.magic, index_magic, sizeof(index_magic));
+  header.version = index_version;
+  header.nested = nested;
+  header.archive_size = archive_size;
+  header.archive_mtime = archive_mtime;
+
+  std::vector<IndexEntry> entries;
+  std::string names;
+  entries.reserve(index.size());
+  for (auto& item : index) {
+    entries.push_back(
+        {item.second.first,
+         item.second.second,
+         names.size(),
+         item.first.size()});
+    names += item.first;
+  }
+  header.num_entries = entries.size();
+  header.names_size = names.size();
+
+  // Write to a temporary file and rename it such that concurrent writers
+  // and readers never see a partial index.
+  auto tmpfilename = idxfilename + ".tmp" + std::to_string(getpid()) + "." +
+      std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  std::error_code ec;
+  {
+    std::ofstream f(tmpfilename, std::ios_base::out | std::ios_base::binary);
+    f.write(reinterpret_cast<const char*>(&header), sizeof(IndexHeader));
+    f.write(
+        reinterpret_cast<const char*>(entries.data()),
+        entries.size() * sizeof(IndexEntry));
+    f.write(names.data(), names.size());
+    f.close();
+    if (!f) {
+      std::filesystem::remove(tmpfilename, ec);
+      return false;
+    }
+  }
+  std::filesystem::rename(tmpfilename, idxfilename, ec);
+  if (ec) {
+    std::filesystem::remove(tmpfilename, ec);
+    return false;
+  }
+  return true;
+}
+
+void write_index(
+    const std::string& tarfilename,
+    const std::string& idxfilename,
+    bool nested,
+    int num_threads) {
+  uint64_t archive_size;
+  int64_t archive_mtime;
+  if (!archive_stamp(tarfilename, archive_size, archive_mtime)) {
+    throw std::runtime_error(
+        std::string("TARReader: could not stat archive <") + tarfilename +
+        ">");
+  }
+  auto index = index_archive(
+      file_opener(tarfilename), tarfilename, nested, num_threads);
+  if (!save_index(idxfilename, nested, archive_size, archive_mtime, index)) {
+    throw std::runtime_error(
+        std::string("TARReader: could not write index <") + idxfilename +
+        ">");
+  }
+}
+
 } // namespace
 
 namespace mlx {
 namespace data {
 namespace core {
 
+struct TARReader::Archive {
+  ~Archive() {
+    if (data && !array) {
+      munmap(data, size);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  int fd = -1;
+  char* data = nullptr;
+  size_t size = 0;
+  std::shared_ptr<Array> array; // in-memory archive, not mapped
+};
+
 TARReader::TARReader(
     const std::string& tarfilename,
     bool nested,
     int num_threads)
     : filename_(tarfilename) {
-  // If nested TARs are not supported scan the tar in order
-  if (!nested) {
-    index_ = index_worker(tarfilename, "", 0);
-  } else {
-    // Otherwise make a threadpool to scan each nested tar in parallel
-    ThreadPool pool(num_threads);
-    std::queue<std::future<TARFileIndex>> index_futures;
-
-    index_futures.push(
-        pool.enqueue(std::bind(index_worker, tarfilename, "", 0)));
-    while (!index_futures.empty()) {
-      auto index = index_futures.front().get();
-      index_futures.pop();
-
-      for (auto& item : index) {
-        auto& path = item.first;
-        auto& offset = item.second.first;
-
-        // If it ends in .tar untar it inline
-        if (path.size() > 4 && path.substr(path.size() - 4) == ".tar") {
-          auto prefix = path.substr(0, path.size() - 4) + "/";
-          index_futures.push(pool.enqueue(
-              std::bind(index_worker, tarfilename, prefix, offset)));
-        }
-
-        // Otherwise just add it to the index
-        else {
-          index_.insert(item);
-        }
-      }
-    }
+  auto idxfilename = index_filename(tarfilename);
+  if (load_index(tarfilename, idxfilename, nested, index_)) {
+    return;
+  }
+  // stamp the archive before scanning it, such that an archive modified in
+  // the meantime does not match the index
+  uint64_t archive_size;
+  int64_t archive_mtime;
+  bool stamped = archive_stamp(tarfilename, archive_size, archive_mtime);
+  index_ = index_archive(
+      file_opener(tarfilename), tarfilename, nested, num_threads);
+  // best effort, the next reader scans again if the index cannot be written
+  // (e.g. read-only file system)
+  if (stamped) {
+    save_index(idxfilename, nested, archive_size, archive_mtime, index_);
   }
 }
 
+TARReader::TARReader(
+    const std::shared_ptr<Array>& archive,
+    bool nested,
+    int num_threads)
+    : filename_("<memory>") {
+  index_ = index_archive(
+      [archive]() { return std::make_shared<imemstream>(archive); },
+      filename_,
+      nested,
+      num_threads);
+  std::call_once(archiveFlag_, [this, &archive]() {
+    archive_ = std::make_shared<Archive>();
+    archive_->array = archive;
+    archive_->data = static_cast<char*>(archive->data());
+    archive_->size = archive->size();
+  });
+}
+
+void TARReader::build_index(
+    const std::vector<std::string>& filenames,
+    bool nested,
+    int num_threads) {
+  TaskGroup pool(num_threads);
+  std::vector<std::future<void>> futures;
+  for (auto& filename : filenames) {
+    futures.push_back(pool.enqueue([filename, nested]() {
+      write_index(filename, index_filename(filename), nested, 1);
+    }));
+  }
+  for (auto& future : futures) {
+    ThreadPool::get(future);
+  }
+}
+
+std::string TARReader::index_filename(const std::string& filename) {
+  return filename + ".idx";
+}
+
 bool TARReader::contains(const std::string& filename) {
   auto it = index_.find(filename);
   return (it != index_.end());
 }
 
+void TARReader::open_archive_() {
+  auto archive = std::make_shared<Archive>();
+  archive->fd = open(filename_.c_str(), O_RDONLY);
+  struct stat st;
+  if (archive->fd < 0 || fstat(archive->fd, &st) != 0) {
+    throw std::runtime_error(
+        std::string("TARReader: could not open archive <") + filename_ +
+        ">: " + std::strerror(errno));
+  }
+  archive->size = st.st_size;
+
+  // Private writable mapping such that in-place transforms only touch their
+  // own copy of the pages. No swap is reserved for the copies, so archives
+  // larger than the memory can still be mapped. The descriptor is not needed
+  // afterwards.
+  if (archive->size > 0) {
+    void* data = mmap(
+        nullptr,
+        archive->size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_NORESERVE,
+        archive->fd,
+        0);
+    if (data != MAP_FAILED) {
+      archive->data = static_cast<char*>(data);
+      close(archive->fd);
+      archive->fd = -1;
+    }
+  }
+  archive_ = archive;
+}
+
 std::shared_ptr<Array> TARReader::get(const std::string& filename) {
   auto it = index_.find(filename);
   if (it == index_.end()) {
@@ -190,20 +515,40 @@ std::shared_ptr<Array> TARReader::get(const std::string& filename) {
   }
   auto file_offset = it->second.first;
   auto payload_size = it->second.second;
+  std::call_once(archiveFlag_, &TARReader::open_archive_, this);
+
+  if (archive_->data) {
+    if (file_offset + payload_size > archive_->size) {
+      throw std::runtime_error(
+          std::string("TARReader: archive <") + filename_ +
+          "> is truncated when fetching file <" + filename + ">");
+    }
+    // aliasing constructor: no copy, the array shares the archive ownership
+    return std::make_shared<Array>(
+        ArrayType::UInt8,
+        std::vector<int64_t>({static_cast<int64_t>(payload_size)}),
+        std::shared_ptr<void>(archive_, archive_->data + file_offset));
+  }
+
   auto array = std::make_shared<Array>(
       ArrayType::UInt8, static_cast<int64_t>(payload_size));
-  std::ifstream f(filename_, std::ios_base::in | std::ios_base::binary);
-  f.seekg(file_offset);
-  if (!f.good()) {
-    throw std::runtime_error(
-        std::string("TARReader: could not seek in archive <") + filename_ +
-        "> when fetching file <" + filename + ">");
-  }
-  f.read((char*)array->data(), payload_size);
-  if (!f.good()) {
-    throw std::runtime_error(
-        std::string("TARReader: could not read in archive <") + filename_ +
-        "> when fetching file <" + filename + ">");
+  auto data = static_cast<char*>(array->data());
+  size_t num_read = 0;
+  while (num_read < payload_size) {
+    auto n = pread(
+        archive_->fd,
+        data + num_read,
+        payload_size - num_read,
+        file_offset + num_read);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      throw std::runtime_error(
+          std::string("TARReader: could not read in archive <") + filename_ +
+          "> when fetching file <" + filename + ">");
+    }
+    num_read += n;
   }
   return array;
 }
@@ -216,6 +561,113 @@ std::vector<std::string> TARReader::get_file_list() {
   return files;
 }
 
+TARStreamReader::TARStreamReader(const std::string& filename)
+    : filename_(filename) {
+  uf_ = std::make_shared<std::ifstream>(filename_, std::ios_base::binary);
+  f_ = std::make_shared<bxz::istream>(*uf_);
+  if (!uf_->good() || !f_->good()) {
+    throw std::runtime_error(
+        "TARStreamReader: could not open file <" + filename_ + ">");
+  }
+}
+
+TARStreamReader::TARStreamReader(const std::shared_ptr<std::istream>& uf)
+    : filename_("<stream>"), uf_(uf) {
+  f_ = std::make_shared<bxz::istream>(*uf_);
+  if (!uf_->good() || !f_->good()) {
+    throw std::runtime_error("TARStreamReader: could not open memory file");
+  }
+}
+
+void TARStreamReader::check_(const std::string& action) const {
+  if (!f_->good()) {
+    throw std::runtime_error(
+        "TARStreamReader: error " + action + " archive <" + filename_ + ">");
+  }
+}
+
+bool TARStreamReader::next(std::string& filename) {
+  f_->ignore((payloadRead_ ? 0 : payloadSize_) + paddingSize_);
+  payloadSize_ = paddingSize_ = 0;
+  payloadRead_ = true;
+
+  std::string long_filename;
+  while (true) {
+    TARHeader header;
+    f_->read(reinterpret_cast<char*>(&header), 512);
+    if (f_->gcount() == 0 && f_->eof()) {
+      return false; // archive without end of archive marker
+    }
+    check_("reading");
+    if (std::all_of(
+            reinterpret_cast<char*>(&header),
+            reinterpret_cast<char*>(&header) + 512,
+            [](char c) { return c == 0; })) {
+      return false;
+    }
+
+    auto payload_size =
+        parse_payload_size(header.payloadSize, sizeof(header.payloadSize));
+    auto padding_size = (512 - (payload_size % 512)) % 512;
+
+    if (header.type == 'L') {
+      std::vector<char> data(payload_size);
+      f_->read(data.data(), payload_size);
+      f_->ignore(padding_size);
+      check_("reading");
+      long_filename =
+          std::string(data.data(), strnlength(data.data(), payload_size));
+      continue;
+    }
+
+    if ((header.type == '0') || (header.type == 0) ||
+        (long_filename.size() > 0)) { // file
+      auto prefix_length = strnlength(header.filenamePrefix, 155);
+      filename =
+          std::string(header.filename, strnlength(header.filename, 100));
+      if (long_filename.size() > 0) {
+        filename = long_filename;
+      } else if (prefix_length > 0) {
+        filename =
+            std::string(header.filenamePrefix, prefix_length) + "/" + filename;
+      }
+      payloadSize_ = payload_size;
+      paddingSize_ = padding_size;
+      payloadRead_ = false;
+      return true;
+    }
+
+    // unknown payload, skip it
+    f_->ignore(payload_size + padding_size);
+    check_("reading");
+  }
+}
+
+std::shared_ptr<Array> TARStreamReader::read() {
+  if (payloadRead_) {
+    throw std::runtime_error(
+        "TARStreamReader: no file to read in archive <" + filename_ + ">");
+  }
+  auto array = std::make_shared<Array>(
+      ArrayType::UInt8, static_cast<int64_t>(payloadSize_));
+  f_->read(reinterpret_cast<char*>(array->data()), payloadSize_);
+  check_("reading");
+  payloadRead_ = true;
+  return array;
+}
+
+void TARStreamReader::reset() {
+  f_->clear();
+  f_->seekg(0);
+  if (!uf_->good() || !f_->good()) {
+    throw std::runtime_error(
+        "TARStreamReader: could not seek to beginning of file <" + filename_ +
+        ">");
+  }
+  payloadSize_ = paddingSize_ = 0;
+  payloadRead_ = true;
+}
+
 } // namespace core
 } // namespace data
 } // namespace mlx
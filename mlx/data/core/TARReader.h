@@ -5,11 +5,16 @@
 #include "mlx/data/Array.h"
 
 #include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "bxzstr/bxzstr.hpp"
+
 namespace mlx {
 namespace data {
 namespace core {
@@ -17,20 +22,81 @@ namespace core {
 typedef std::unordered_map<std::string, std::pair<int64_t, size_t>>
     TARFileIndex;
 
+// The index of an archive is loaded from the sidecar file <filename>.idx
+// when there is one matching the archive (same size, modification time and
+// nested option), otherwise the archive headers are scanned. Sidecar files
+// are written by build_index().
 class TARReader {
  public:
+  // Uses the index sidecar file when it matches the archive, otherwise scans
+  // the archive and tries to write the sidecar for the next readers.
   TARReader(
       const std::string& filename,
       bool nested = false,
       int num_threads = 1);
 
+  // Index an archive held in memory, get() returns views into it.
+  TARReader(
+      const std::shared_ptr<Array>& archive,
+      bool nested = false,
+      int num_threads = 1);
+
+  // Scan the archives (up to num_threads in parallel) and write their index
+  // sidecar files.
+  static void build_index(
+      const std::vector<std::string>& filenames,
+      bool nested = false,
+      int num_threads = 1);
+  static std::string index_filename(const std::string& filename);
+
   bool contains(const std::string& filename);
+
+  // The archive is opened on the first call and memory mapped when possible,
+  // in which case the returned array points directly into the mapping (and
+  // keeps it alive). The mapping is private: modifying the contents in place
+  // does not change the archive but later calls for the same file see the
+  // change. Otherwise the file is read with pread() on a descriptor shared by
+  // all calls.
   std::shared_ptr<Array> get(const std::string& filename);
   std::vector<std::string> get_file_list();
 
  private:
+  struct Archive;
+
+  void open_archive_();
+
   std::string filename_;
   TARFileIndex index_;
+  std::shared_ptr<Archive> archive_;
+  std::once_flag archiveFlag_;
+};
+
+// Reads the files of a TAR archive in order, without seeking, such that the
+// archive can be compressed or come from any stream.
+class TARStreamReader {
+ public:
+  TARStreamReader(const std::string& filename);
+  TARStreamReader(const std::shared_ptr<std::istream>& uf);
+
+  // Move to the next file of the archive and return its name in filename,
+  // returns false at the end of the archive. The contents of the previous
+  // file are skipped if they were not read.
+  bool next(std::string& filename);
+
+  // Read the contents of the current file.
+  std::shared_ptr<Array> read();
+
+  void reset();
+
+ private:
+  void check_(const std::string& action) const;
+
+  std::string filename_;
+  std::shared_ptr<std::istream> uf_;
+  std::shared_ptr<bxz::istream> f_;
+  size_t payloadSize_ = 0;
+  size_t paddingSize_ = 0;
+  bool payloadRead_ = true;
 };
 
 } // namespace core
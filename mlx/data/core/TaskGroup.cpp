@@ -0,0 +1,68 @@
+// Copyright © 2023 Apple Inc.
+
+#include <algorithm>
+
+#include "mlx/data/core/TaskGroup.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+
+TaskGroup::TaskGroup(size_t max_concurrency, std::shared_ptr<ThreadPool> pool)
+    : pool_(pool),
+      maxConcurrency_(std::max(max_concurrency, static_cast<size_t>(1))),
+      running_(0) {}
+
+TaskGroup::~TaskGroup() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (running_ > 0) {
+    ThreadPool::Blocking blocking;
+    done_cv_.wait(lock, [this]() -> bool { return running_ == 0; });
+  }
+}
+
+void TaskGroup::push_(ThreadPool::Task&& task) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    if (running_ >= maxConcurrency_) {
+      // a running task will pick it up when done
+      return;
+    }
+    running_++;
+  }
+  pool_->push_(ThreadPool::Task([this]() { run_(); }));
+}
+
+void TaskGroup::run_() {
+  ThreadPool::Task task;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!tasks_.empty()) {
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+  }
+  if (task) {
+    task();
+    task = ThreadPool::Task();
+  }
+
+  // Keep our slot if there is more to do, but go through the pool again
+  //  instead of looping, so stages sharing the pool take turns.
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (tasks_.empty()) {
+      running_--;
+      if (running_ == 0) {
+        done_cv_.notify_all();
+      }
+      return;
+    }
+  }
+  pool_->push_(ThreadPool::Task([this]() { run_(); }));
+}
+
+} // namespace core
+} // namespace data
+} // namespace mlx
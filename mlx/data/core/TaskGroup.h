@@ -0,0 +1,62 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "mlx/data/core/ThreadPool.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+
+// TaskGroup runs tasks on a shared ThreadPool (the global one by default),
+//   with at most max_concurrency of them running at the same time. It lets
+//   every pipeline stage have its own concurrency budget without owning
+//   threads. Tasks start in submission order, and the destructor waits for
+//   all of them to complete.
+class TaskGroup {
+ public:
+  TaskGroup(
+      size_t max_concurrency,
+      std::shared_ptr<ThreadPool> pool = ThreadPool::global());
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  template <
+      typename F,
+      typename... Args,
+      std::enable_if_t<std::is_invocable_v<F&&, Args&&...>, int> = 0>
+  auto enqueue(F&&, Args&&...);
+
+ private:
+  void push_(ThreadPool::Task&& task);
+  void run_();
+
+  std::shared_ptr<ThreadPool> pool_;
+  size_t maxConcurrency_;
+  size_t running_;
+  std::deque<ThreadPool::Task> tasks_;
+  std::mutex mutex_;
+  std::condition_variable done_cv_;
+};
+
+template <
+    typename F,
+    typename... Args,
+    std::enable_if_t<std::is_invocable_v<F&&, Args&&...>, int>>
+auto TaskGroup::enqueue(F&& function, Args&&... args) {
+  auto [task, future] = ThreadPool::make_task_(
+      std::forward<F>(function), std::forward<Args>(args)...);
+  push_(std::move(task));
+  return std::move(future);
+}
+
+} // namespace core
+} // namespace data
+} // namespace mlx
@@ -1,5 +1,7 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+
 #include "mlx/data/core/ThreadPool.h"
 
 namespace mlx {
@@ -7,57 +9,293 @@ namespace data {
 namespace core {
 
 std::shared_ptr<ThreadController> ThreadPool::thread_controller = nullptr;
+thread_local ThreadPool* ThreadPool::current_pool_ = nullptr;
+thread_local size_t ThreadPool::current_index_ = 0;
+
+static std::mutex global_mutex;
+static std::shared_ptr<ThreadPool> global_pool;
+static size_t global_thread_count = 0;
+
+ThreadPool::Task::Task(Task&& other) noexcept : ops_(other.ops_) {
+  if (ops_) {
+    ops_->move(storage_, other.storage_);
+    other.ops_ = nullptr;
+  }
+}
+
+ThreadPool::Task& ThreadPool::Task::operator=(Task&& other) noexcept {
+  if (this != &other) {
+    reset_();
+    ops_ = other.ops_;
+    if (ops_) {
+      ops_->move(storage_, other.storage_);
+      other.ops_ = nullptr;
+    }
+  }
+  return *this;
+}
+
+ThreadPool::Task::~Task() {
+  reset_();
+}
 
-ThreadPool::ThreadPool(size_t thread_count) {
+void ThreadPool::Task::reset_() {
+  if (ops_) {
+    ops_->destroy(storage_);
+    ops_ = nullptr;
+  }
+}
+
+ThreadPool::TaskQueue::TaskQueue()
+    : cells_(new Cell[capacity]), push_pos_(0), pop_pos_(0) {
+  static_assert((capacity & (capacity - 1)) == 0);
+  for (size_t i = 0; i < capacity; i++) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool ThreadPool::TaskQueue::push(Task& task) {
+  Cell* cell;
+  size_t pos = push_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    cell = &cells_[pos & (capacity - 1)];
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+    if (diff == 0) {
+      if (push_pos_.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = push_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  cell->task = std::move(task);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool ThreadPool::TaskQueue::pop(Task& task) {
+  Cell* cell;
+  size_t pos = pop_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    cell = &cells_[pos & (capacity - 1)];
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+    if (diff == 0) {
+      if (pop_pos_.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = pop_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  task = std::move(cell->task);
+  cell->sequence.store(pos + capacity, std::memory_order_release);
+  return true;
+}
+
+ThreadPool::ThreadPool(size_t thread_count)
+    : thread_count_(std::max(thread_count, static_cast<size_t>(1))) {
   if (!thread_controller) {
     thread_controller = std::make_shared<ThreadController>();
   }
-  for (size_t i = 0; i < thread_count; ++i) {
-    // start waiting threads. Workers listen for changes through
-    //  the ThreadPool member condition_variable
-    threads_.emplace_back(std::thread([&]() {
-      std::unique_lock<std::mutex> queue_lock(task_mutex_, std::defer_lock);
-
-      while (true) {
-        queue_lock.lock();
-        task_cv_.wait(queue_lock, [&]() -> bool {
-          return !tasks_.empty() || stop_threads_;
-        });
-
-        // used by dtor to stop all threads without having to
-        //  unceremoniously stop tasks. The tasks must all be
-        //  finished, lest we break a promise and risk a `future`
-        //  object throwing an exception.
-        if (stop_threads_ && tasks_.empty())
-          return;
-
-        // to initialize temp_task, we must move the unique_ptr
-        //  from the queue to the local stack. Since a unique_ptr
-        //  cannot be copied (obviously), it must be explicitly
-        //  moved. This transfers ownership of the pointed-to
-        //  object to *this, as specified in 20.11.1.2.1
-        //  [unique.ptr.single.ctor].
-        auto temp_task = std::move(tasks_.front());
-
-        tasks_.pop();
-        queue_lock.unlock();
-
-        auto thread_state = thread_controller->limit();
-        (*temp_task)();
-        thread_controller->restore(thread_state);
-      }
-    }));
+  for (size_t i = 0; i < thread_count_; ++i) {
+    queues_.push_back(std::make_unique<TaskQueue>());
+  }
+  std::unique_lock<std::mutex> lock(threads_mutex_);
+  for (size_t i = 0; i < thread_count_; ++i) {
+    spawn_();
   }
 }
 
 ThreadPool::~ThreadPool() {
-  stop_threads_ = true;
-  task_cv_.notify_all();
+  {
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    stop_threads_ = true;
+  }
+  sleep_cv_.notify_all();
+  {
+    std::unique_lock<std::mutex> lock(threads_mutex_);
+  }
+  park_cv_.notify_all();
 
-  for (std::thread& thread : threads_) {
+  // running tasks may still block and spawn workers, so we join until
+  //  there is nothing left.
+  while (true) {
+    std::thread thread;
+    {
+      std::unique_lock<std::mutex> lock(threads_mutex_);
+      if (threads_.empty()) {
+        break;
+      }
+      thread = std::move(threads_.back());
+      threads_.pop_back();
+    }
     thread.join();
   }
 }
+
+std::shared_ptr<ThreadPool> ThreadPool::global() {
+  std::unique_lock<std::mutex> lock(global_mutex);
+  if (!global_pool) {
+    global_pool = std::make_shared<ThreadPool>(
+        global_thread_count > 0 ? global_thread_count
+                                : std::thread::hardware_concurrency());
+  }
+  return global_pool;
+}
+
+void ThreadPool::set_global_thread_count(size_t thread_count) {
+  std::unique_lock<std::mutex> lock(global_mutex);
+  global_thread_count = thread_count;
+  global_pool = nullptr;
+}
+
+ThreadPool::Blocking::Blocking() : pool_(current_pool_) {
+  if (pool_) {
+    pool_->begin_blocking_();
+  }
+}
+
+ThreadPool::Blocking::~Blocking() {
+  if (pool_) {
+    pool_->end_blocking_();
+  }
+}
+
+void ThreadPool::begin_blocking_() {
+  std::unique_lock<std::mutex> lock(threads_mutex_);
+  num_blocked_++;
+  if (num_alive_ - num_blocked_ - num_parked_ <
+      static_cast<int64_t>(thread_count_)) {
+    if (num_parked_ > 0) {
+      num_parked_--;
+      unpark_tokens_++;
+      park_cv_.notify_one();
+    } else {
+      spawn_();
+    }
+  }
+}
+
+void ThreadPool::end_blocking_() {
+  std::unique_lock<std::mutex> lock(threads_mutex_);
+  num_blocked_--;
+}
+
+// must be called with threads_mutex_ held
+void ThreadPool::spawn_() {
+  auto index = threads_.size() % queues_.size();
+  num_alive_++;
+  threads_.emplace_back(std::thread([this, index]() { worker_(index); }));
+}
+
+void ThreadPool::park_() {
+  std::unique_lock<std::mutex> lock(threads_mutex_);
+  if (num_alive_ - num_blocked_ - num_parked_ <=
+      static_cast<int64_t>(thread_count_)) {
+    return;
+  }
+  num_parked_++;
+  park_cv_.wait(
+      lock, [this]() -> bool { return unpark_tokens_ > 0 || stop_threads_; });
+  if (unpark_tokens_ > 0) {
+    unpark_tokens_--;
+  } else {
+    num_parked_--;
+  }
+}
+
+void ThreadPool::push_(Task&& task) {
+  auto num_queues = queues_.size();
+  auto start = (current_pool_ == this)
+      ? current_index_
+      : next_queue_.fetch_add(1, std::memory_order_relaxed);
+  bool pushed = false;
+  for (size_t i = 0; i < num_queues && !pushed; i++) {
+    pushed = queues_[(start + i) % num_queues]->push(task);
+  }
+  if (!pushed) {
+    std::unique_lock<std::mutex> lock(overflow_mutex_);
+    overflow_.push_back(std::move(task));
+    overflow_size_++;
+  }
+
+  // pending_ is increased before checking for sleepers, and sleepers
+  //  register themselves before checking pending_ (both under the sleep
+  //  mutex), such that a wake up cannot be missed.
+  pending_++;
+  if (sleeping_ > 0) {
+    {
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_one();
+  }
+}
+
+bool ThreadPool::pop_(size_t index, Task& task) {
+  auto num_queues = queues_.size();
+  for (size_t i = 0; i < num_queues; i++) {
+    if (queues_[(index + i) % num_queues]->pop(task)) {
+      return true;
+    }
+  }
+  if (overflow_size_.load(std::memory_order_relaxed) > 0) {
+    std::unique_lock<std::mutex> lock(overflow_mutex_);
+    if (!overflow_.empty()) {
+      task = std::move(overflow_.front());
+      overflow_.pop_front();
+      overflow_size_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::worker_(size_t index) {
+  current_pool_ = this;
+  current_index_ = index;
+
+  Task task;
+  while (true) {
+    if (num_alive_ - num_blocked_ - num_parked_ >
+        static_cast<int64_t>(thread_count_)) {
+      park_();
+    }
+
+    if (pop_(index, task)) {
+      pending_--;
+      auto thread_state = thread_controller->limit();
+      task();
+      thread_controller->restore(thread_state);
+
+      // release whatever the task captured now, not when the next task
+      //  comes in.
+      task = Task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleeping_++;
+    sleep_cv_.wait(lock, [this]() -> bool {
+      return pending_ > 0 || stop_threads_;
+    });
+    sleeping_--;
+
+    // used by dtor to stop all threads without having to unceremoniously
+    //  stop tasks. The tasks must all be finished, lest we break a promise
+    //  and risk a `future` object throwing an exception.
+    if (stop_threads_ && pending_ == 0) {
+      return;
+    }
+  }
+}
 } // namespace core
 } // namespace data
 } // namespace mlx
@@ -2,14 +2,19 @@
 
 #pragma once
 
-// from https://github.com/fbastos1/thread_pool_cpp17.git
-
+#include <atomic> //atomic
+#include <chrono> //seconds
 #include <condition_variable> //condition_variable
-#include <future> //packaged_task
+#include <cstddef> //max_align_t
+#include <deque> //deque
+#include <future> //promise, future
+#include <memory> //unique_ptr
 #include <mutex> //unique_lock
-#include <queue> //queue
+#include <new> //placement new
 #include <thread> //thread
+#include <tuple> //apply, make_tuple
 #include <type_traits> //invoke_result, enable_if, is_invocable
+#include <utility> //pair
 #include <vector> //vector
 
 #include "mlx/data/core/ThreadController.h"
@@ -18,6 +23,12 @@ namespace mlx {
 namespace data {
 namespace core {
 
+// ThreadPool is a work-stealing pool: each worker owns a bounded task queue,
+//   tasks enqueued from outside the pool are spread round-robin over the
+//   workers, tasks enqueued from a worker go to its own queue, and a worker
+//   which runs out of work steals from the others. Queues are lock-free;
+//   mutexes are only taken to wake up sleeping workers, when a worker blocks
+//   (see Blocking), or when all the queues are full.
 class ThreadPool {
  public:
   ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
@@ -34,84 +45,258 @@ class ThreadPool {
       std::enable_if_t<std::is_invocable_v<F&&, Args&&...>, int> = 0>
   auto enqueue(F&&, Args&&...);
 
- private:
-  // TaskContainerBase and TaskContainer exist simply as a wrapper around a
-  //   MoveConstructible - but not CopyConstructible - Callable object. Since an
-  //   std::function requires a given Callable to be CopyConstructible, we
-  //   cannot construct one from a lambda function that captures a
-  //   non-CopyConstructible object (such as the packaged_task declared in
-  //   enqueue) - because a lambda capturing a non-CopyConstructible object is
-  //   not CopyConstructible.
-
-  // TaskContainerBase exists only to serve as an abstract base for
-  //   TaskContainer.
-  class TaskContainerBase {
+  // Returns the process-wide pool the pipeline stages submit their tasks to
+  //   (through a TaskGroup). It is created on first use.
+  static std::shared_ptr<ThreadPool> global();
+
+  // Sets the number of threads of the global pool (0 means the number of
+  //   cores). Stages created afterwards use the new pool, existing ones keep
+  //   the previous one.
+  static void set_global_thread_count(size_t thread_count);
+
+  // While a Blocking object is alive, the calling thread (if it is a worker
+  //   of a pool) is considered blocked: the pool wakes up or starts another
+  //   worker, such that tasks waiting on other tasks of the same pool cannot
+  //   starve it. The extra worker parks itself once the wait is over.
+  class Blocking {
    public:
-    virtual ~TaskContainerBase() {};
+    Blocking();
+    ~Blocking();
 
-    virtual void operator()() = 0;
+   private:
+    ThreadPool* pool_;
   };
-  using _task_ptr = std::unique_ptr<TaskContainerBase>;
-
-  // TaskContainer takes a typename F, which must be Callable and
-  //  MoveConstructible.
-  //   Furthermore, F must be callable with no arguments; it can, for example,
-  //   be a bind object with no placeholders. F may or may not be
-  //   CopyConstructible.
-  template <typename F, std::enable_if_t<std::is_invocable_v<F&&>, int> = 0>
-  class TaskContainer : public TaskContainerBase {
+
+  // Waits for the future without starving the pool (see Blocking) and
+  //   returns its value.
+  template <typename T>
+  static T get(std::future<T>& future);
+  template <typename T>
+  static T get(std::future<T>&& future) {
+    return get(future);
+  }
+
+  // Acquires the (unique or shared) lock without starving the pool (see
+  //   Blocking) if it is contended. To be used by stages which hold a lock
+  //   while waiting on others.
+  template <typename Lock>
+  static void lock(Lock& lock);
+
+ private:
+  friend class TaskGroup;
+
+  // Task is a type-erased, MoveConstructible - but not CopyConstructible -
+  //   Callable taking no arguments. Callables which fit in inline_size bytes
+  //   (which covers the lambdas used across the library, together with their
+  //   promise) are stored in place, others are moved to the heap.
+  class Task {
    public:
-    // here, std::forward is needed because we need the construction of _f not
-    //  to bind an lvalue reference - it is not a guarantee that an object of
-    //  type F is CopyConstructible, only that it is MoveConstructible.
-    TaskContainer(F&& func) : f_(std::forward<F>(func)) {}
+    static constexpr size_t inline_size = 96;
+
+    Task() = default;
+    template <
+        typename F,
+        typename D = std::decay_t<F>,
+        std::enable_if_t<!std::is_same_v<D, Task>, int> = 0>
+    Task(F&& func);
+    Task(Task&& other) noexcept;
+    Task& operator=(Task&& other) noexcept;
+    ~Task();
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
 
-    void operator()() override {
-      f_();
+    void operator()() {
+      ops_->invoke(storage_);
     }
+    explicit operator bool() const {
+      return ops_ != nullptr;
+    }
+
+   private:
+    struct Ops {
+      void (*invoke)(void*);
+      void (*move)(void* dst, void* src);
+      void (*destroy)(void*);
+    };
+
+    template <typename D>
+    static constexpr bool is_inline_ = sizeof(D) <= inline_size &&
+        alignof(std::max_align_t) % alignof(D) == 0 &&
+        std::is_nothrow_move_constructible_v<D>;
+
+    template <typename D>
+    static const Ops* ops_for_();
+
+    void reset_();
+
+    const Ops* ops_ = nullptr;
+    alignas(std::max_align_t) unsigned char storage_[inline_size];
+  };
+
+  // TaskQueue is a bounded multi-producer multi-consumer queue of Tasks
+  //   (D. Vyukov's algorithm): producers and consumers claim a cell with a
+  //   CAS on their position, and the per-cell sequence number tells whether
+  //   the cell is ready to be written or read. The owner worker and thieves
+  //   consume from the same end, such that tasks complete roughly in
+  //   submission order (which is the order Prefetch and friends wait on
+  //   them).
+  class TaskQueue {
+   public:
+    static constexpr size_t capacity = 256;
+
+    TaskQueue();
+
+    // Both return false (and leave task untouched) when the queue is
+    //   full/empty.
+    bool push(Task& task);
+    bool pop(Task& task);
 
    private:
-    F f_;
+    struct Cell {
+      std::atomic<size_t> sequence;
+      Task task;
+    };
+    static constexpr size_t cache_line_ = 64;
+
+    std::unique_ptr<Cell[]> cells_;
+    alignas(cache_line_) std::atomic<size_t> push_pos_;
+    alignas(cache_line_) std::atomic<size_t> pop_pos_;
   };
 
-  // template <typename F> TaskContainer(F) -> TaskContainer<std::decay<F>>;
+  template <typename F, typename... Args>
+  static auto make_task_(F&& function, Args&&... args);
+
+  void push_(Task&& task);
+  bool pop_(size_t index, Task& task);
+  void worker_(size_t index);
+  void spawn_();
+  void park_();
+  void begin_blocking_();
+  void end_blocking_();
+
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
 
+  // Used only when all the queues are full.
+  std::deque<Task> overflow_;
+  std::mutex overflow_mutex_;
+  std::atomic<size_t> overflow_size_ = 0;
+
+  // Number of tasks enqueued but not yet picked up by a worker.
+  std::atomic<int64_t> pending_ = 0;
+  std::atomic<size_t> next_queue_ = 0;
+  std::atomic<int> sleeping_ = 0;
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  std::atomic<bool> stop_threads_ = false;
+
+  // Workers are spawned when others block (see Blocking), and the ones in
+  //   excess of thread_count_ park themselves until needed again.
+  size_t thread_count_;
+  std::atomic<int64_t> num_alive_ = 0;
+  std::atomic<int64_t> num_blocked_ = 0;
+  std::atomic<int64_t> num_parked_ = 0;
+  int64_t unpark_tokens_ = 0;
+  std::mutex threads_mutex_;
+  std::condition_variable park_cv_;
   std::vector<std::thread> threads_;
-  std::queue<_task_ptr> tasks_;
-  std::mutex task_mutex_;
-  std::condition_variable task_cv_;
-  bool stop_threads_ = false;
+
+  static thread_local ThreadPool* current_pool_;
+  static thread_local size_t current_index_;
   static std::shared_ptr<ThreadController> thread_controller;
 };
 
 template <
     typename F,
-    typename... Args,
-    std::enable_if_t<std::is_invocable_v<F&&, Args&&...>, int>>
-auto ThreadPool::enqueue(F&& function, Args&&... args) {
-  std::unique_lock<std::mutex> queue_lock(task_mutex_, std::defer_lock);
-  std::packaged_task<std::invoke_result_t<F, Args...>()> task_pkg(
+    typename D,
+    std::enable_if_t<!std::is_same_v<D, ThreadPool::Task>, int>>
+ThreadPool::Task::Task(F&& func) {
+  if constexpr (is_inline_<D>) {
+    new (storage_) D(std::forward<F>(func));
+  } else {
+    *reinterpret_cast<D**>(storage_) = new D(std::forward<F>(func));
+  }
+  ops_ = ops_for_<D>();
+}
+
+template <typename D>
+const ThreadPool::Task::Ops* ThreadPool::Task::ops_for_() {
+  if constexpr (is_inline_<D>) {
+    static constexpr Ops ops = {
+        [](void* f) { (*static_cast<D*>(f))(); },
+        [](void* dst, void* src) {
+          new (dst) D(std::move(*static_cast<D*>(src)));
+          static_cast<D*>(src)->~D();
+        },
+        [](void* f) { static_cast<D*>(f)->~D(); }};
+    return &ops;
+  } else {
+    static constexpr Ops ops = {
+        [](void* f) { (**static_cast<D**>(f))(); },
+        [](void* dst, void* src) {
+          *static_cast<D**>(dst) = *static_cast<D**>(src);
+        },
+        [](void* f) { delete *static_cast<D**>(f); }};
+    return &ops;
+  }
+}
+
+template <typename F, typename... Args>
+auto ThreadPool::make_task_(F&& function, Args&&... args) {
+  using R = std::invoke_result_t<F, Args...>;
+  std::promise<R> promise;
+  std::future<R> future = promise.get_future();
+
+  // The task fulfills the promise itself: no packaged_task nor container
+  //   needs to be allocated, only the promise shared state.
+  Task task(
       // in C++20, this could be:
       // [..., _fargs = std::forward<Args>(args)...]
-      [f = std::move(function),
+      [promise = std::move(promise),
+       f = std::forward<F>(function),
        fargs = std::make_tuple(std::forward<Args>(args)...)]() mutable {
-        return std::apply(std::move(f), std::move(fargs));
+        try {
+          if constexpr (std::is_void_v<R>) {
+            std::apply(std::move(f), std::move(fargs));
+            promise.set_value();
+          } else {
+            promise.set_value(std::apply(std::move(f), std::move(fargs)));
+          }
+        } catch (...) {
+          promise.set_exception(std::current_exception());
+        }
       });
-  std::future<std::invoke_result_t<F, Args...>> future = task_pkg.get_future();
 
-  queue_lock.lock();
-  // this lambda move-captures the packaged_task declared above. Since the
-  //  packaged_task type is not CopyConstructible, the function is not
-  //  CopyConstructible either - hence the need for a TaskContainer to wrap
-  //  around it.
-  tasks_.emplace(_task_ptr(
-      new TaskContainer([task(std::move(task_pkg))]() mutable { task(); })));
+  return std::make_pair(std::move(task), std::move(future));
+}
 
-  queue_lock.unlock();
+template <
+    typename F,
+    typename... Args,
+    std::enable_if_t<std::is_invocable_v<F&&, Args&&...>, int>>
+auto ThreadPool::enqueue(F&& function, Args&&... args) {
+  auto [task, future] =
+      make_task_(std::forward<F>(function), std::forward<Args>(args)...);
+  push_(std::move(task));
+  return std::move(future);
+}
 
-  task_cv_.notify_one();
+template <typename T>
+T ThreadPool::get(std::future<T>& future) {
+  if (current_pool_ &&
+      future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    Blocking blocking;
+    future.wait();
+  }
+  return future.get();
+}
 
-  return std::move(future);
+template <typename Lock>
+void ThreadPool::lock(Lock& lock) {
+  if (!lock.try_lock()) {
+    Blocking blocking;
+    lock.lock();
+  }
 }
 } // namespace core
 } // namespace data
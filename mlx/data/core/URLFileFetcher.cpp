@@ -0,0 +1,183 @@
+// Copyright © 2023 Apple Inc.
+
+#include <algorithm>
+
+#include "mlx/data/core/URLFileFetcher.h"
+#include "mlx/data/core/LocalFileFetcher.h"
+
+#if MLX_HAS_AWS
+#include "mlx/data/core/AWSFileFetcher.h"
+#endif
+#if MLX_HAS_CURL
+#include "mlx/data/core/HTTPFileFetcher.h"
+#endif
+
+namespace {
+
+using namespace mlx::data::core;
+
+std::unordered_map<std::string, URLFileFetcher::Factory>& factories() {
+  static std::unordered_map<std::string, URLFileFetcher::Factory> f = {
+      {"file",
+       [](const std::string& authority,
+          const std::filesystem::path& local_prefix,
+          const URLFileFetcherOptions& opt) {
+         LocalFileFetcherOptions lopt;
+         lopt.prefix = "/";
+         lopt.local_prefix = local_prefix;
+         lopt.buffer_size = opt.buffer_size;
+         lopt.num_threads = opt.num_threads;
+         lopt.preallocate = opt.preallocate;
+         lopt.verbose = opt.verbose;
+         return std::make_shared<LocalFileFetcher>(lopt);
+       }},
+#if MLX_HAS_CURL
+      {"http",
+       [](const std::string& authority,
+          const std::filesystem::path& local_prefix,
+          const URLFileFetcherOptions& opt) {
+         HTTPFileFetcherOptions hopt;
+         hopt.local_prefix = local_prefix;
+         hopt.buffer_size = opt.buffer_size;
+         hopt.num_threads = opt.num_threads;
+         hopt.preallocate = opt.preallocate;
+         hopt.verbose = opt.verbose;
+         return std::make_shared<HTTPFileFetcher>("http://" + authority, hopt);
+       }},
+      {"https",
+       [](const std::string& authority,
+          const std::filesystem::path& local_prefix,
+          const URLFileFetcherOptions& opt) {
+         HTTPFileFetcherOptions hopt;
+         hopt.local_prefix = local_prefix;
+         hopt.buffer_size = opt.buffer_size;
+         hopt.num_threads = opt.num_threads;
+         hopt.preallocate = opt.preallocate;
+         hopt.verbose = opt.verbose;
+         return std::make_shared<HTTPFileFetcher>(
+             "https://" + authority, hopt);
+       }},
+#endif
+#if MLX_HAS_AWS
+      {"s3",
+       [](const std::string& authority,
+          const std::filesystem::path& local_prefix,
+          const URLFileFetcherOptions& opt) {
+         AWSFileFetcherOptions aopt;
+         aopt.local_prefix = local_prefix;
+         aopt.buffer_size = opt.buffer_size;
+         aopt.num_threads = opt.num_threads;
+         aopt.preallocate = opt.preallocate;
+         aopt.verbose = opt.verbose;
+         return std::make_shared<AWSFileFetcher>(authority, aopt);
+       }},
+#endif
+  };
+  return f;
+}
+
+std::mutex factories_mutex;
+
+} // namespace
+
+namespace mlx {
+namespace data {
+namespace core {
+
+URLFileFetcher::URLFileFetcher(const URLFileFetcherOptions& opt)
+    : FileFetcher(
+          opt.num_prefetch_max,
+          opt.num_prefetch_threads,
+          opt.num_kept_files,
+          opt.verbose,
+          opt.max_cached_bytes,
+          opt.in_memory),
+      options_(opt) {
+  std::unique_lock lock(factories_mutex);
+  factories_ = factories();
+}
+
+void URLFileFetcher::register_scheme(
+    const std::string& scheme,
+    Factory factory) {
+  std::unique_lock lock(factories_mutex);
+  factories()[scheme] = factory;
+}
+
+std::vector<std::string> URLFileFetcher::schemes() {
+  std::unique_lock lock(factories_mutex);
+  std::vector<std::string> res;
+  for (auto& it : factories()) {
+    res.push_back(it.first);
+  }
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+std::pair<std::shared_ptr<FileFetcher>, std::string> URLFileFetcher::resolve_(
+    const std::string& url) const {
+  auto scheme_end = url.find("://");
+  if (scheme_end == std::string::npos || scheme_end == 0) {
+    throw std::runtime_error("URLFileFetcher: invalid url <" + url + ">");
+  }
+  auto authority_begin = scheme_end + 3;
+  auto authority_end = url.find('/', authority_begin);
+  if (authority_end == std::string::npos || authority_end + 1 == url.size()) {
+    throw std::runtime_error(
+        "URLFileFetcher: no path in url <" + url + ">");
+  }
+  auto scheme = url.substr(0, scheme_end);
+  auto authority =
+      url.substr(authority_begin, authority_end - authority_begin);
+  auto path = url.substr(authority_end + 1);
+
+  std::unique_lock lock(fetchers_mutex_);
+  auto key = url.substr(0, authority_end);
+  auto it = fetchers_.find(key);
+  if (it == fetchers_.end()) {
+    auto factory = factories_.find(scheme);
+    if (factory == factories_.end()) {
+      throw std::runtime_error(
+          "URLFileFetcher: no fetcher registered for scheme <" + scheme +
+          "> (url <" + url + ">)");
+    }
+    // local_prefix / url, where "//" collapses into "/"
+    auto local_prefix = options_.local_prefix / (scheme + ":") / authority;
+    auto fetcher = factory->second(authority, local_prefix, options_);
+    if (!fetcher) {
+      throw std::runtime_error(
+          "URLFileFetcher: no fetcher made for <" + key + ">");
+    }
+    it = fetchers_.emplace(key, fetcher).first;
+  }
+  return {it->second, path};
+}
+
+void URLFileFetcher::backend_fetch(const std::string& filename) const {
+  auto [fetcher, path] = resolve_(filename);
+  fetcher->backend_fetch(path);
+}
+
+std::shared_ptr<Array> URLFileFetcher::backend_fetch_memory(
+    const std::string& filename) const {
+  auto [fetcher, path] = resolve_(filename);
+  return fetcher->backend_fetch_memory(path);
+}
+
+void URLFileFetcher::backend_erase(const std::string& filename) const {
+  auto [fetcher, path] = resolve_(filename);
+  fetcher->backend_erase(path);
+}
+
+int64_t URLFileFetcher::backend_size(const std::string& filename) const {
+  auto [fetcher, path] = resolve_(filename);
+  return fetcher->backend_size(path);
+}
+
+URLFileFetcher::~URLFileFetcher() {
+  cancel_prefetch();
+}
+
+} // namespace core
+} // namespace data
+} // namespace mlx
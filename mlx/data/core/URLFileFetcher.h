@@ -0,0 +1,77 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <mutex>
+
+#include "mlx/data/core/FileFetcher.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+
+struct URLFileFetcherOptions {
+  std::filesystem::path local_prefix = "";
+  int64_t buffer_size = 64 * 1024 * 1024; // 64MB
+  int num_threads = 4;
+  bool preallocate = false;
+  int num_prefetch_max = 1;
+  int num_prefetch_threads = 1;
+  int64_t num_kept_files = 0;
+  int64_t max_cached_bytes = 0;
+  bool in_memory = false;
+  bool verbose = false;
+};
+
+// Fetches files given as URLs (scheme://authority/path), dispatching them to
+// the fetcher registered for their scheme. Built-in schemes are file://
+// (LocalFileFetcher), http:// and https:// (HTTPFileFetcher, if built with
+// libcurl) and s3:// with the bucket as authority (AWSFileFetcher, if built
+// with the AWS SDK).
+//
+// The URL fetcher manages the cache and the prefetching itself, and calls the
+// backend of one fetcher per scheme://authority. Files are stored in
+// local_prefix / url, such that readers given the URLs as filenames and the
+// same local_prefix find them.
+class URLFileFetcher : public FileFetcher {
+ public:
+  // Makes the fetcher of the given authority (for instance the host or the
+  // bucket), storing its files in local_prefix.
+  typedef std::function<std::shared_ptr<FileFetcher>(
+      const std::string& authority,
+      const std::filesystem::path& local_prefix,
+      const URLFileFetcherOptions& opt)>
+      Factory;
+
+  URLFileFetcher(const URLFileFetcherOptions& opt = URLFileFetcherOptions());
+
+  // Registers (or replaces) the factory used for URLs with the given scheme,
+  // by the URL fetchers created afterwards.
+  static void register_scheme(const std::string& scheme, Factory factory);
+  static std::vector<std::string> schemes();
+
+  virtual void backend_fetch(const std::string& filename) const override;
+  virtual std::shared_ptr<Array> backend_fetch_memory(
+      const std::string& filename) const override;
+  virtual void backend_erase(const std::string& filename) const override;
+  virtual int64_t backend_size(const std::string& filename) const override;
+
+  virtual ~URLFileFetcher();
+
+ protected:
+  // Returns the fetcher of the URL and the path to request from it.
+  std::pair<std::shared_ptr<FileFetcher>, std::string> resolve_(
+      const std::string& url) const;
+
+  URLFileFetcherOptions options_;
+  std::unordered_map<std::string, Factory> factories_;
+  mutable std::unordered_map<std::string, std::shared_ptr<FileFetcher>>
+      fetchers_;
+  mutable std::mutex fetchers_mutex_;
+};
+
+} // namespace core
+} // namespace data
+} // namespace mlx
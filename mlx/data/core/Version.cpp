@@ -62,6 +62,18 @@ extern const char* mpg123_distversion(
 #include <aws/core/Version.h>
 #endif
 
+#if MLX_HAS_CURL
+#include <curl/curl.h>
+#endif
+
+#if MLX_HAS_PNG
+#include <png.h>
+#endif
+
+#if MLX_HAS_WEBP
+#include <webp/decode.h>
+#endif
+
 namespace {
 std::string zlib_get_version() {
 #if MLX_HAS_ZLIB
@@ -224,6 +236,30 @@ std::string aws_get_version() {
   return {};
 #endif
 }
+std::string curl_get_version() {
+#if MLX_HAS_CURL
+  return std::string(curl_version_info(CURLVERSION_NOW)->version);
+#else
+  return {};
+#endif
+}
+std::string png_get_version() {
+#if MLX_HAS_PNG
+  return std::string(png_get_libpng_ver(nullptr));
+#else
+  return {};
+#endif
+}
+std::string webp_get_version() {
+#if MLX_HAS_WEBP
+  int version = WebPGetDecoderVersion();
+  return std::to_string((version >> 16) & 0xff) + "." +
+      std::to_string((version >> 8) & 0xff) + "." +
+      std::to_string(version & 0xff);
+#else
+  return {};
+#endif
+}
 } // namespace
 
 #define MLX_DATA_VERSION_STRINGIFY_(x) #x
@@ -255,6 +291,9 @@ std::unordered_map<std::string, std::string> libs_version() {
     libs["samplerate"] = samplerate_get_version();
     libs["ffmpeg"] = ffmpeg_get_version();
     libs["aws"] = aws_get_version();
+    libs["curl"] = curl_get_version();
+    libs["png"] = png_get_version();
+    libs["webp"] = webp_get_version();
   }
   return libs;
 }
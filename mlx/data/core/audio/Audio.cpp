@@ -17,6 +17,20 @@ std::shared_ptr<Array> load(
   return load_sndfile(contents, info);
 }
 
+std::shared_ptr<Array> load(
+    const std::string& path,
+    AudioInfo* info,
+    const FrameRangeFunction& range) {
+  return load_sndfile(path, info, range);
+}
+
+std::shared_ptr<Array> load(
+    const std::shared_ptr<Array>& contents,
+    AudioInfo* info,
+    const FrameRangeFunction& range) {
+  return load_sndfile(contents, info, range);
+}
+
 AudioInfo info(const std::string& path) {
   return info_sndfile(path);
 }
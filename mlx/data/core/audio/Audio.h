@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <functional>
+#include <utility>
+
 #include "mlx/data/Array.h"
 
 namespace mlx {
@@ -17,11 +20,30 @@ struct AudioInfo {
   int channels;
 };
 
+/// Returns the first frame and the number of frames to load given the audio
+/// metadata.
+typedef std::function<std::pair<int64_t, int64_t>(const AudioInfo& info)>
+    FrameRangeFunction;
+
 std::shared_ptr<Array> load(const std::string& path, AudioInfo* info);
 std::shared_ptr<Array> load(
     const std::shared_ptr<Array>& contents,
     AudioInfo* info);
 
+/// Load only the frames in the range returned by range(), which is called
+/// once the audio metadata is known. The decoder seeks to the first frame
+/// such that the cost is bounded by the number of loaded frames rather than
+/// the length of the file. The range is clipped to the audio and info (if
+/// not null) describes the whole file.
+std::shared_ptr<Array> load(
+    const std::string& path,
+    AudioInfo* info,
+    const FrameRangeFunction& range);
+std::shared_ptr<Array> load(
+    const std::shared_ptr<Array>& contents,
+    AudioInfo* info,
+    const FrameRangeFunction& range);
+
 AudioInfo info(const std::string& path);
 AudioInfo info(const std::shared_ptr<Array>& contents);
 
@@ -57,6 +79,59 @@ std::shared_ptr<Array> resample(
     int src_sample_rate,
     int dst_sample_rate);
 
+/// Window applied to the frames before the Fourier transform (symmetric, as
+/// numpy.hamming and numpy.hanning).
+enum class WindowType { Rectangular, Hamming, Hann };
+
+/// "rectangular", "hamming" or "hann".
+WindowType window_type(const std::string& name);
+
+/// Frequency scale on which the filters of a filterbank are evenly spaced.
+enum class FrequencyScale { Mel, Log10, Linear };
+
+/// "mel", "log10" or "linear".
+FrequencyScale frequency_scale(const std::string& name);
+
+/// Short time Fourier transform of mono audio, a float array of shape (n,)
+/// or (n, 1). Frames of frame_length samples starting every hop_length
+/// samples are pre-emphasized (y[i] = x[i] - pre_emphasis * x[i - 1] within
+/// the frame), windowed and zero padded to n_fft, which must be a power of 2.
+/// Returns the magnitudes of their real FFT raised to power, a float array of
+/// shape (frames, n_fft / 2 + 1). The FFT plans and windows are cached per
+/// size.
+std::shared_ptr<Array> stft(
+    const std::shared_ptr<const Array>& audio,
+    int64_t n_fft,
+    int64_t frame_length,
+    int64_t hop_length,
+    WindowType window = WindowType::Hann,
+    float pre_emphasis = 0,
+    float power = 1);
+
+/// Applies num_filters triangular filters, evenly spaced on the given scale
+/// between low_freq and high_freq (sample_rate / 2 if <= 0), to a
+/// spectrogram of shape (frames, bins) as returned by stft(). The filter
+/// energies are clamped below by floor and their log is taken if log is
+/// true. Returns a float array of shape (frames, num_filters). The
+/// filterbanks are cached per configuration.
+std::shared_ptr<Array> mel_filterbank(
+    const std::shared_ptr<const Array>& spectrogram,
+    int sample_rate,
+    int num_filters,
+    float low_freq = 0,
+    float high_freq = 0,
+    FrequencyScale scale = FrequencyScale::Mel,
+    float floor = 0,
+    bool log = true);
+
+/// The first num_coefficients coefficients of the orthonormal DCT-II of log
+/// filterbank energies of shape (frames, filters), as returned by
+/// mel_filterbank(). Returns a float array of shape (frames,
+/// num_coefficients).
+std::shared_ptr<Array> mfcc(
+    const std::shared_ptr<const Array>& log_mel,
+    int num_coefficients);
+
 } // namespace audio
 } // namespace core
 } // namespace data
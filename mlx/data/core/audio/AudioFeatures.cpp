@@ -0,0 +1,446 @@
+// Copyright © 2023 Apple Inc.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "mlx/data/core/audio/Audio.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace audio {
+
+namespace {
+
+// Number of FFT plans, windows, filterbanks or DCT matrices of each kind kept
+// in the cache before it is flushed.
+constexpr size_t kMaxCachedTables = 64;
+
+// Returns the table computed by compute() for key, computing it only once.
+template <typename Key, typename Value, typename F>
+std::shared_ptr<const Value> get_cached(const Key& key, F compute) {
+  static std::mutex mutex;
+  static std::map<Key, std::shared_ptr<const Value>> cache;
+  {
+    std::unique_lock lock(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+  }
+  std::shared_ptr<const Value> value = compute();
+  std::unique_lock lock(mutex);
+  if (cache.size() >= kMaxCachedTables) {
+    cache.clear();
+  }
+  cache.emplace(key, value);
+  return value;
+}
+
+const double pi = std::atan(1.0) * 4;
+
+// Real FFT of size n computed as a complex FFT of size n / 2 on the even and
+// odd samples, which is then split into the spectrum of the real signal.
+struct FFTPlan {
+  int64_t n;
+  std::vector<int64_t> bitrev;
+  // cos and -sin of the twiddles of each radix-2 stage, contiguous per stage
+  // (the stage combining blocks of size h starts at h - 1)
+  std::vector<float> wr;
+  std::vector<float> wi;
+  // cos and -sin of 2 pi k / n for the split, k in [0, n / 2]
+  std::vector<float> sr;
+  std::vector<float> si;
+};
+
+std::shared_ptr<const FFTPlan> get_fft_plan(int64_t n) {
+  return get_cached<int64_t, FFTPlan>(n, [n]() {
+    auto plan = std::make_shared<FFTPlan>();
+    int64_t m = n / 2;
+    plan->n = n;
+    plan->bitrev.resize(m);
+    int bits = 0;
+    while ((int64_t(1) << bits) < m) {
+      bits++;
+    }
+    for (int64_t i = 0; i < m; i++) {
+      int64_t r = 0;
+      for (int b = 0; b < bits; b++) {
+        r |= ((i >> b) & 1) << (bits - 1 - b);
+      }
+      plan->bitrev[i] = r;
+    }
+    plan->wr.resize(std::max<int64_t>(m - 1, 0));
+    plan->wi.resize(std::max<int64_t>(m - 1, 0));
+    for (int64_t h = 1; h < m; h *= 2) {
+      for (int64_t j = 0; j < h; j++) {
+        double angle = -pi * j / h;
+        plan->wr[h - 1 + j] = std::cos(angle);
+        plan->wi[h - 1 + j] = std::sin(angle);
+      }
+    }
+    plan->sr.resize(m + 1);
+    plan->si.resize(m + 1);
+    for (int64_t k = 0; k <= m; k++) {
+      double angle = -2 * pi * k / n;
+      plan->sr[k] = std::cos(angle);
+      plan->si[k] = std::sin(angle);
+    }
+    return plan;
+  });
+}
+
+// Computes the spectrum of the n real samples in x into (re, im), n / 2 + 1
+// values each. tr and ti are scratch buffers of n / 2 values.
+void rfft(
+    const FFTPlan& plan,
+    const float* x,
+    float* re,
+    float* im,
+    float* tr,
+    float* ti) {
+  int64_t m = plan.n / 2;
+  for (int64_t i = 0; i < m; i++) {
+    int64_t j = plan.bitrev[i];
+    tr[i] = x[2 * j];
+    ti[i] = x[2 * j + 1];
+  }
+  // the inner loops run over contiguous twiddles such that they vectorize
+  for (int64_t h = 1; h < m; h *= 2) {
+    const float* wr = plan.wr.data() + h - 1;
+    const float* wi = plan.wi.data() + h - 1;
+    for (int64_t i = 0; i < m; i += 2 * h) {
+      float* ar = tr + i;
+      float* ai = ti + i;
+      float* br = tr + i + h;
+      float* bi = ti + i + h;
+      for (int64_t j = 0; j < h; j++) {
+        float xr = br[j] * wr[j] - bi[j] * wi[j];
+        float xi = br[j] * wi[j] + bi[j] * wr[j];
+        br[j] = ar[j] - xr;
+        bi[j] = ai[j] - xi;
+        ar[j] += xr;
+        ai[j] += xi;
+      }
+    }
+  }
+  for (int64_t k = 0; k <= m; k++) {
+    float a = tr[k % m];
+    float b = ti[k % m];
+    float c = tr[(m - k) % m];
+    float d = ti[(m - k) % m];
+    // spectra of the even (e) and odd (o) samples
+    float er = 0.5f * (a + c);
+    float ei = 0.5f * (b - d);
+    float or_ = 0.5f * (b + d);
+    float oi = -0.5f * (a - c);
+    re[k] = er + plan.sr[k] * or_ - plan.si[k] * oi;
+    im[k] = ei + plan.sr[k] * oi + plan.si[k] * or_;
+  }
+}
+
+std::shared_ptr<const std::vector<float>> get_window(
+    WindowType type,
+    int64_t length) {
+  typedef std::tuple<WindowType, int64_t> Key;
+  return get_cached<Key, std::vector<float>>(
+      Key(type, length), [type, length]() {
+        auto window = std::make_shared<std::vector<float>>(length, 1.0f);
+        if (type == WindowType::Rectangular || length == 1) {
+          return window;
+        }
+        double a = (type == WindowType::Hamming) ? 0.54 : 0.5;
+        for (int64_t i = 0; i < length; i++) {
+          (*window)[i] = a - (1 - a) * std::cos(2 * pi * i / (length - 1));
+        }
+        return window;
+      });
+}
+
+double hertz_to_scale(double hz, FrequencyScale scale) {
+  switch (scale) {
+    case FrequencyScale::Mel:
+      return 2595.0 * std::log10(1.0 + hz / 700.0);
+    case FrequencyScale::Log10:
+      return std::log10(hz);
+    default:
+      return hz;
+  }
+}
+
+double scale_to_hertz(double v, FrequencyScale scale) {
+  switch (scale) {
+    case FrequencyScale::Mel:
+      return 700.0 * (std::pow(10.0, v / 2595.0) - 1.0);
+    case FrequencyScale::Log10:
+      return std::pow(10.0, v);
+    default:
+      return v;
+  }
+}
+
+// Non zero weights of each filter over the bins.
+struct Filterbank {
+  std::vector<int64_t> start;
+  std::vector<int64_t> count;
+  std::vector<float> weights; // count[f] weights from offset[f]
+  std::vector<int64_t> offset;
+};
+
+// Same filters as mlx.data.features.tri_filterbank.
+std::shared_ptr<const Filterbank> get_filterbank(
+    int64_t num_bins,
+    int sample_rate,
+    int num_filters,
+    float low_freq,
+    float high_freq,
+    FrequencyScale scale) {
+  typedef std::tuple<int64_t, int, int, float, float, FrequencyScale> Key;
+  Key key(num_bins, sample_rate, num_filters, low_freq, high_freq, scale);
+  return get_cached<Key, Filterbank>(key, [&]() {
+    double low = hertz_to_scale(low_freq, scale);
+    double high = hertz_to_scale(high_freq, scale);
+    double delta = (high - low) / (num_filters + 1);
+    std::vector<double> edges(num_filters + 2);
+    for (int i = 0; i < num_filters + 2; i++) {
+      edges[i] = scale_to_hertz(low + i * delta, scale) * (num_bins - 1) * 2 /
+          sample_rate;
+    }
+
+    auto bank = std::make_shared<Filterbank>();
+    for (int f = 0; f < num_filters; f++) {
+      bank->offset.push_back(bank->weights.size());
+      int64_t start = -1;
+      int64_t end = -1;
+      for (int64_t b = 0; b < num_bins; b++) {
+        double up = (b - edges[f]) / (edges[f + 1] - edges[f]);
+        double down = (edges[f + 2] - b) / (edges[f + 2] - edges[f + 1]);
+        double w = std::max(std::min(up, down), 0.0);
+        if (w > 0) {
+          if (start < 0) {
+            start = b;
+          }
+          end = b + 1;
+        }
+        if (start >= 0) {
+          bank->weights.push_back(w);
+        }
+      }
+      start = std::max<int64_t>(start, 0);
+      end = std::max(end, start);
+      bank->weights.resize(bank->offset.back() + end - start);
+      bank->start.push_back(start);
+      bank->count.push_back(end - start);
+    }
+    return bank;
+  });
+}
+
+// Orthonormal DCT-II, num_coefficients rows of num_inputs values.
+std::shared_ptr<const std::vector<float>> get_dct(
+    int num_inputs,
+    int num_coefficients) {
+  typedef std::tuple<int, int> Key;
+  return get_cached<Key, std::vector<float>>(
+      Key(num_inputs, num_coefficients), [=]() {
+        auto dct =
+            std::make_shared<std::vector<float>>(num_inputs * num_coefficients);
+        for (int k = 0; k < num_coefficients; k++) {
+          double norm = std::sqrt((k == 0 ? 1.0 : 2.0) / num_inputs);
+          for (int n = 0; n < num_inputs; n++) {
+            (*dct)[k * num_inputs + n] =
+                norm * std::cos(pi / num_inputs * (n + 0.5) * k);
+          }
+        }
+        return dct;
+      });
+}
+
+void verify_features(const std::shared_ptr<const Array>& x, const char* fn) {
+  if (x->type() != ArrayType::Float || x->ndim() != 2) {
+    throw std::runtime_error(
+        std::string("audio::") + fn + ": expected a 2D float array");
+  }
+}
+
+} // namespace
+
+WindowType window_type(const std::string& name) {
+  if (name == "rectangular") {
+    return WindowType::Rectangular;
+  } else if (name == "hamming") {
+    return WindowType::Hamming;
+  } else if (name == "hann") {
+    return WindowType::Hann;
+  }
+  throw std::runtime_error(
+      "audio::window_type: unknown window '" + name +
+      "' (expected 'rectangular', 'hamming' or 'hann')");
+}
+
+FrequencyScale frequency_scale(const std::string& name) {
+  if (name == "mel") {
+    return FrequencyScale::Mel;
+  } else if (name == "log10") {
+    return FrequencyScale::Log10;
+  } else if (name == "linear") {
+    return FrequencyScale::Linear;
+  }
+  throw std::runtime_error(
+      "audio::frequency_scale: unknown scale '" + name +
+      "' (expected 'mel', 'log10' or 'linear')");
+}
+
+std::shared_ptr<Array> stft(
+    const std::shared_ptr<const Array>& audio,
+    int64_t n_fft,
+    int64_t frame_length,
+    int64_t hop_length,
+    WindowType window,
+    float pre_emphasis,
+    float power) {
+  if (audio->type() != ArrayType::Float || audio->ndim() < 1 ||
+      audio->ndim() > 2 || (audio->ndim() == 2 && audio->shape(1) != 1)) {
+    throw std::runtime_error(
+        "audio::stft: expected mono float audio of shape (n,) or (n, 1)");
+  }
+  if (n_fft < 2 || (n_fft & (n_fft - 1)) != 0) {
+    throw std::runtime_error("audio::stft: n_fft must be a power of 2");
+  }
+  if (frame_length <= 0 || frame_length > n_fft) {
+    throw std::runtime_error(
+        "audio::stft: frame length must be in [1, n_fft]");
+  }
+  if (hop_length <= 0) {
+    throw std::runtime_error("audio::stft: hop length must be positive");
+  }
+
+  int64_t n = audio->shape(0);
+  int64_t num_frames =
+      (n < frame_length) ? 0 : (n - frame_length) / hop_length + 1;
+  int64_t num_bins = n_fft / 2 + 1;
+  auto result = std::make_shared<Array>(ArrayType::Float, num_frames, num_bins);
+  auto src = audio->data<float>();
+  auto dst = result->data<float>();
+
+  auto plan = get_fft_plan(n_fft);
+  auto coefs = get_window(window, frame_length)->data();
+  std::vector<float> frame(n_fft, 0.0f);
+  std::vector<float> re(num_bins);
+  std::vector<float> im(num_bins);
+  std::vector<float> tr(n_fft / 2);
+  std::vector<float> ti(n_fft / 2);
+  for (int64_t t = 0; t < num_frames; t++) {
+    auto x = src + t * hop_length;
+    frame[0] = (x[0] - pre_emphasis * x[0]) * coefs[0];
+    for (int64_t i = 1; i < frame_length; i++) {
+      frame[i] = (x[i] - pre_emphasis * x[i - 1]) * coefs[i];
+    }
+    rfft(*plan, frame.data(), re.data(), im.data(), tr.data(), ti.data());
+    auto out = dst + t * num_bins;
+    for (int64_t k = 0; k < num_bins; k++) {
+      out[k] = re[k] * re[k] + im[k] * im[k];
+    }
+    if (power == 1) {
+      for (int64_t k = 0; k < num_bins; k++) {
+        out[k] = std::sqrt(out[k]);
+      }
+    } else if (power != 2) {
+      for (int64_t k = 0; k < num_bins; k++) {
+        out[k] = std::pow(out[k], 0.5f * power);
+      }
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<Array> mel_filterbank(
+    const std::shared_ptr<const Array>& spectrogram,
+    int sample_rate,
+    int num_filters,
+    float low_freq,
+    float high_freq,
+    FrequencyScale scale,
+    float floor,
+    bool log) {
+  verify_features(spectrogram, "mel_filterbank");
+  if (sample_rate <= 0 || num_filters <= 0) {
+    throw std::runtime_error(
+        "audio::mel_filterbank: sample rate and number of filters must be "
+        "positive");
+  }
+  if (high_freq <= 0) {
+    high_freq = sample_rate / 2;
+  }
+  if (low_freq < 0 || low_freq >= high_freq ||
+      (scale == FrequencyScale::Log10 && low_freq == 0)) {
+    throw std::runtime_error(
+        "audio::mel_filterbank: invalid frequency range");
+  }
+
+  int64_t num_frames = spectrogram->shape(0);
+  int64_t num_bins = spectrogram->shape(1);
+  auto bank = get_filterbank(
+      num_bins, sample_rate, num_filters, low_freq, high_freq, scale);
+  auto result =
+      std::make_shared<Array>(ArrayType::Float, num_frames, num_filters);
+  auto src = spectrogram->data<float>();
+  auto dst = result->data<float>();
+  for (int64_t t = 0; t < num_frames; t++) {
+    auto x = src + t * num_bins;
+    auto out = dst + t * num_filters;
+    for (int f = 0; f < num_filters; f++) {
+      auto w = bank->weights.data() + bank->offset[f];
+      auto xf = x + bank->start[f];
+      float acc = 0;
+      for (int64_t b = 0; b < bank->count[f]; b++) {
+        acc += w[b] * xf[b];
+      }
+      acc = std::max(acc, floor);
+      out[f] = log ? std::log(std::max(acc, FLT_MIN)) : acc;
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<Array> mfcc(
+    const std::shared_ptr<const Array>& log_mel,
+    int num_coefficients) {
+  verify_features(log_mel, "mfcc");
+  int64_t num_frames = log_mel->shape(0);
+  int num_inputs = log_mel->shape(1);
+  if (num_coefficients <= 0 || num_coefficients > num_inputs) {
+    throw std::runtime_error(
+        "audio::mfcc: number of coefficients must be in [1, number of "
+        "filters]");
+  }
+
+  auto dct = get_dct(num_inputs, num_coefficients);
+  auto result =
+      std::make_shared<Array>(ArrayType::Float, num_frames, num_coefficients);
+  auto src = log_mel->data<float>();
+  auto dst = result->data<float>();
+  for (int64_t t = 0; t < num_frames; t++) {
+    auto x = src + t * num_inputs;
+    auto out = dst + t * num_coefficients;
+    for (int k = 0; k < num_coefficients; k++) {
+      auto row = dct->data() + k * num_inputs;
+      float acc = 0;
+      for (int n = 0; n < num_inputs; n++) {
+        acc += row[n] * x[n];
+      }
+      out[k] = acc;
+    }
+  }
+  return result;
+}
+
+} // namespace audio
+} // namespace core
+} // namespace data
+} // namespace mlx
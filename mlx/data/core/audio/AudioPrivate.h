@@ -9,10 +9,15 @@ namespace data {
 namespace core {
 namespace audio {
 
-std::shared_ptr<Array> load_sndfile(const std::string& path, AudioInfo* info);
+// Loads the whole audio if range is empty.
+std::shared_ptr<Array> load_sndfile(
+    const std::string& path,
+    AudioInfo* info,
+    const FrameRangeFunction& range = nullptr);
 std::shared_ptr<Array> load_sndfile(
     const std::shared_ptr<Array>& contents,
-    AudioInfo* info);
+    AudioInfo* info,
+    const FrameRangeFunction& range = nullptr);
 
 AudioInfo info_sndfile(const std::string& path);
 AudioInfo info_sndfile(const std::shared_ptr<Array>& contents);
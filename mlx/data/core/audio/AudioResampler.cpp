@@ -0,0 +1,259 @@
+// Copyright © 2023 Apple Inc.
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+
+#include "mlx/data/core/audio/Resampler.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace audio {
+
+struct PolyphaseFilter {
+  int64_t L;
+  int64_t M;
+  // half length of the filter in input frames
+  int64_t K;
+  // L phases of 2K coefficients, phase p gives the weights of the input
+  // frames [base - K + 1, base + K] for the output at base + p / L
+  std::vector<float> coefs;
+};
+
+namespace {
+
+// Number of filters kept in the cache before it is flushed.
+constexpr size_t kMaxCachedFilters = 64;
+
+// Zero crossings of the sinc on each side, Kaiser window beta and cutoff
+// relative to the Nyquist frequency of the lowest rate.
+struct SincQuality {
+  int zero_crossings;
+  double beta;
+  double cutoff;
+};
+
+SincQuality sinc_quality(ResampleMode mode) {
+  switch (mode) {
+    case ResampleMode::best:
+      return {64, 12.0, 0.97};
+    case ResampleMode::medium:
+      return {32, 9.0, 0.95};
+    default:
+      return {16, 7.0, 0.91};
+  }
+}
+
+double bessel_i0(double x) {
+  double sum = 1;
+  double term = 1;
+  for (int k = 1; k < 100; k++) {
+    term *= (x / (2 * k)) * (x / (2 * k));
+    sum += term;
+    if (term < 1e-12 * sum) {
+      break;
+    }
+  }
+  return sum;
+}
+
+std::shared_ptr<const PolyphaseFilter>
+compute_filter(int64_t L, int64_t M, ResampleMode mode) {
+  const double pi = std::atan(1.0) * 4;
+  auto quality = sinc_quality(mode);
+  double scale = std::min(1.0, static_cast<double>(L) / M);
+  double fc = quality.cutoff * scale;
+
+  auto filter = std::make_shared<PolyphaseFilter>();
+  filter->L = L;
+  filter->M = M;
+  filter->K = static_cast<int64_t>(std::ceil(quality.zero_crossings / scale));
+  int64_t K = filter->K;
+  filter->coefs.resize(L * 2 * K);
+  double i0_beta = bessel_i0(quality.beta);
+  for (int64_t p = 0; p < L; p++) {
+    auto row = filter->coefs.data() + p * 2 * K;
+    double total = 0;
+    for (int64_t i = 0; i < 2 * K; i++) {
+      double t = static_cast<double>(p) / L + K - 1 - i;
+      double x = fc * t;
+      double sinc = (x == 0) ? 1.0 : std::sin(pi * x) / (pi * x);
+      double r = t / K;
+      double window = (std::abs(r) < 1)
+          ? bessel_i0(quality.beta * std::sqrt(1 - r * r)) / i0_beta
+          : 0.0;
+      row[i] = fc * sinc * window;
+      total += row[i];
+    }
+    // unit gain for every phase
+    for (int64_t i = 0; i < 2 * K; i++) {
+      row[i] /= total;
+    }
+  }
+  return filter;
+}
+
+std::shared_ptr<const PolyphaseFilter>
+get_filter(int64_t L, int64_t M, ResampleMode mode) {
+  typedef std::tuple<int64_t, int64_t, ResampleMode> Key;
+  static std::mutex mutex;
+  static std::map<Key, std::shared_ptr<const PolyphaseFilter>> cache;
+
+  Key key(L, M, mode);
+  {
+    std::unique_lock lock(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+  }
+  auto filter = compute_filter(L, M, mode);
+  std::unique_lock lock(mutex);
+  if (cache.size() >= kMaxCachedFilters) {
+    cache.clear();
+  }
+  cache.emplace(key, filter);
+  return filter;
+}
+
+// Independent partial sums such that the compiler can vectorize the loop
+// without reordering a single float accumulation.
+float dot(const float* a, const float* b, int64_t size) {
+  constexpr int64_t lanes = 8;
+  float acc[lanes] = {0};
+  int64_t i = 0;
+  for (; i + lanes <= size; i += lanes) {
+    for (int64_t k = 0; k < lanes; k++) {
+      acc[k] += a[i + k] * b[i + k];
+    }
+  }
+  float sum = 0;
+  for (int64_t k = 0; k < lanes; k++) {
+    sum += acc[k];
+  }
+  for (; i < size; i++) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+} // namespace
+
+Resampler::Resampler(
+    int src_sample_rate,
+    int dst_sample_rate,
+    ResampleMode mode,
+    int64_t channels)
+    : channels_(channels) {
+  if (!supports(src_sample_rate, dst_sample_rate, mode)) {
+    throw std::runtime_error(
+        "Resampler: unsupported sample rates or resampling mode");
+  }
+  if (channels <= 0) {
+    throw std::runtime_error("Resampler: channels must be positive");
+  }
+  int64_t g = std::gcd(src_sample_rate, dst_sample_rate);
+  filter_ = get_filter(dst_sample_rate / g, src_sample_rate / g, mode);
+  reset();
+}
+
+bool Resampler::supports(
+    int src_sample_rate,
+    int dst_sample_rate,
+    ResampleMode mode) {
+  if (src_sample_rate <= 0 || dst_sample_rate <= 0) {
+    return false;
+  }
+  if (mode != ResampleMode::best && mode != ResampleMode::medium &&
+      mode != ResampleMode::fastest) {
+    return false;
+  }
+  int64_t g = std::gcd(src_sample_rate, dst_sample_rate);
+  return dst_sample_rate / g <= max_phases;
+}
+
+void Resampler::reset() {
+  int64_t K = filter_->K;
+  buffer_.assign(channels_, std::vector<float>(K - 1, 0.0f));
+  bufferStart_ = -(K - 1);
+  numInput_ = 0;
+  numOutput_ = 0;
+}
+
+void Resampler::append_(const float* data, int64_t frames) {
+  for (int64_t c = 0; c < channels_; c++) {
+    auto& channel = buffer_[c];
+    int64_t size = channel.size();
+    channel.resize(size + frames, 0.0f);
+    if (data) {
+      for (int64_t i = 0; i < frames; i++) {
+        channel[size + i] = data[i * channels_ + c];
+      }
+    }
+  }
+}
+
+void Resampler::compute_(float* dst, int64_t count) {
+  const int64_t L = filter_->L;
+  const int64_t M = filter_->M;
+  const int64_t K = filter_->K;
+  for (int64_t j = 0; j < count; j++) {
+    int64_t n = (numOutput_ + j) * M;
+    auto row = filter_->coefs.data() + (n % L) * 2 * K;
+    int64_t offset = n / L - K + 1 - bufferStart_;
+    for (int64_t c = 0; c < channels_; c++) {
+      dst[j * channels_ + c] = dot(row, buffer_[c].data() + offset, 2 * K);
+    }
+  }
+  numOutput_ += count;
+}
+
+std::shared_ptr<Array> Resampler::process(
+    const std::shared_ptr<const Array>& chunk,
+    bool last) {
+  if (chunk->type() != ArrayType::Float || chunk->ndim() != 2 ||
+      chunk->shape(1) != channels_) {
+    throw std::runtime_error(
+        "Resampler: expected a float array of shape (frames, channels)");
+  }
+  const int64_t L = filter_->L;
+  const int64_t M = filter_->M;
+  const int64_t K = filter_->K;
+  int64_t frames = chunk->shape(0);
+  append_(chunk->data<float>(), frames);
+  numInput_ += frames;
+
+  // the output n needs the input frames up to floor(n * M / L) + K
+  int64_t end;
+  if (last) {
+    append_(nullptr, K);
+    end = numInput_ * L / M;
+  } else {
+    end = std::max<int64_t>((numInput_ - K) * L + M - 1, 0) / M;
+  }
+  int64_t count = std::max<int64_t>(end - numOutput_, 0);
+  auto result = std::make_shared<Array>(ArrayType::Float, count, channels_);
+  compute_(result->data<float>(), count);
+
+  if (last) {
+    reset();
+    return result;
+  }
+  // drop the input frames no output needs anymore
+  int64_t first = numOutput_ * M / L - K + 1;
+  if (first > bufferStart_) {
+    for (auto& channel : buffer_) {
+      channel.erase(channel.begin(), channel.begin() + (first - bufferStart_));
+    }
+    bufferStart_ = first;
+  }
+  return result;
+}
+
+} // namespace audio
+} // namespace core
+} // namespace data
+} // namespace mlx
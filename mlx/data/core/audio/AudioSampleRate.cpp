@@ -1,7 +1,8 @@
 // Copyright © 2023 Apple Inc.
 
-#include <cmath>
+#include <algorithm>
 #include "mlx/data/core/audio/Audio.h"
+#include "mlx/data/core/audio/Resampler.h"
 
 #ifdef MLX_HAS_SAMPLERATE
 #include <samplerate.h>
@@ -14,22 +15,18 @@ namespace audio {
 
 #ifdef MLX_HAS_SAMPLERATE
 
-std::shared_ptr<Array> resample(
+static std::shared_ptr<Array> resample_libsamplerate(
     const std::shared_ptr<Array>& audio,
     ResampleMode resample_mode,
     int src_sample_rate,
     int dst_sample_rate) {
-  if ((dst_sample_rate <= 0) || (src_sample_rate == dst_sample_rate)) {
-    return audio;
-  }
-
   int64_t audio_channels = channels(audio);
   int64_t audio_length = frames(audio);
 
   double length_scale = static_cast<double>(dst_sample_rate) /
       static_cast<double>(src_sample_rate);
-  int64_t new_audio_length =
-      static_cast<int64_t>(std::floor(audio_length * length_scale));
+  // in integers such that exact multiples are not rounded down
+  int64_t new_audio_length = audio_length * dst_sample_rate / src_sample_rate;
   auto result = std::make_shared<Array>(
       ArrayType::Float, new_audio_length, audio_channels);
   SRC_DATA src_data;
@@ -45,19 +42,19 @@ std::shared_ptr<Array> resample(
     throw std::runtime_error(msg);
   }
 
-  if (new_audio_length != src_data.output_frames_gen) {
-    std::vector<int64_t> offset(2, 0);
-    auto new_shape = result->shape();
-    new_shape[0] = src_data.output_frames_gen;
-    result = array::sub(result, offset, new_shape);
-  }
+  // the last frames may not be generated, they are silent as with the sinc
+  // resampler such that the length does not depend on the quality
+  std::fill(
+      result->data<float>() + src_data.output_frames_gen * audio_channels,
+      result->data<float>() + new_audio_length * audio_channels,
+      0.0f);
 
   return result;
 }
 
 #else
 
-std::shared_ptr<Array> resample(
+static std::shared_ptr<Array> resample_libsamplerate(
     const std::shared_ptr<Array>& audio,
     ResampleMode resample_mode,
     int src_sample_rate,
@@ -68,6 +65,24 @@ std::shared_ptr<Array> resample(
 
 #endif
 
+std::shared_ptr<Array> resample(
+    const std::shared_ptr<Array>& audio,
+    ResampleMode resample_mode,
+    int src_sample_rate,
+    int dst_sample_rate) {
+  if ((dst_sample_rate <= 0) || (src_sample_rate == dst_sample_rate)) {
+    return audio;
+  }
+  if (Resampler::supports(src_sample_rate, dst_sample_rate, resample_mode)) {
+    Resampler resampler(
+        src_sample_rate, dst_sample_rate, resample_mode, channels(audio));
+    return resampler.process(audio, true);
+  }
+  // zero order hold, linear and ratios with too many phases
+  return resample_libsamplerate(
+      audio, resample_mode, src_sample_rate, dst_sample_rate);
+}
+
 } // namespace audio
 } // namespace core
 } // namespace data
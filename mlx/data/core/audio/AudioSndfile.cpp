@@ -1,5 +1,9 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 #include "mlx/data/core/audio/AudioPrivate.h"
 
 #ifdef MLX_HAS_SNDFILE
@@ -107,16 +111,56 @@ static AudioInfo read_info(SndfileHandle& sf) {
   return info;
 }
 
-static std::shared_ptr<Array> read_data(SndfileHandle& sf, AudioInfo info) {
+static std::shared_ptr<Array> read_data(
+    SndfileHandle& sf,
+    AudioInfo info,
+    const FrameRangeFunction& range) {
+  int64_t start = 0;
+  int64_t frames = info.frames;
+  if (range) {
+    std::tie(start, frames) = range(info);
+    start = std::min(std::max<int64_t>(start, 0), info.frames);
+    frames = std::min(std::max<int64_t>(frames, 0), info.frames - start);
+  }
+
+  if (start > 0 && sf.seek(start, SEEK_SET) < 0) {
+    // the format does not support seeking, decode and drop the frames
+    // preceding the range
+    constexpr int64_t chunk_frames = 4096;
+    std::vector<float> chunk(chunk_frames * info.channels);
+    int64_t remaining = start;
+    while (remaining > 0) {
+      sf_count_t n = sf.readf(chunk.data(), std::min(remaining, chunk_frames));
+      if (n <= 0) {
+        break;
+      }
+      remaining -= n;
+    }
+  }
+
   std::shared_ptr<Array> dst;
 
-  dst = std::make_shared<Array>(ArrayType::Float, info.frames, info.channels);
-  sf.readf(reinterpret_cast<float*>(dst->data()), info.frames);
+  dst = std::make_shared<Array>(ArrayType::Float, frames, info.channels);
+  sf_count_t frames_read =
+      sf.readf(reinterpret_cast<float*>(dst->data()), frames);
+
+  // the frame count of the header may be larger than what can be decoded,
+  // for instance with truncated files
+  frames_read = std::max<sf_count_t>(frames_read, 0);
+  if (frames_read != frames) {
+    std::vector<int64_t> offset(2, 0);
+    auto new_shape = dst->shape();
+    new_shape[0] = frames_read;
+    dst = array::sub(dst, offset, new_shape);
+  }
 
   return dst;
 }
 
-std::shared_ptr<Array> load_sndfile(const std::string& path, AudioInfo* info) {
+std::shared_ptr<Array> load_sndfile(
+    const std::string& path,
+    AudioInfo* info,
+    const FrameRangeFunction& range) {
   SndfileHandle sf = SndfileHandle(path);
   sf_check_error(sf, false, path);
 
@@ -125,7 +169,7 @@ std::shared_ptr<Array> load_sndfile(const std::string& path, AudioInfo* info) {
     *info = audio_info;
   }
 
-  auto result = read_data(sf, audio_info);
+  auto result = read_data(sf, audio_info, range);
 
   sf_check_error(sf, false, path);
   return result;
@@ -133,7 +177,8 @@ std::shared_ptr<Array> load_sndfile(const std::string& path, AudioInfo* info) {
 
 std::shared_ptr<Array> load_sndfile(
     const std::shared_ptr<Array>& contents,
-    AudioInfo* info) {
+    AudioInfo* info,
+    const FrameRangeFunction& range) {
   SfVioRo sfctx;
   sfctx.data = contents->data();
   sfctx.size = contents->size() * contents->itemsize();
@@ -146,7 +191,7 @@ std::shared_ptr<Array> load_sndfile(
     *info = audio_info;
   }
 
-  auto result = read_data(sf, audio_info);
+  auto result = read_data(sf, audio_info, range);
 
   sf_check_error(sf, true, "");
   return result;
@@ -179,13 +224,17 @@ volatile static void no_sndfile() {
       "audio: mlx was not compiled with audio support (libsndfile)");
 }
 
-std::shared_ptr<Array> load_sndfile(const std::string& path, AudioInfo* info) {
+std::shared_ptr<Array> load_sndfile(
+    const std::string& path,
+    AudioInfo* info,
+    const FrameRangeFunction& range) {
   no_sndfile();
 }
 
 std::shared_ptr<Array> load_sndfile(
     const std::shared_ptr<Array>& contents,
-    AudioInfo* info) {
+    AudioInfo* info,
+    const FrameRangeFunction& range) {
   no_sndfile();
 }
 
@@ -0,0 +1,71 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mlx/data/core/audio/Audio.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace audio {
+
+struct PolyphaseFilter;
+
+// Polyphase windowed sinc resampler which can be fed the audio chunk by
+// chunk.
+//
+// The rates ratio is reduced to dst / src = L / M and each output sample is
+// the dot product of the input around it with one of the L phases of a low
+// pass filter. The filters are computed once per (L, M, mode) and shared by
+// all the resamplers. Integer ratios (e.g. 48kHz to 16kHz) have a single
+// phase and no interpolation at all.
+//
+// Only the sinc modes are supported, for ratios with at most max_phases
+// phases (see supports()).
+class Resampler {
+ public:
+  static constexpr int64_t max_phases = 1024;
+
+  Resampler(
+      int src_sample_rate,
+      int dst_sample_rate,
+      ResampleMode mode,
+      int64_t channels);
+
+  static bool
+  supports(int src_sample_rate, int dst_sample_rate, ResampleMode mode);
+
+  // Resamples the next chunk of audio, a float array of shape (frames,
+  // channels), and returns the output frames that can be computed so far
+  // (they lag the input by the half length of the filter). If last is true,
+  // the chunk ends the audio and all the remaining frames are returned; the
+  // audio is then resampled to floor(frames * dst / src) frames overall, as
+  // with libsamplerate, and the resampler is reset.
+  std::shared_ptr<Array> process(
+      const std::shared_ptr<const Array>& chunk,
+      bool last = false);
+
+  // Forgets the audio seen so far.
+  void reset();
+
+ private:
+  void append_(const float* data, int64_t frames);
+  void compute_(float* dst, int64_t count);
+
+  std::shared_ptr<const PolyphaseFilter> filter_;
+  int64_t channels_;
+  // Input frames of each channel from the absolute frame bufferStart_
+  // (negative at the start, the audio being padded with zeros on both ends).
+  std::vector<std::vector<float>> buffer_;
+  int64_t bufferStart_;
+  int64_t numInput_;
+  int64_t numOutput_;
+};
+
+} // namespace audio
+} // namespace core
+} // namespace data
+} // namespace mlx
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "mlx/data/Array.h"
 
 namespace mlx {
@@ -17,8 +19,42 @@ struct ImageInfo {
   int channels;
 };
 
-std::shared_ptr<Array> load(const std::string& path);
-std::shared_ptr<Array> load(const std::shared_ptr<const Array>& contents);
+/// Load an image. If smallest_side is positive, the image is resized such
+/// that its smallest side is smallest_side (keeping the aspect ratio). JPEG
+/// images are then decoded directly at a reduced scale (1/2, 1/4 or 1/8)
+/// when the result is still larger than the target, which is much faster.
+std::shared_ptr<Array> load(const std::string& path, int64_t smallest_side = 0);
+std::shared_ptr<Array> load(
+    const std::shared_ptr<const Array>& contents,
+    int64_t smallest_side = 0);
+
+/// A region of an image, in pixels.
+struct ImageRegion {
+  int64_t x;
+  int64_t y;
+  int64_t w;
+  int64_t h;
+};
+
+/// Returns the region to load given the (width, height) of the image.
+typedef std::function<ImageRegion(int64_t width, int64_t height)>
+    RegionFunction;
+
+/// Load the region of the image returned by region(), which is called once
+/// the size of the image is known, and resize it to (resize_width,
+/// resize_height) if they are positive. JPEG images only decode the
+/// scanlines (and with libjpeg-turbo the columns) of the region, at a reduced
+/// DCT scale when the region is larger than the target.
+std::shared_ptr<Array> load_region(
+    const std::string& path,
+    const RegionFunction& region,
+    int64_t resize_width = 0,
+    int64_t resize_height = 0);
+std::shared_ptr<Array> load_region(
+    const std::shared_ptr<const Array>& contents,
+    const RegionFunction& region,
+    int64_t resize_width = 0,
+    int64_t resize_height = 0);
 
 ImageInfo info(const std::string& path);
 ImageInfo info(const std::shared_ptr<const Array>& contents);
@@ -51,26 +87,108 @@ inline const int64_t channels(const std::shared_ptr<const Array>& image) {
 std::shared_ptr<Array> scale(
     const std::shared_ptr<const Array>& image,
     double scale);
+
+/// Transforms taking a destination write their result into it when it is not
+/// null, in the manner of VideoReader::read_frame(), and return it instead of
+/// allocating the result. It must have the type and shape of the result (it
+/// is typically a slice of a batch).
 std::shared_ptr<Array> resize(
     const std::shared_ptr<const Array>& image,
     int64_t dw,
-    int64_t dh); // may alter aspect ratio
+    int64_t dh,
+    std::shared_ptr<Array> destination = nullptr); // may alter aspect ratio
 std::shared_ptr<Array> crop(
     const std::shared_ptr<const Array>& image,
     int64_t x,
     int64_t y,
     int64_t w,
-    int64_t h);
-std::shared_ptr<Array>
-affine(const std::shared_ptr<const Array>& image, const float mx[6], bool crop);
-std::shared_ptr<Array>
-rotate(const std::shared_ptr<const Array>& image, double angle, bool crop);
-std::shared_ptr<Array> hflip(const std::shared_ptr<const Array>& image);
+    int64_t h,
+    std::shared_ptr<Array> destination = nullptr);
+
+/// Filters of resize_batch(). They are widened when downscaling, such that
+/// all the source pixels contribute (antialiasing).
+enum class ResizeFilter { Box, Bilinear, Bicubic, Lanczos };
+
+/// Parse "box", "bilinear", "bicubic" or "lanczos".
+ResizeFilter resize_filter(const std::string& name);
+
+/// Resize the images (of any size, but with the same number of channels) to
+/// (dw, dh) into a single [B, dh, dw, C] array. The rows are split across
+/// at most num_threads tasks of the global thread pool (0 means the number
+/// of cores), and the filter coefficients are cached per (source, target)
+/// size.
+std::shared_ptr<Array> resize_batch(
+    const std::vector<std::shared_ptr<const Array>>& images,
+    int64_t dw,
+    int64_t dh,
+    ResizeFilter filter = ResizeFilter::Bilinear,
+    int num_threads = 0);
+
+enum class Interpolation { Nearest, Bilinear };
+
+/// Warp the image with the affine matrix mx (2x3, row major) mapping the
+/// output pixel coordinates to the input ones, both relative to the image
+/// centers. Pixels mapped outside of the image are black. If crop is false
+/// the output is enlarged to fit the transformed image.
+std::shared_ptr<Array> affine(
+    const std::shared_ptr<const Array>& image,
+    const float mx[6],
+    bool crop,
+    Interpolation interpolation = Interpolation::Nearest,
+    std::shared_ptr<Array> destination = nullptr);
+std::shared_ptr<Array> rotate(
+    const std::shared_ptr<const Array>& image,
+    double angle,
+    bool crop,
+    Interpolation interpolation = Interpolation::Nearest,
+    std::shared_ptr<Array> destination = nullptr);
+std::shared_ptr<Array> hflip(
+    const std::shared_ptr<const Array>& image,
+    std::shared_ptr<Array> destination = nullptr);
 std::shared_ptr<Array> channel_reduction(
     const std::shared_ptr<const Array>& image,
     const float bias,
     const float multiplier[3]);
 
+/// Convert uint8 images (HWC, or NHWC for videos and batches of images) to
+/// float as (pixel / 255 - mean[c]) / stddev[c]. mean and stddev hold either
+/// one value per channel or a single value for all of them. If
+/// channels_first, the result is laid out as CHW (or NCHW).
+std::shared_ptr<Array> normalize(
+    const std::shared_ptr<const Array>& images,
+    const std::vector<float>& mean,
+    const std::vector<float>& stddev,
+    bool channels_first = false,
+    std::shared_ptr<Array> destination = nullptr);
+
+/// Scale the brightness, contrast and saturation by the given factors (1
+/// leaves the image unchanged) and rotate the hue by hue turns (in [-0.5,
+/// 0.5]). Saturation and hue only apply to color images, and the alpha
+/// channel of 2 and 4 channels images is left untouched.
+std::shared_ptr<Array> color_jitter(
+    const std::shared_ptr<const Array>& image,
+    float brightness,
+    float contrast,
+    float saturation,
+    float hue,
+    std::shared_ptr<Array> destination = nullptr);
+
+/// Replace the color channels with the luma (rec601), keeping the number of
+/// channels (and the alpha channel).
+std::shared_ptr<Array> grayscale(
+    const std::shared_ptr<const Array>& image,
+    std::shared_ptr<Array> destination = nullptr);
+
+/// Blur the image with a gaussian of standard deviation sigma, truncated to
+/// kernel_size pixels (which must be odd, 0 picks 2 * ceil(3 * sigma) + 1).
+/// The borders are reflected and the alpha channel of 2 and 4 channels images
+/// is left untouched.
+std::shared_ptr<Array> gaussian_blur(
+    const std::shared_ptr<const Array>& image,
+    float sigma,
+    int kernel_size = 0,
+    std::shared_ptr<Array> destination = nullptr);
+
 } // namespace image
 } // namespace core
 } // namespace data
@@ -0,0 +1,208 @@
+// Copyright © 2023 Apple Inc.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+
+#include "mlx/data/core/image/ImageCache.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace image {
+
+namespace {
+
+// Alignment of the spilled images in the spill file.
+constexpr int64_t kSpillAlignment = 64;
+
+int64_t nbytes(const Array& image) {
+  return image.size() * image.itemsize();
+}
+
+// Allocates the disk space of the spill file such that writing to its mapping
+// never faults on a full disk.
+bool reserve(int fd, int64_t size) {
+#ifdef __APPLE__
+  fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0, size, 0};
+  if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+    return false;
+  }
+  return ftruncate(fd, size) == 0;
+#else
+  return posix_fallocate(fd, 0, size) == 0;
+#endif
+}
+
+std::shared_ptr<Array> copy_image(
+    ArrayType type,
+    const std::vector<int64_t>& shape,
+    const void* data) {
+  auto result = std::make_shared<Array>(type, shape);
+  std::memcpy(result->data(), data, nbytes(*result));
+  return result;
+}
+
+} // namespace
+
+ImageCache::ImageCache(
+    int64_t max_cached_bytes,
+    const std::filesystem::path& spill_path,
+    int64_t max_spilled_bytes)
+    : maxCachedBytes_(max_cached_bytes),
+      maxSpilledBytes_(0),
+      spillData_(nullptr) {
+  if (max_cached_bytes < 0 || max_spilled_bytes < 0) {
+    throw std::runtime_error("ImageCache: negative cache size");
+  }
+  if (spill_path.empty() || max_spilled_bytes == 0) {
+    return;
+  }
+
+  int fd = open(spill_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) {
+    throw std::runtime_error(
+        "ImageCache: could not create <" + spill_path.string() + ">");
+  }
+  unlink(spill_path.c_str());
+  if (!reserve(fd, max_spilled_bytes)) {
+    // not enough disk space, the cache only keeps images in memory
+    close(fd);
+    return;
+  }
+  void* data = mmap(
+      nullptr, max_spilled_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error(
+        "ImageCache: could not map <" + spill_path.string() + ">");
+  }
+  spillData_ = static_cast<uint8_t*>(data);
+  maxSpilledBytes_ = max_spilled_bytes;
+}
+
+ImageCache::~ImageCache() {
+  if (spillData_) {
+    munmap(spillData_, maxSpilledBytes_);
+  }
+}
+
+std::shared_ptr<Array> ImageCache::get(const std::string& key) const {
+  std::shared_ptr<const Array> image;
+  const SpilledImage* spilled = nullptr;
+  {
+    std::unique_lock lock(mutex_);
+    auto it = cachedImages_.find(key);
+    if (it != cachedImages_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru);
+      image = it->second.image;
+      stats_.num_hits++;
+    } else {
+      auto sit = spilledImages_.find(key);
+      if (sit == spilledImages_.end()) {
+        stats_.num_misses++;
+        return nullptr;
+      }
+      // spilled images are never moved nor erased
+      spilled = &sit->second;
+      stats_.num_spill_hits++;
+    }
+  }
+  if (image) {
+    return copy_image(image->type(), image->shape(), image->data());
+  }
+  return copy_image(
+      spilled->type, spilled->shape, spillData_ + spilled->offset);
+}
+
+void ImageCache::put(
+    const std::string& key,
+    const std::shared_ptr<const Array>& image) const {
+  int64_t size = nbytes(*image);
+  std::shared_ptr<const Array> copy;
+  if (size <= maxCachedBytes_) {
+    copy = copy_image(image->type(), image->shape(), image->data());
+  }
+
+  std::unique_lock lock(mutex_);
+  if (cachedImages_.find(key) != cachedImages_.end() ||
+      spilledImages_.find(key) != spilledImages_.end()) {
+    // put concurrently by another thread
+    return;
+  }
+  if (!copy) {
+    spill_(key, *image);
+    return;
+  }
+  while (stats_.num_cached_bytes + size > maxCachedBytes_) {
+    auto& evicted_key = lru_.back();
+    auto it = cachedImages_.find(evicted_key);
+    auto& evicted = *it->second.image;
+    spill_(evicted_key, evicted);
+    stats_.num_cached_bytes -= nbytes(evicted);
+    stats_.num_cached_images--;
+    stats_.num_evictions++;
+    cachedImages_.erase(it);
+    lru_.pop_back();
+  }
+  lru_.push_front(key);
+  cachedImages_[key] = {copy, lru_.begin()};
+  stats_.num_cached_bytes += size;
+  stats_.num_cached_images++;
+}
+
+void ImageCache::spill_(const std::string& key, const Array& image) const {
+  int64_t size = nbytes(image);
+  int64_t offset = (stats_.num_spilled_bytes + kSpillAlignment - 1) /
+      kSpillAlignment * kSpillAlignment;
+  if (!spillData_ || offset + size > maxSpilledBytes_) {
+    // full, the image is dropped
+    return;
+  }
+  std::memcpy(spillData_ + offset, image.data(), size);
+  spilledImages_[key] = {image.type(), image.shape(), offset, size};
+  stats_.num_spilled_bytes = offset + size;
+  stats_.num_spilled_images++;
+}
+
+ImageCacheStats ImageCache::stats() const {
+  std::unique_lock lock(mutex_);
+  return stats_;
+}
+
+std::string ImageCache::file_key(const std::filesystem::path& path) {
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return "";
+  }
+  auto time = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    return "";
+  }
+  auto mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   time.time_since_epoch())
+                   .count();
+  return path.string() + ":" + std::to_string(size) + ":" +
+      std::to_string(mtime);
+}
+
+std::string ImageCache::content_key(
+    const std::shared_ptr<const Array>& contents) {
+  // 64 bits FNV-1a
+  auto data = static_cast<const uint8_t*>(contents->data());
+  int64_t size = nbytes(*contents);
+  uint64_t hash = 14695981039346656037ull;
+  for (int64_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * 1099511628211ull;
+  }
+  return "#" + std::to_string(hash) + ":" + std::to_string(size);
+}
+
+} // namespace image
+} // namespace core
+} // namespace data
+} // namespace mlx
@@ -0,0 +1,95 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mlx/data/Array.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace image {
+
+struct ImageCacheStats {
+  int64_t num_hits = 0;
+  int64_t num_spill_hits = 0;
+  int64_t num_misses = 0;
+  int64_t num_evictions = 0;
+  int64_t num_cached_images = 0;
+  int64_t num_cached_bytes = 0;
+  int64_t num_spilled_images = 0;
+  int64_t num_spilled_bytes = 0;
+};
+
+// Keeps decoded images across epochs such that they are decoded only once.
+//
+// The least recently used images are evicted when the cached images take more
+// than max_cached_bytes in memory. If spill_path is not empty, evicted images
+// are written instead to a file of at most max_spilled_bytes which is mapped
+// in memory. The file is removed as soon as it is created and spilled images
+// stay there until the cache is destroyed. Its disk space is allocated upfront
+// and the cache does not spill if the allocation fails.
+//
+// Images are copied in and out of the cache, so callers may modify them.
+class ImageCache {
+ public:
+  ImageCache(
+      int64_t max_cached_bytes,
+      const std::filesystem::path& spill_path = "",
+      int64_t max_spilled_bytes = 0);
+  ~ImageCache();
+
+  ImageCache(const ImageCache&) = delete;
+  ImageCache& operator=(const ImageCache&) = delete;
+
+  // The cached image or nullptr.
+  std::shared_ptr<Array> get(const std::string& key) const;
+  void put(const std::string& key, const std::shared_ptr<const Array>& image)
+      const;
+
+  ImageCacheStats stats() const;
+
+  // Identifies a file by its path, size and modification time (empty if the
+  // file does not exist).
+  static std::string file_key(const std::filesystem::path& path);
+
+  // Identifies file contents by their hash.
+  static std::string content_key(const std::shared_ptr<const Array>& contents);
+
+ private:
+  struct CachedImage {
+    std::shared_ptr<const Array> image;
+    std::list<std::string>::iterator lru;
+  };
+  struct SpilledImage {
+    ArrayType type;
+    std::vector<int64_t> shape;
+    int64_t offset;
+    int64_t size;
+  };
+
+  void spill_(const std::string& key, const Array& image) const;
+
+  int64_t maxCachedBytes_;
+  int64_t maxSpilledBytes_;
+  uint8_t* spillData_;
+
+  mutable std::mutex mutex_;
+  // From the most to the least recently used image.
+  mutable std::list<std::string> lru_;
+  mutable std::unordered_map<std::string, CachedImage> cachedImages_;
+  mutable std::unordered_map<std::string, SpilledImage> spilledImages_;
+  mutable ImageCacheStats stats_;
+};
+
+} // namespace image
+} // namespace core
+} // namespace data
+} // namespace mlx
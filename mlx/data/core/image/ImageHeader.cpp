@@ -0,0 +1,217 @@
+// Copyright © 2023 Apple Inc.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+
+#include "mlx/data/core/image/ImagePrivate.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace image {
+
+namespace {
+
+// Reads at most size bytes at offset into dst, returns the number of bytes
+// read.
+typedef std::function<int64_t(int64_t offset, uint8_t* dst, int64_t size)>
+    ReadFunction;
+
+int be16(const uint8_t* p) {
+  return (p[0] << 8) | p[1];
+}
+
+int be32(const uint8_t* p) {
+  return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+int le16(const uint8_t* p) {
+  return p[0] | (p[1] << 8);
+}
+
+int le24(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16);
+}
+
+// JPEG: walk the segments up to the frame header
+ImageInfo info_jpeg(const ReadFunction& read) {
+  uint8_t buffer[6];
+  int64_t offset = 2;
+  while (read(offset, buffer, 4) == 4) {
+    if (buffer[0] != 0xff) {
+      return {};
+    }
+    int marker = buffer[1];
+    if (marker == 0xff) {
+      // fill byte
+      offset++;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xd0 && marker <= 0xd8)) {
+      // markers without payload
+      offset += 2;
+      continue;
+    }
+    if (marker == 0xd9 || marker == 0xda) {
+      // end of image or start of scan before any frame header
+      return {};
+    }
+    // SOF0-SOF15 except DHT, JPG and DAC
+    if (marker >= 0xc0 && marker <= 0xcf && marker != 0xc4 &&
+        marker != 0xc8 && marker != 0xcc) {
+      if (read(offset + 4, buffer, 5) != 5) {
+        return {};
+      }
+      // the jpeg decoder always outputs RGB
+      return {
+          .width = be16(buffer + 3),
+          .height = be16(buffer + 1),
+          .channels = 3,
+      };
+    }
+    offset += 2 + be16(buffer + 2);
+  }
+  return {};
+}
+
+ImageInfo info_png(const ReadFunction& read) {
+  uint8_t buffer[26];
+  if (read(0, buffer, 26) != 26 || std::memcmp(buffer + 12, "IHDR", 4) != 0) {
+    return {};
+  }
+  // channels once decoded, without alpha except for gray images
+  int channels;
+  switch (buffer[25]) {
+    case 0: // gray
+      channels = 1;
+      break;
+    case 4: // gray and alpha
+      channels = 2;
+      break;
+    case 2: // RGB
+    case 3: // palette
+    case 6: // RGBA
+      channels = 3;
+      break;
+    default:
+      return {};
+  }
+  return {
+      .width = be32(buffer + 16),
+      .height = be32(buffer + 20),
+      .channels = channels,
+  };
+}
+
+ImageInfo info_webp(const ReadFunction& read) {
+  uint8_t buffer[30];
+  if (read(0, buffer, 30) != 30) {
+    return {};
+  }
+  int w, h;
+  if (std::memcmp(buffer + 12, "VP8 ", 4) == 0) {
+    // lossy, dimensions are in the key frame header
+    if (buffer[23] != 0x9d || buffer[24] != 0x01 || buffer[25] != 0x2a) {
+      return {};
+    }
+    w = le16(buffer + 26) & 0x3fff;
+    h = le16(buffer + 28) & 0x3fff;
+  } else if (std::memcmp(buffer + 12, "VP8L", 4) == 0) {
+    // lossless, 14 bits for each dimension after the signature byte
+    if (buffer[20] != 0x2f) {
+      return {};
+    }
+    uint32_t bits = buffer[21] | (buffer[22] << 8) | (buffer[23] << 16) |
+        (static_cast<uint32_t>(buffer[24]) << 24);
+    w = (bits & 0x3fff) + 1;
+    h = ((bits >> 14) & 0x3fff) + 1;
+  } else if (std::memcmp(buffer + 12, "VP8X", 4) == 0) {
+    // extended, the canvas size
+    w = le24(buffer + 24) + 1;
+    h = le24(buffer + 27) + 1;
+  } else {
+    return {};
+  }
+  return {
+      .width = w,
+      .height = h,
+      .channels = 3,
+  };
+}
+
+ImageInfo info_gif(const ReadFunction& read) {
+  uint8_t buffer[10];
+  if (read(0, buffer, 10) != 10) {
+    return {};
+  }
+  // loaded as RGBA by stb_image, without alpha
+  return {
+      .width = le16(buffer + 6),
+      .height = le16(buffer + 8),
+      .channels = 3,
+  };
+}
+
+ImageInfo info_header(const ReadFunction& read) {
+  uint8_t signature[12];
+  int64_t size = read(0, signature, 12);
+#ifdef MLX_HAS_JPEG
+  // without libjpeg, jpeg images are loaded by stb_image which does not
+  // convert gray images to RGB
+  if (size >= 3 && signature[0] == 0xff && signature[1] == 0xd8 &&
+      signature[2] == 0xff) {
+    return info_jpeg(read);
+  }
+#endif
+  if (size >= 8 && std::memcmp(signature, "\x89PNG\r\n\x1a\n", 8) == 0) {
+    return info_png(read);
+  }
+  if (size >= 12 && std::memcmp(signature, "RIFF", 4) == 0 &&
+      std::memcmp(signature + 8, "WEBP", 4) == 0) {
+    return info_webp(read);
+  }
+  if (size >= 6 &&
+      (std::memcmp(signature, "GIF87a", 6) == 0 ||
+       std::memcmp(signature, "GIF89a", 6) == 0)) {
+    return info_gif(read);
+  }
+  return {};
+}
+
+} // namespace
+
+ImageInfo info_header(const std::string& path) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) {
+    return {};
+  }
+  auto info = info_header([f](int64_t offset, uint8_t* dst, int64_t size) {
+    if (fseek(f, offset, SEEK_SET) != 0) {
+      return static_cast<int64_t>(0);
+    }
+    return static_cast<int64_t>(fread(dst, 1, size, f));
+  });
+  fclose(f);
+  return info;
+}
+
+ImageInfo info_header(const std::shared_ptr<const Array> contents) {
+  auto data = static_cast<const uint8_t*>(contents->data());
+  int64_t data_size = contents->size();
+  return info_header([data, data_size](
+                         int64_t offset, uint8_t* dst, int64_t size) {
+    if (offset < 0 || offset > data_size) {
+      return static_cast<int64_t>(0);
+    }
+    size = std::max<int64_t>(0, std::min(size, data_size - offset));
+    std::memcpy(dst, data + offset, size);
+    return size;
+  });
+}
+
+} // namespace image
+} // namespace core
+} // namespace data
+} // namespace mlx
@@ -1,5 +1,7 @@
 // Copyright © 2023 Apple Inc.
 
+#include <cmath>
+
 #include "mlx/data/core/image/ImagePrivate.h"
 
 namespace mlx {
@@ -7,28 +9,136 @@ namespace data {
 namespace core {
 namespace image {
 
-std::shared_ptr<Array> load(const std::string& path) {
-  auto result = load_jpeg(path);
+std::pair<int64_t, int64_t>
+smallest_side_dimensions(int64_t w, int64_t h, int64_t size) {
+  if (size <= 0) {
+    throw std::runtime_error(
+        "image::load: illegal target size: " + std::to_string(size));
+  }
+  double scale = (double)size / std::min(w, h);
+  return {std::lround(scale * w), std::lround(scale * h)};
+}
+
+static SizeFunction smallest_side_function(int64_t smallest_side) {
+  if (smallest_side <= 0) {
+    return nullptr;
+  }
+  return [smallest_side](int64_t w, int64_t h) {
+    return smallest_side_dimensions(w, h, smallest_side);
+  };
+}
+
+static SizeFunction resize_function(int64_t width, int64_t height) {
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  return [width, height](int64_t w, int64_t h) {
+    return std::make_pair(width, height);
+  };
+}
+
+// decodes images which are not jpeg, with the native decoders if available
+template <typename Source>
+static std::shared_ptr<Array> load_image(const Source& source) {
+  auto image = load_png(source);
+  if (!image) {
+    image = load_webp(source);
+  }
+  if (!image) {
+    image = load_stbi(source);
+  }
+  return image;
+}
+
+// the fallback of load_jpeg(): crop and resize the decoded image
+static std::shared_ptr<Array> crop_and_resize(
+    std::shared_ptr<Array> image,
+    const RegionFunction& region_fn,
+    const SizeFunction& size_fn) {
+  if (!image) {
+    return image;
+  }
+  if (region_fn) {
+    auto region = region_fn(width(image), height(image));
+    if (region.x < 0 || region.y < 0 || region.w <= 0 || region.h <= 0 ||
+        region.x + region.w > width(image) ||
+        region.y + region.h > height(image)) {
+      throw std::runtime_error("image::load: invalid image region");
+    }
+    if (region.w != width(image) || region.h != height(image)) {
+      image = crop(image, region.x, region.y, region.w, region.h);
+    }
+  }
+  if (size_fn) {
+    auto [tw, th] = size_fn(width(image), height(image));
+    if (tw != width(image) || th != height(image)) {
+      image = resize(image, tw, th);
+    }
+  }
+  return image;
+}
+
+std::shared_ptr<Array> load(const std::string& path, int64_t smallest_side) {
+  // jpeg images are resized while decoding
+  auto size_fn = smallest_side_function(smallest_side);
+  auto result = load_jpeg(path, nullptr, size_fn);
   if (result == nullptr) {
-    result = load_stbi(path);
+    result = crop_and_resize(load_image(path), nullptr, size_fn);
   }
   return result;
 }
 
-std::shared_ptr<Array> load(const std::shared_ptr<const Array>& contents) {
-  auto result = load_jpeg(contents);
+std::shared_ptr<Array> load(
+    const std::shared_ptr<const Array>& contents,
+    int64_t smallest_side) {
+  auto size_fn = smallest_side_function(smallest_side);
+  auto result = load_jpeg(contents, nullptr, size_fn);
   if (result == nullptr) {
-    result = load_stbi(contents);
+    result = crop_and_resize(load_image(contents), nullptr, size_fn);
+  }
+  return result;
+}
+
+std::shared_ptr<Array> load_region(
+    const std::string& path,
+    const RegionFunction& region,
+    int64_t resize_width,
+    int64_t resize_height) {
+  auto size_fn = resize_function(resize_width, resize_height);
+  auto result = load_jpeg(path, region, size_fn);
+  if (result == nullptr) {
+    result = crop_and_resize(load_image(path), region, size_fn);
+  }
+  return result;
+}
+
+std::shared_ptr<Array> load_region(
+    const std::shared_ptr<const Array>& contents,
+    const RegionFunction& region,
+    int64_t resize_width,
+    int64_t resize_height) {
+  auto size_fn = resize_function(resize_width, resize_height);
+  auto result = load_jpeg(contents, region, size_fn);
+  if (result == nullptr) {
+    result = crop_and_resize(load_image(contents), region, size_fn);
   }
   return result;
 }
 
 ImageInfo info(const std::string& path) {
-  return info_stbi(path);
+  auto result = info_header(path);
+  if (result.width <= 0) {
+    result = info_stbi(path);
+  }
+  return result;
 }
 
 ImageInfo info(const std::shared_ptr<const Array>& contents) {
-  return info_stbi(contents);
+  auto result = info_header(contents);
+  if (result.width <= 0) {
+    result = info_stbi(contents);
+  }
+  return result;
 }
 
 bool save(const std::shared_ptr<const Array>& image, const std::string& path) {
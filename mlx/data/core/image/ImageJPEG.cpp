@@ -2,6 +2,7 @@
 
 #include <strings.h>
 #include <filesystem>
+#include <tuple>
 #include "mlx/data/core/image/ImagePrivate.h"
 
 #ifdef MLX_HAS_JPEG
@@ -96,56 +97,135 @@ static bool check_signature(const std::shared_ptr<const Array> contents) {
   return verify_signature(signature, signature_size);
 }
 
-static std::shared_ptr<Array> load_jpeg(struct jpeg_decompress_struct& info) {
+// Destroys the decompressor however the decoding ends, the error handlers
+// throwing through libjpeg.
+struct JpegDecompressGuard {
+  jpeg_decompress_struct* info;
+  ~JpegDecompressGuard() {
+    jpeg_destroy_decompress(info);
+  }
+};
+
+static std::shared_ptr<Array> load_jpeg(
+    struct jpeg_decompress_struct& info,
+    const RegionFunction& region_fn,
+    const SizeFunction& size_fn) {
   jpeg_read_header(&info, 1);
+  int64_t iw = info.image_width;
+  int64_t ih = info.image_height;
+  ImageRegion region = {0, 0, iw, ih};
+  if (region_fn) {
+    region = region_fn(iw, ih);
+    if (region.x < 0 || region.y < 0 || region.w <= 0 || region.h <= 0 ||
+        region.x + region.w > iw || region.y + region.h > ih) {
+      throw std::runtime_error("load_jpeg: invalid image region");
+    }
+  }
+  int64_t tw = region.w;
+  int64_t th = region.h;
+  if (size_fn) {
+    std::tie(tw, th) = size_fn(region.w, region.h);
+  }
+
+  // [begin, end) of the region once the image is scaled by 1/denom
+  auto scaled = [](int64_t begin, int64_t size, int64_t denom) {
+    return std::make_pair(begin / denom, (begin + size + denom - 1) / denom);
+  };
+
+  // pick the smallest DCT scaling which keeps the region at least as large
+  // as the target, the rest is done by resizing. Without a target the
+  // region is decoded at full scale.
+  int64_t denom = size_fn ? 8 : 1;
+  for (; denom > 1; denom /= 2) {
+    auto [x0, x1] = scaled(region.x, region.w, denom);
+    auto [y0, y1] = scaled(region.y, region.h, denom);
+    if (x1 - x0 >= tw && y1 - y0 >= th) {
+      break;
+    }
+  }
+  info.scale_num = 1;
+  info.scale_denom = denom;
   jpeg_start_decompress(&info);
-  int64_t w = info.output_width;
-  int64_t h = info.output_height;
-  int64_t c = 3; // info.num_components;
+
+  int64_t nc = info.output_components;
+  if (nc != 1 && nc != 3 && nc != 4) {
+    return nullptr;
+  }
+  auto [x0, x1] = scaled(region.x, region.w, denom);
+  auto [y0, y1] = scaled(region.y, region.h, denom);
+  x1 = std::min<int64_t>(x1, info.output_width);
+  y1 = std::min<int64_t>(y1, info.output_height);
+  int64_t w = x1 - x0;
+  int64_t h = y1 - y0;
+
+  // x0 in the decoded scanlines
+  int64_t xoffset = x0;
+  std::vector<unsigned char> buffer;
+#ifdef LIBJPEG_TURBO_VERSION
+  // only decode the iMCU columns and the scanlines of the region. The
+  // upsampled chroma of a pixel depends on the neighboring samples, so the
+  // columns are cropped with a margin such that the region is decoded as in
+  // the full image.
+  if (w < info.output_width) {
+    int64_t margin = info.max_h_samp_factor;
+    JDIMENSION crop_x = std::max<int64_t>(x0 - margin, 0);
+    JDIMENSION crop_w =
+        std::min<int64_t>(x1 + margin, info.output_width) - crop_x;
+    jpeg_crop_scanline(&info, &crop_x, &crop_w);
+    xoffset = x0 - crop_x;
+  }
+  if (y0 > 0) {
+    jpeg_skip_scanlines(&info, y0);
+  }
+  buffer.resize(nc * info.output_width);
+#else
+  buffer.resize(nc * info.output_width);
+  while (info.output_scanline < y0) {
+    auto p = buffer.data();
+    jpeg_read_scanlines(&info, &p, 1);
+  }
+#endif
+
+  int64_t c = 3;
   auto result = std::make_shared<Array>(ArrayType::UInt8, h, w, c);
-  if (info.num_components == 3) {
-    while (info.output_scanline < info.output_height) {
-      unsigned char* p = (unsigned char*)(result->data()) +
-          3 * info.output_width * info.output_scanline;
-      jpeg_read_scanlines(&info, &p, 1);
+  for (int64_t y = 0; y < h; y++) {
+    unsigned char* p_dst =
+        static_cast<unsigned char*>(result->data()) + c * w * y;
+    if (nc == 3 && xoffset == 0 && w == info.output_width) {
+      jpeg_read_scanlines(&info, &p_dst, 1);
+      continue;
     }
-  } else if (info.num_components == 4) {
-    std::vector<unsigned char> buffer(4 * info.output_width);
-    while (info.output_scanline < info.output_height) {
-      auto p = buffer.data();
-      unsigned char* p_dst = (unsigned char*)(result->data()) +
-          3 * info.output_width * info.output_scanline;
-      jpeg_read_scanlines(&info, &p, 1);
-      for (int64_t i = 0; i < info.output_width; i++) {
-        p_dst[i * 3] = p[i * 4];
-        p_dst[i * 3 + 1] = p[i * 4 + 1];
-        p_dst[i * 3 + 2] = p[i * 4 + 2];
-      }
-    }
-  } else if (info.num_components == 1) {
-    std::vector<unsigned char> buffer(1 * info.output_width);
-    while (info.output_scanline < info.output_height) {
-      auto p = buffer.data();
-      unsigned char* p_dst = (unsigned char*)(result->data()) +
-          3 * info.output_width * info.output_scanline;
-      jpeg_read_scanlines(&info, &p, 1);
-      for (int64_t i = 0; i < info.output_width; i++) {
+    auto p = buffer.data();
+    jpeg_read_scanlines(&info, &p, 1);
+    p += nc * xoffset;
+    if (nc == 1) {
+      for (int64_t i = 0; i < w; i++) {
         p_dst[i * 3] = p[i];
         p_dst[i * 3 + 1] = p[i];
         p_dst[i * 3 + 2] = p[i];
       }
+    } else {
+      for (int64_t i = 0; i < w; i++) {
+        p_dst[i * 3] = p[i * nc];
+        p_dst[i * 3 + 1] = p[i * nc + 1];
+        p_dst[i * 3 + 2] = p[i * nc + 2];
+      }
     }
-  } else {
-    jpeg_destroy_decompress(&info);
-    return nullptr;
   }
-  jpeg_finish_decompress(&info);
-  jpeg_destroy_decompress(&info);
+  if (info.output_scanline == info.output_height) {
+    jpeg_finish_decompress(&info);
+  }
 
+  if (w != tw || h != th) {
+    result = resize(result, tw, th);
+  }
   return result;
 }
 
-std::shared_ptr<Array> load_jpeg(const std::string& path) {
+std::shared_ptr<Array> load_jpeg(
+    const std::string& path,
+    const RegionFunction& region,
+    const SizeFunction& size) {
   if (!check_signature(path)) {
     // not a jpeg
     return nullptr;
@@ -161,11 +241,9 @@ std::shared_ptr<Array> load_jpeg(const std::string& path) {
     struct jpeg_error_mgr err;
     FILE* f;
     const std::string* filename;
-    jpeg_decompress_struct* info;
   } cerr;
   cerr.f = f;
   cerr.filename = &path;
-  cerr.info = &info;
 
   info.err = jpeg_std_error((jpeg_error_mgr*)&cerr);
   cerr.err.error_exit = [](j_common_ptr cinfo) {
@@ -174,16 +252,25 @@ std::shared_ptr<Array> load_jpeg(const std::string& path) {
     struct CustomErrorMgr* cerr = (struct CustomErrorMgr*)(cinfo->err);
     if (cerr->f) {
       fclose(cerr->f);
+      cerr->f = nullptr;
     }
-    jpeg_destroy_decompress(cerr->info);
     throw std::runtime_error(
         "load_jpeg: could not load <" + *cerr->filename + "> (" +
         std::string(jpeg_last_error_msg) + ")");
   };
   jpeg_create_decompress(&info);
+  JpegDecompressGuard guard = {&info};
   jpeg_stdio_src(&info, f);
 
-  auto result = load_jpeg(info);
+  std::shared_ptr<Array> result;
+  try {
+    result = load_jpeg(info, region, size);
+  } catch (...) {
+    if (cerr.f) {
+      fclose(cerr.f);
+    }
+    throw;
+  }
   fclose(f);
 
   if (result == nullptr) {
@@ -194,7 +281,10 @@ std::shared_ptr<Array> load_jpeg(const std::string& path) {
   return result;
 }
 
-std::shared_ptr<Array> load_jpeg(const std::shared_ptr<const Array> contents) {
+std::shared_ptr<Array> load_jpeg(
+    const std::shared_ptr<const Array> contents,
+    const RegionFunction& region,
+    const SizeFunction& size) {
   if (!check_signature(contents)) {
     // not a jpeg
     return nullptr;
@@ -203,25 +293,22 @@ std::shared_ptr<Array> load_jpeg(const std::shared_ptr<const Array> contents) {
   struct jpeg_decompress_struct info;
   struct CustomErrorMgr {
     struct jpeg_error_mgr err;
-    jpeg_decompress_struct* info;
   } cerr;
-  cerr.info = &info;
 
   info.err = jpeg_std_error((jpeg_error_mgr*)&cerr);
   cerr.err.error_exit = [](j_common_ptr cinfo) {
     char jpeg_last_error_msg[JMSG_LENGTH_MAX];
     (*(cinfo->err->format_message))(cinfo, jpeg_last_error_msg);
-    struct CustomErrorMgr* cerr = (struct CustomErrorMgr*)(cinfo->err);
-    jpeg_destroy_decompress(cerr->info);
     throw std::runtime_error(
         "load_jpeg: could not load from memory (" +
         std::string(jpeg_last_error_msg) + ")");
   };
   jpeg_create_decompress(&info);
+  JpegDecompressGuard guard = {&info};
   jpeg_mem_set_source_mgr(
       &info, (const uint8_t*)contents->data(), contents->size());
 
-  auto result = load_jpeg(info);
+  auto result = load_jpeg(info, region, size);
 
   if (result == nullptr) {
     throw std::runtime_error(
@@ -318,11 +405,17 @@ bool save_jpeg(
 
 #else
 
-std::shared_ptr<Array> load_jpeg(const std::string& path) {
+std::shared_ptr<Array> load_jpeg(
+    const std::string& path,
+    const RegionFunction& region,
+    const SizeFunction& size) {
   return nullptr;
 }
 
-std::shared_ptr<Array> load_jpeg(const std::shared_ptr<const Array> contents) {
+std::shared_ptr<Array> load_jpeg(
+    const std::shared_ptr<const Array> contents,
+    const RegionFunction& region,
+    const SizeFunction& size) {
   return nullptr;
 }
 
@@ -0,0 +1,170 @@
+// Copyright © 2023 Apple Inc.
+
+#include <cstring>
+#include <vector>
+
+#include "mlx/data/core/image/ImagePrivate.h"
+
+#ifdef MLX_HAS_PNG
+#include <png.h>
+#endif
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace image {
+
+#ifdef MLX_HAS_PNG
+
+static bool verify_signature(const uint8_t* signature, int64_t signature_size) {
+  return (signature_size >= 8) && (png_sig_cmp(signature, 0, 8) == 0);
+}
+
+struct PngMemoryReader {
+  const uint8_t* data;
+  size_t size;
+  size_t offset;
+};
+
+static void png_memory_read(png_structp png, png_bytep dst, size_t size) {
+  auto reader = static_cast<PngMemoryReader*>(png_get_io_ptr(png));
+  if (size > reader->size - reader->offset) {
+    png_error(png, "unexpected end of data");
+  }
+  std::memcpy(dst, reader->data + reader->offset, size);
+  reader->offset += size;
+}
+
+// Decodes the image the same way stb_image does: 8 bits per channel, palettes
+// expanded to RGB and alpha dropped from RGBA images (but kept for gray
+// images).
+static std::shared_ptr<Array> load_png(png_structp png, png_infop info) {
+  png_read_info(png, info);
+  int64_t w = png_get_image_width(png, info);
+  int64_t h = png_get_image_height(png, info);
+  int color_type = png_get_color_type(png, info);
+  int bit_depth = png_get_bit_depth(png, info);
+  if (bit_depth == 16) {
+    png_set_strip_16(png);
+  }
+  if (color_type == PNG_COLOR_TYPE_PALETTE) {
+    png_set_palette_to_rgb(png);
+  }
+  if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8) {
+    png_set_expand_gray_1_2_4_to_8(png);
+  }
+  if (color_type == PNG_COLOR_TYPE_RGB_ALPHA) {
+    png_set_strip_alpha(png);
+  }
+  png_set_interlace_handling(png);
+  png_read_update_info(png, info);
+
+  int64_t c = png_get_channels(png, info);
+  if (c < 1 || c > 3 ||
+      png_get_rowbytes(png, info) != static_cast<size_t>(w * c)) {
+    png_error(png, "unsupported pixel format");
+  }
+  auto result = std::make_shared<Array>(UInt8, h, w, c);
+  std::vector<png_bytep> rows(h);
+  for (int64_t y = 0; y < h; y++) {
+    rows[y] = static_cast<png_bytep>(result->data()) + y * w * c;
+  }
+  png_read_image(png, rows.data());
+  png_read_end(png, nullptr);
+  return result;
+}
+
+// Creates the libpng structures, lets setup() configure the input and
+// decodes. libpng errors are reported as exceptions.
+template <typename F>
+static std::shared_ptr<Array> load_png(F setup) {
+  auto png = png_create_read_struct(
+      PNG_LIBPNG_VER_STRING,
+      nullptr,
+      [](png_structp png, png_const_charp msg) {
+        throw std::runtime_error(msg);
+      },
+      [](png_structp png, png_const_charp msg) {});
+  if (!png) {
+    throw std::runtime_error("could not allocate decoder");
+  }
+  auto info = png_create_info_struct(png);
+  std::shared_ptr<Array> result;
+  try {
+    if (!info) {
+      throw std::runtime_error("could not allocate decoder");
+    }
+    setup(png);
+    result = load_png(png, info);
+  } catch (...) {
+    png_destroy_read_struct(&png, &info, nullptr);
+    throw;
+  }
+  png_destroy_read_struct(&png, &info, nullptr);
+  return result;
+}
+
+std::shared_ptr<Array> load_png(const std::string& path) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) {
+    throw std::runtime_error("load_png: could not load <" + path + ">");
+  }
+  uint8_t signature[8];
+  int64_t signature_size = fread(signature, 1, 8, f);
+  if (!verify_signature(signature, signature_size)) {
+    // not a png
+    fclose(f);
+    return nullptr;
+  }
+
+  std::shared_ptr<Array> result;
+  try {
+    result = load_png([f](png_structp png) {
+      png_init_io(png, f);
+      png_set_sig_bytes(png, 8);
+    });
+  } catch (const std::exception& e) {
+    fclose(f);
+    throw std::runtime_error(
+        "load_png: could not load <" + path + "> (" + e.what() + ")");
+  }
+  fclose(f);
+  return result;
+}
+
+std::shared_ptr<Array> load_png(const std::shared_ptr<const Array> contents) {
+  auto data = static_cast<const uint8_t*>(contents->data());
+  if (!verify_signature(data, contents->size())) {
+    // not a png
+    return nullptr;
+  }
+
+  PngMemoryReader reader = {data, static_cast<size_t>(contents->size()), 8};
+  try {
+    return load_png([&reader](png_structp png) {
+      png_set_read_fn(png, &reader, png_memory_read);
+      png_set_sig_bytes(png, 8);
+    });
+  } catch (const std::exception& e) {
+    throw std::runtime_error(
+        std::string("load_png: could not load from memory (") + e.what() +
+        ")");
+  }
+}
+
+#else
+
+std::shared_ptr<Array> load_png(const std::string& path) {
+  return nullptr;
+}
+
+std::shared_ptr<Array> load_png(const std::shared_ptr<const Array> contents) {
+  return nullptr;
+}
+
+#endif
+
+} // namespace image
+} // namespace core
+} // namespace data
+} // namespace mlx
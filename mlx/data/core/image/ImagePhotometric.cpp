@@ -0,0 +1,333 @@
+// Copyright © 2023 Apple Inc.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "mlx/data/core/image/Image.h"
+#include "mlx/data/core/image/ImagePrivate.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace image {
+
+namespace {
+
+// Fixed point precision of the color matrices.
+constexpr int kMatrixBits = 14;
+
+// rec601 luma in 8 bits fixed point.
+constexpr int kLumaR = 77;
+constexpr int kLumaG = 150;
+constexpr int kLumaB = 29;
+
+inline uint8_t luma(const uint8_t* p) {
+  return (kLumaR * p[0] + kLumaG * p[1] + kLumaB * p[2] + 128) >> 8;
+}
+
+inline uint8_t clamp_uint8(int v) {
+  return std::min(std::max(v, 0), 255);
+}
+
+inline uint8_t round_uint8(float v) {
+  return std::min(std::max(v, 0.0f), 255.0f) + 0.5f;
+}
+
+// One row of a fixed point color matrix applied to (r, g, b).
+inline uint8_t mix(const int32_t* row, int32_t r, int32_t g, int32_t b) {
+  constexpr int32_t half = 1 << (kMatrixBits - 1);
+  int32_t v = row[0] * r + row[1] * g + row[2] * b + half;
+  return clamp_uint8(v >> kMatrixBits);
+}
+
+void verify_uint8_image(
+    const std::shared_ptr<const Array>& image,
+    const std::string& fn) {
+  verify_image(image);
+  if (image->type() != UInt8) {
+    throw std::runtime_error("image::" + fn + ": image must be UInt8");
+  }
+}
+
+// Brightness and contrast are a per-value mapping: the image is scaled by
+// brightness, then blended with its mean luma by contrast.
+void brightness_contrast_lut(
+    const uint8_t* src,
+    int64_t n,
+    int64_t c,
+    float brightness,
+    float contrast,
+    uint8_t lut[256]) {
+  for (int v = 0; v < 256; v++) {
+    lut[v] = round_uint8(v * brightness);
+  }
+  if (contrast == 1) {
+    return;
+  }
+  double sum = 0;
+  if (c >= 3) {
+    for (int64_t i = 0; i < n; i++) {
+      auto p = src + i * c;
+      uint8_t rgb[3] = {lut[p[0]], lut[p[1]], lut[p[2]]};
+      sum += luma(rgb);
+    }
+  } else {
+    for (int64_t i = 0; i < n; i++) {
+      sum += lut[src[i * c]];
+    }
+  }
+  float mean = sum / n;
+  for (int v = 0; v < 256; v++) {
+    lut[v] = round_uint8(contrast * lut[v] + (1 - contrast) * mean);
+  }
+}
+
+// Saturation and hue act on the chroma in the YIQ space: it is scaled by
+// saturation and rotated by hue, which is a single linear map of RGB (a close
+// and much cheaper approximation of a hue rotation in HSV).
+void saturation_hue_matrix(float saturation, float hue, int32_t mx[9]) {
+  const double rgb_to_yiq[9] = {
+      0.299, 0.587, 0.114, 0.596, -0.274, -0.322, 0.211, -0.523, 0.312};
+  const double yiq_to_rgb[9] = {
+      1.0, 0.956, 0.621, 1.0, -0.272, -0.647, 1.0, -1.106, 1.703};
+  const double pi = std::atan(1.0) * 4;
+  double c = saturation * std::cos(2 * pi * hue);
+  double s = saturation * std::sin(2 * pi * hue);
+  const double chroma[9] = {1, 0, 0, 0, c, s, 0, -s, c};
+
+  double tmp[9];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      tmp[i * 3 + j] = 0;
+      for (int k = 0; k < 3; k++) {
+        tmp[i * 3 + j] += chroma[i * 3 + k] * rgb_to_yiq[k * 3 + j];
+      }
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      double v = 0;
+      for (int k = 0; k < 3; k++) {
+        v += yiq_to_rgb[i * 3 + k] * tmp[k * 3 + j];
+      }
+      mx[i * 3 + j] = std::lround(v * (1 << kMatrixBits));
+    }
+  }
+}
+
+template <int C>
+void color_jitter_pixels(
+    const uint8_t* src,
+    uint8_t* dst,
+    int64_t n,
+    const uint8_t lut[256],
+    const int32_t* mx) {
+  constexpr int num_colors = (C >= 3 ? 3 : 1);
+  if constexpr (C >= 3) {
+    if (mx) {
+      for (int64_t i = 0; i < n; i++) {
+        auto s = src + i * C;
+        auto d = dst + i * C;
+        int32_t r = lut[s[0]];
+        int32_t g = lut[s[1]];
+        int32_t b = lut[s[2]];
+        d[0] = mix(mx, r, g, b);
+        d[1] = mix(mx + 3, r, g, b);
+        d[2] = mix(mx + 6, r, g, b);
+        if constexpr (C == 4) {
+          d[3] = s[3];
+        }
+      }
+      return;
+    }
+  }
+  for (int64_t i = 0; i < n; i++) {
+    auto s = src + i * C;
+    auto d = dst + i * C;
+    for (int k = 0; k < num_colors; k++) {
+      d[k] = lut[s[k]];
+    }
+    for (int k = num_colors; k < C; k++) {
+      d[k] = s[k];
+    }
+  }
+}
+
+// Reflects i into [0, n) without repeating the border pixel.
+inline int64_t reflect(int64_t i, int64_t n) {
+  if (n == 1) {
+    return 0;
+  }
+  int64_t period = 2 * (n - 1);
+  i = i % period;
+  if (i < 0) {
+    i += period;
+  }
+  return i < n ? i : period - i;
+}
+
+} // namespace
+
+std::shared_ptr<Array> color_jitter(
+    const std::shared_ptr<const Array>& image,
+    float brightness,
+    float contrast,
+    float saturation,
+    float hue,
+    std::shared_ptr<Array> destination) {
+  verify_uint8_image(image, "color_jitter");
+  if (brightness < 0 || contrast < 0 || saturation < 0) {
+    throw std::runtime_error(
+        "image::color_jitter: brightness, contrast and saturation must be "
+        "non negative");
+  }
+  int64_t w = width(image);
+  int64_t h = height(image);
+  int64_t c = channels(image);
+  auto result = make_result(destination, UInt8, {h, w, c}, "color_jitter");
+  auto src = static_cast<const uint8_t*>(image->data());
+  auto dst = static_cast<uint8_t*>(result->data());
+
+  uint8_t lut[256];
+  brightness_contrast_lut(src, w * h, c, brightness, contrast, lut);
+  int32_t mx[9];
+  bool has_matrix = (c >= 3 && (saturation != 1 || hue != 0));
+  if (has_matrix) {
+    saturation_hue_matrix(saturation, hue, mx);
+  }
+  auto matrix = (has_matrix ? mx : nullptr);
+  switch (c) {
+    case 1:
+      color_jitter_pixels<1>(src, dst, w * h, lut, matrix);
+      break;
+    case 2:
+      color_jitter_pixels<2>(src, dst, w * h, lut, matrix);
+      break;
+    case 3:
+      color_jitter_pixels<3>(src, dst, w * h, lut, matrix);
+      break;
+    default:
+      color_jitter_pixels<4>(src, dst, w * h, lut, matrix);
+      break;
+  }
+  return result;
+}
+
+std::shared_ptr<Array> grayscale(
+    const std::shared_ptr<const Array>& image,
+    std::shared_ptr<Array> destination) {
+  verify_uint8_image(image, "grayscale");
+  int64_t w = width(image);
+  int64_t h = height(image);
+  int64_t c = channels(image);
+  auto result = make_result(destination, UInt8, {h, w, c}, "grayscale");
+  auto src = static_cast<const uint8_t*>(image->data());
+  auto dst = static_cast<uint8_t*>(result->data());
+  if (c < 3) {
+    std::memcpy(dst, src, w * h * c);
+    return result;
+  }
+  for (int64_t i = 0; i < w * h; i++) {
+    auto s = src + i * c;
+    auto d = dst + i * c;
+    uint8_t y = luma(s);
+    d[0] = y;
+    d[1] = y;
+    d[2] = y;
+    if (c == 4) {
+      d[3] = s[3];
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<Array> gaussian_blur(
+    const std::shared_ptr<const Array>& image,
+    float sigma,
+    int kernel_size,
+    std::shared_ptr<Array> destination) {
+  verify_uint8_image(image, "gaussian_blur");
+  if (sigma <= 0) {
+    throw std::runtime_error("image::gaussian_blur: sigma must be positive");
+  }
+  if (kernel_size == 0) {
+    kernel_size = 2 * static_cast<int>(std::ceil(3 * sigma)) + 1;
+  }
+  if (kernel_size < 0 || kernel_size % 2 == 0) {
+    throw std::runtime_error(
+        "image::gaussian_blur: kernel size must be odd and positive");
+  }
+  int64_t w = width(image);
+  int64_t h = height(image);
+  int64_t c = channels(image);
+  auto result = make_result(destination, UInt8, {h, w, c}, "gaussian_blur");
+  auto src = static_cast<const uint8_t*>(image->data());
+  auto dst = static_cast<uint8_t*>(result->data());
+
+  int r = kernel_size / 2;
+  std::vector<float> weights(kernel_size);
+  float total = 0;
+  for (int t = 0; t < kernel_size; t++) {
+    float x = t - r;
+    weights[t] = std::exp(-x * x / (2 * sigma * sigma));
+    total += weights[t];
+  }
+  for (auto& wt : weights) {
+    wt /= total;
+  }
+
+  // horizontal pass, each row being padded with its reflection such that the
+  // inner loop has no bound checks
+  const int64_t row_size = w * c;
+  std::vector<float> tmp(h * row_size);
+  std::vector<float> padded((w + 2 * r) * c);
+  for (int64_t y = 0; y < h; y++) {
+    auto row = src + y * row_size;
+    for (int64_t x = -r; x < w + r; x++) {
+      auto p = row + reflect(x, w) * c;
+      for (int64_t k = 0; k < c; k++) {
+        padded[(x + r) * c + k] = p[k];
+      }
+    }
+    auto out = tmp.data() + y * row_size;
+    std::fill(out, out + row_size, 0.0f);
+    for (int t = 0; t < kernel_size; t++) {
+      auto in = padded.data() + t * c;
+      float wt = weights[t];
+      for (int64_t i = 0; i < row_size; i++) {
+        out[i] += wt * in[i];
+      }
+    }
+  }
+
+  // vertical pass
+  std::vector<float> acc(row_size);
+  for (int64_t y = 0; y < h; y++) {
+    std::fill(acc.begin(), acc.end(), 0.0f);
+    for (int t = 0; t < kernel_size; t++) {
+      auto in = tmp.data() + reflect(y + t - r, h) * row_size;
+      float wt = weights[t];
+      for (int64_t i = 0; i < row_size; i++) {
+        acc[i] += wt * in[i];
+      }
+    }
+    auto out = dst + y * row_size;
+    for (int64_t i = 0; i < row_size; i++) {
+      out[i] = round_uint8(acc[i]);
+    }
+  }
+
+  // the alpha channel is not blurred
+  if (c == 2 || c == 4) {
+    for (int64_t i = 0; i < w * h; i++) {
+      dst[i * c + c - 1] = src[i * c + c - 1];
+    }
+  }
+  return result;
+}
+
+} // namespace image
+} // namespace core
+} // namespace data
+} // namespace mlx
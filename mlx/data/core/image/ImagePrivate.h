@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "mlx/data/core/image/Image.h"
 
 namespace mlx {
@@ -17,13 +19,50 @@ std::shared_ptr<Array> load_stbi(const std::shared_ptr<const Array> contents);
 ImageInfo info_stbi(const std::string& path);
 ImageInfo info_stbi(const std::shared_ptr<const Array> contents);
 
-std::shared_ptr<Array> load_jpeg(const std::string& path);
-std::shared_ptr<Array> load_jpeg(const std::shared_ptr<const Array> contents);
+/// Parse only the header of JPEG, PNG, WebP and GIF images. Returns an empty
+/// ImageInfo for other formats.
+ImageInfo info_header(const std::string& path);
+ImageInfo info_header(const std::shared_ptr<const Array> contents);
+
+/// Native decoders, returning nullptr if the data is not in their format (or
+/// if the library is not available).
+std::shared_ptr<Array> load_png(const std::string& path);
+std::shared_ptr<Array> load_png(const std::shared_ptr<const Array> contents);
+std::shared_ptr<Array> load_webp(const std::string& path);
+std::shared_ptr<Array> load_webp(const std::shared_ptr<const Array> contents);
+
+/// Target (width, height) of a region of the given size.
+typedef std::function<std::pair<int64_t, int64_t>(int64_t w, int64_t h)>
+    SizeFunction;
+
+/// Load the region of the image (the whole image if region is empty),
+/// resized to size (if not empty).
+std::shared_ptr<Array> load_jpeg(
+    const std::string& path,
+    const RegionFunction& region = nullptr,
+    const SizeFunction& size = nullptr);
+std::shared_ptr<Array> load_jpeg(
+    const std::shared_ptr<const Array> contents,
+    const RegionFunction& region = nullptr,
+    const SizeFunction& size = nullptr);
+
+/// Dimensions (width, height) of a w x h image resized such that its
+/// smallest side is size.
+std::pair<int64_t, int64_t>
+smallest_side_dimensions(int64_t w, int64_t h, int64_t size);
 
 bool save_jpeg(
     const std::shared_ptr<const Array> image,
     const std::string& path);
 
+/// Returns destination if it is not null (checking it has the given type and
+/// shape), otherwise allocates the result. fn names the caller in errors.
+std::shared_ptr<Array> make_result(
+    const std::shared_ptr<Array>& destination,
+    ArrayType type,
+    const std::vector<int64_t>& shape,
+    const std::string& fn);
+
 } // namespace image
 } // namespace core
 } // namespace data
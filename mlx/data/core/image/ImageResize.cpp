@@ -0,0 +1,313 @@
+// Copyright © 2023 Apple Inc.
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+#include "mlx/data/core/TaskGroup.h"
+#include "mlx/data/core/image/Image.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace image {
+
+namespace {
+
+// Number of (source, target, filter) coefficient sets kept in the cache
+// before it is flushed.
+constexpr size_t kMaxCachedCoefficients = 1024;
+
+// Source pixels and weights contributing to each target pixel along one
+// dimension.
+struct Coefficients {
+  int64_t taps;
+  std::vector<int64_t> start;
+  std::vector<int64_t> count;
+  std::vector<float> weights; // taps per target pixel
+};
+
+double filter_support(ResizeFilter filter) {
+  switch (filter) {
+    case ResizeFilter::Box:
+      return 0.5;
+    case ResizeFilter::Bilinear:
+      return 1.0;
+    case ResizeFilter::Bicubic:
+      return 2.0;
+    default:
+      return 3.0;
+  }
+}
+
+double sinc(double x) {
+  if (x == 0) {
+    return 1.0;
+  }
+  const double pi = std::atan(1.0) * 4;
+  x *= pi;
+  return std::sin(x) / x;
+}
+
+double filter_value(ResizeFilter filter, double x) {
+  switch (filter) {
+    case ResizeFilter::Box:
+      return (x > -0.5 && x <= 0.5) ? 1.0 : 0.0;
+    case ResizeFilter::Bilinear:
+      x = std::fabs(x);
+      return x < 1.0 ? 1.0 - x : 0.0;
+    case ResizeFilter::Bicubic: {
+      // Catmull-Rom (a = -0.5)
+      const double a = -0.5;
+      x = std::fabs(x);
+      if (x < 1.0) {
+        return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+      }
+      if (x < 2.0) {
+        return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+      }
+      return 0.0;
+    }
+    default:
+      // Lanczos with 3 lobes
+      return (x > -3.0 && x < 3.0) ? sinc(x) * sinc(x / 3.0) : 0.0;
+  }
+}
+
+std::shared_ptr<const Coefficients>
+compute_coefficients(int64_t src, int64_t dst, ResizeFilter filter) {
+  double scale = static_cast<double>(src) / dst;
+  double filter_scale = std::max(scale, 1.0);
+  double support = filter_support(filter) * filter_scale;
+
+  auto coefs = std::make_shared<Coefficients>();
+  coefs->taps = static_cast<int64_t>(std::ceil(support)) * 2 + 1;
+  coefs->start.resize(dst);
+  coefs->count.resize(dst);
+  coefs->weights.resize(dst * coefs->taps, 0);
+  for (int64_t i = 0; i < dst; i++) {
+    double center = (i + 0.5) * scale;
+    int64_t first = std::max<int64_t>(center - support + 0.5, 0);
+    int64_t last = std::min<int64_t>(center + support + 0.5, src);
+    int64_t count = std::min(last - first, coefs->taps);
+    auto weights = coefs->weights.data() + i * coefs->taps;
+    double total = 0;
+    for (int64_t t = 0; t < count; t++) {
+      double x = (first + t - center + 0.5) / filter_scale;
+      weights[t] = filter_value(filter, x);
+      total += weights[t];
+    }
+    if (total != 0) {
+      for (int64_t t = 0; t < count; t++) {
+        weights[t] /= total;
+      }
+    }
+    coefs->start[i] = first;
+    coefs->count[i] = count;
+  }
+  return coefs;
+}
+
+std::shared_ptr<const Coefficients>
+get_coefficients(int64_t src, int64_t dst, ResizeFilter filter) {
+  typedef std::tuple<int64_t, int64_t, ResizeFilter> Key;
+  static std::mutex mutex;
+  static std::map<Key, std::shared_ptr<const Coefficients>> cache;
+
+  Key key(src, dst, filter);
+  {
+    std::unique_lock lock(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+  }
+  auto coefs = compute_coefficients(src, dst, filter);
+  std::unique_lock lock(mutex);
+  if (cache.size() >= kMaxCachedCoefficients) {
+    cache.clear();
+  }
+  cache.emplace(key, coefs);
+  return coefs;
+}
+
+uint8_t to_uint8(float v) {
+  return static_cast<uint8_t>(std::min(std::max(v, 0.0f), 255.0f) + 0.5f);
+}
+
+// Resizes the target rows [y0, y1): the source rows they need are first
+// resampled horizontally, then combined vertically.
+template <int C>
+void resize_rows(
+    const uint8_t* src,
+    int64_t w,
+    uint8_t* dst,
+    int64_t dw,
+    const Coefficients& cx,
+    const Coefficients& cy,
+    int64_t y0,
+    int64_t y1) {
+  int64_t sy0 = cy.start[y0];
+  int64_t sy1 = sy0;
+  for (int64_t y = y0; y < y1; y++) {
+    sy0 = std::min(sy0, cy.start[y]);
+    sy1 = std::max(sy1, cy.start[y] + cy.count[y]);
+  }
+  const int64_t row_size = dw * C;
+  std::vector<float> tmp((sy1 - sy0) * row_size);
+  for (int64_t sy = sy0; sy < sy1; sy++) {
+    auto row = src + sy * w * C;
+    auto out = tmp.data() + (sy - sy0) * row_size;
+    for (int64_t x = 0; x < dw; x++) {
+      auto weights = cx.weights.data() + x * cx.taps;
+      auto p = row + cx.start[x] * C;
+      float acc[C] = {};
+      for (int64_t t = 0; t < cx.count[x]; t++) {
+        for (int k = 0; k < C; k++) {
+          acc[k] += weights[t] * p[t * C + k];
+        }
+      }
+      for (int k = 0; k < C; k++) {
+        out[x * C + k] = acc[k];
+      }
+    }
+  }
+
+  std::vector<float> acc(row_size);
+  for (int64_t y = y0; y < y1; y++) {
+    auto weights = cy.weights.data() + y * cy.taps;
+    std::fill(acc.begin(), acc.end(), 0.0f);
+    for (int64_t t = 0; t < cy.count[y]; t++) {
+      auto row = tmp.data() + (cy.start[y] + t - sy0) * row_size;
+      float wt = weights[t];
+      for (int64_t i = 0; i < row_size; i++) {
+        acc[i] += wt * row[i];
+      }
+    }
+    auto out = dst + y * row_size;
+    for (int64_t i = 0; i < row_size; i++) {
+      out[i] = to_uint8(acc[i]);
+    }
+  }
+}
+
+void resize_rows(
+    const std::shared_ptr<const Array>& image,
+    uint8_t* dst,
+    int64_t dw,
+    const Coefficients& cx,
+    const Coefficients& cy,
+    int64_t y0,
+    int64_t y1) {
+  auto src = static_cast<const uint8_t*>(image->data());
+  int64_t w = width(image);
+  switch (channels(image)) {
+    case 1:
+      resize_rows<1>(src, w, dst, dw, cx, cy, y0, y1);
+      break;
+    case 2:
+      resize_rows<2>(src, w, dst, dw, cx, cy, y0, y1);
+      break;
+    case 3:
+      resize_rows<3>(src, w, dst, dw, cx, cy, y0, y1);
+      break;
+    default:
+      resize_rows<4>(src, w, dst, dw, cx, cy, y0, y1);
+      break;
+  }
+}
+
+} // namespace
+
+ResizeFilter resize_filter(const std::string& name) {
+  if (name == "box") {
+    return ResizeFilter::Box;
+  } else if (name == "bilinear") {
+    return ResizeFilter::Bilinear;
+  } else if (name == "bicubic") {
+    return ResizeFilter::Bicubic;
+  } else if (name == "lanczos") {
+    return ResizeFilter::Lanczos;
+  }
+  throw std::runtime_error(
+      "image::resize_filter: unknown filter '" + name +
+      "' (expected 'box', 'bilinear', 'bicubic' or 'lanczos')");
+}
+
+std::shared_ptr<Array> resize_batch(
+    const std::vector<std::shared_ptr<const Array>>& images,
+    int64_t dw,
+    int64_t dh,
+    ResizeFilter filter,
+    int num_threads) {
+  if (images.empty()) {
+    throw std::runtime_error("image::resize_batch: no image to resize");
+  }
+  if (dw <= 0 || dh <= 0) {
+    throw std::runtime_error(
+        "image::resize_batch: target size must be positive");
+  }
+  int64_t c = 0;
+  for (auto& image : images) {
+    verify_image(image);
+    if (image->type() != UInt8) {
+      throw std::runtime_error("image::resize_batch: images must be UInt8");
+    }
+    if (c && channels(image) != c) {
+      throw std::runtime_error(
+          "image::resize_batch: images have different numbers of channels");
+    }
+    c = channels(image);
+  }
+
+  int64_t batch_size = images.size();
+  auto result = std::make_shared<Array>(UInt8, batch_size, dh, dw, c);
+  auto dst = static_cast<uint8_t*>(result->data());
+  std::vector<std::shared_ptr<const Coefficients>> cx(batch_size);
+  std::vector<std::shared_ptr<const Coefficients>> cy(batch_size);
+  for (int64_t i = 0; i < batch_size; i++) {
+    cx[i] = get_coefficients(width(images[i]), dw, filter);
+    cy[i] = get_coefficients(height(images[i]), dh, filter);
+  }
+
+  if (num_threads <= 0) {
+    num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  if (num_threads == 1) {
+    for (int64_t i = 0; i < batch_size; i++) {
+      resize_rows(
+          images[i], dst + i * dh * dw * c, dw, *cx[i], *cy[i], 0, dh);
+    }
+    return result;
+  }
+
+  // a few bands of rows per thread to balance the load, not too thin such
+  // that the source rows shared by two bands are not resampled too often
+  int64_t num_bands = (4 * num_threads + batch_size - 1) / batch_size;
+  num_bands = std::max<int64_t>(1, std::min(num_bands, dh / 16));
+  TaskGroup pool(num_threads);
+  std::vector<std::future<void>> futures;
+  for (int64_t i = 0; i < batch_size; i++) {
+    for (int64_t b = 0; b < num_bands; b++) {
+      int64_t y0 = dh * b / num_bands;
+      int64_t y1 = dh * (b + 1) / num_bands;
+      futures.push_back(pool.enqueue([&, i, y0, y1]() {
+        resize_rows(
+            images[i], dst + i * dh * dw * c, dw, *cx[i], *cy[i], y0, y1);
+      }));
+    }
+  }
+  for (auto& future : futures) {
+    ThreadPool::get(future);
+  }
+  return result;
+}
+
+} // namespace image
+} // namespace core
+} // namespace data
+} // namespace mlx
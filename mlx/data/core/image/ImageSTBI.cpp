@@ -62,6 +62,10 @@ ImageInfo info_stbi(const std::string& path) {
   if (!stbi_info(path.c_str(), &w, &h, &c)) {
     return {};
   }
+  // clamp the number of channels to 3 -- no alpha
+  if (c == 4) {
+    c = 3;
+  }
   return {
       .width = w,
       .height = h,
@@ -1,8 +1,11 @@
 // Copyright © 2023 Apple Inc.
 
 #include "mlx/data/core/image/Image.h"
+#include "mlx/data/core/image/ImagePrivate.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #define STBIR_DEFAULT_FILTER_UPSAMPLE STBIR_FILTER_TRIANGLE
@@ -30,6 +33,21 @@ void verify_dimensions(int64_t w, int64_t h, int64_t c) {
   }
 }
 
+std::shared_ptr<Array> make_result(
+    const std::shared_ptr<Array>& destination,
+    ArrayType type,
+    const std::vector<int64_t>& shape,
+    const std::string& fn) {
+  if (!destination) {
+    return std::make_shared<Array>(type, shape);
+  }
+  if (destination->type() != type || destination->shape() != shape) {
+    throw std::runtime_error(
+        "image::" + fn + ": destination type or shape mismatch");
+  }
+  return destination;
+}
+
 std::shared_ptr<Array> scale(
     const std::shared_ptr<const Array>& image,
     double scale) {
@@ -38,14 +56,17 @@ std::shared_ptr<Array> scale(
   return resize(image, tw, th);
 }
 
-std::shared_ptr<Array>
-resize(const std::shared_ptr<const Array>& image, int64_t dw, int64_t dh) {
+std::shared_ptr<Array> resize(
+    const std::shared_ptr<const Array>& image,
+    int64_t dw,
+    int64_t dh,
+    std::shared_ptr<Array> destination) {
   int64_t w = width(image);
   int64_t h = height(image);
   int64_t c = channels(image);
   verify_dimensions(dw, dh, c);
   verify_type(image);
-  auto result = std::make_shared<Array>(UInt8, dh, dw, c);
+  auto result = make_result(destination, UInt8, {dh, dw, c}, "resize");
   if (!stbir_resize_uint8_linear(
           static_cast<unsigned char*>(image->data()),
           w,
@@ -66,67 +87,303 @@ std::shared_ptr<Array> crop(
     int64_t x,
     int64_t y,
     int64_t w,
-    int64_t h) {
+    int64_t h,
+    std::shared_ptr<Array> destination) {
   verify_dimensions(w, h, 3);
-  auto result = array::sub(image, {y, x, 0}, {h, w, -1});
+  if (!destination) {
+    return array::sub(image, {y, x, 0}, {h, w, -1});
+  }
+  if (x < 0 || y < 0 || x + w > width(image) || y + h > height(image)) {
+    throw std::runtime_error("image::crop: crop out of bound");
+  }
+  int64_t c = channels(image);
+  auto result = make_result(destination, image->type(), {h, w, c}, "crop");
+  int64_t row_size = w * c * image->itemsize();
+  int64_t src_stride = width(image) * c * image->itemsize();
+  auto src = static_cast<const char*>(image->data()) +
+      (y * width(image) + x) * c * image->itemsize();
+  auto dst = static_cast<char*>(result->data());
+  for (int64_t i = 0; i < h; i++) {
+    std::memcpy(dst + i * row_size, src + i * src_stride, row_size);
+  }
   return result;
 }
 
+namespace {
+
+// Source coordinates are walked in fixed point along each output row, with
+// kFracBits fractional bits.
+constexpr int kFracBits = 16;
+constexpr int64_t kOne = int64_t(1) << kFracBits;
+
+int64_t floor_div(int64_t a, int64_t b) {
+  int64_t q = a / b;
+  return (q * b != a && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+// Restricts [t0, t1) to the t such that lo <= floor((v + t * dv) / kOne) < hi,
+// such that the loops over the span need no bound checks.
+void clip_span(
+    int64_t v,
+    int64_t dv,
+    int64_t lo,
+    int64_t hi,
+    int64_t& t0,
+    int64_t& t1) {
+  int64_t a = lo * kOne - v; // t * dv >= a
+  int64_t b = hi * kOne - v; // t * dv < b
+  int64_t begin, end;
+  if (dv > 0) {
+    begin = -floor_div(-a, dv);
+    end = -floor_div(-b, dv);
+  } else if (dv < 0) {
+    begin = floor_div(b, dv) + 1;
+    end = floor_div(a, dv) + 1;
+  } else {
+    begin = (a <= 0 && b > 0) ? t0 : t1;
+    end = t1;
+  }
+  t0 = std::clamp(begin, t0, t1);
+  t1 = std::clamp(end, t0, t1);
+}
+
+// Rows are processed in chunks of kChunk pixels. The source coordinates of
+// a chunk are computed first in a loop without dependencies between pixels,
+// which the compiler vectorizes when it has 64 bits lanes (e.g. AVX2). The
+// pixels are then gathered one by one, there is no byte gather instruction.
+constexpr int64_t kChunk = 64;
+
+template <int C>
+void affine_row_nearest(
+    const uint8_t* src,
+    int64_t w,
+    int64_t h,
+    uint8_t* dst,
+    int64_t tw,
+    int64_t x,
+    int64_t y,
+    int64_t dx,
+    int64_t dy) {
+  int64_t t0 = 0, t1 = tw;
+  clip_span(x, dx, 0, w, t0, t1);
+  clip_span(y, dy, 0, h, t0, t1);
+  std::memset(dst, 0, C * t0);
+  int64_t offsets[kChunk];
+  for (int64_t t = t0; t < t1; t += kChunk) {
+    int64_t n = std::min(kChunk, t1 - t);
+    for (int64_t i = 0; i < n; i++) {
+      int64_t xi = x + (t + i) * dx;
+      int64_t yi = y + (t + i) * dy;
+      offsets[i] = ((yi >> kFracBits) * w + (xi >> kFracBits)) * C;
+    }
+    auto out = dst + t * C;
+    for (int64_t i = 0; i < n; i++) {
+      for (int k = 0; k < C; k++) {
+        out[i * C + k] = src[offsets[i] + k];
+      }
+    }
+  }
+  std::memset(dst + C * t1, 0, C * (tw - t1));
+}
+
+template <int C>
+void affine_row_bilinear(
+    const uint8_t* src,
+    int64_t w,
+    int64_t h,
+    uint8_t* dst,
+    int64_t tw,
+    int64_t x,
+    int64_t y,
+    int64_t dx,
+    int64_t dy) {
+  // [o0, o1) touches the image, [i0, i1) has all its neighbors inside it
+  int64_t o0 = 0, o1 = tw;
+  clip_span(x, dx, -1, w, o0, o1);
+  clip_span(y, dy, -1, h, o0, o1);
+  int64_t i0 = o0, i1 = o1;
+  clip_span(x, dx, 0, w - 1, i0, i1);
+  clip_span(y, dy, 0, h - 1, i0, i1);
+
+  // pixels outside of the image count as black
+  auto border = [&](int64_t t) {
+    int64_t xt = x + t * dx;
+    int64_t yt = y + t * dy;
+    int64_t x0 = xt >> kFracBits;
+    int64_t y0 = yt >> kFracBits;
+    int fx = (xt >> (kFracBits - 8)) & 255;
+    int fy = (yt >> (kFracBits - 8)) & 255;
+    int wx[2] = {256 - fx, fx};
+    int wy[2] = {256 - fy, fy};
+    int v[C] = {0};
+    for (int j = 0; j < 2; j++) {
+      for (int i = 0; i < 2; i++) {
+        if (x0 + i < 0 || x0 + i >= w || y0 + j < 0 || y0 + j >= h) {
+          continue;
+        }
+        auto p = src + ((y0 + j) * w + x0 + i) * C;
+        for (int k = 0; k < C; k++) {
+          v[k] += p[k] * wx[i] * wy[j];
+        }
+      }
+    }
+    for (int k = 0; k < C; k++) {
+      dst[t * C + k] = (v[k] + (1 << 15)) >> 16;
+    }
+  };
+
+  std::memset(dst, 0, C * o0);
+  for (int64_t t = o0; t < i0; t++) {
+    border(t);
+  }
+
+  // the 4 taps of each channel and their weights are gathered in planar
+  // buffers, such that the blending vectorizes on 16 bits lanes
+  int64_t offsets[kChunk];
+  uint16_t fx[kChunk];
+  uint16_t fy[kChunk];
+  uint8_t taps[4][kChunk * C];
+  uint16_t wx[kChunk * C];
+  uint16_t wy[kChunk * C];
+  for (int64_t t = i0; t < i1; t += kChunk) {
+    int64_t n = std::min(kChunk, i1 - t);
+    for (int64_t i = 0; i < n; i++) {
+      int64_t xi = x + (t + i) * dx;
+      int64_t yi = y + (t + i) * dy;
+      offsets[i] = ((yi >> kFracBits) * w + (xi >> kFracBits)) * C;
+      fx[i] = (xi >> (kFracBits - 8)) & 255;
+      fy[i] = (yi >> (kFracBits - 8)) & 255;
+    }
+    for (int64_t i = 0; i < n; i++) {
+      auto p0 = src + offsets[i];
+      auto p1 = p0 + w * C;
+      for (int k = 0; k < C; k++) {
+        taps[0][i * C + k] = p0[k];
+        taps[1][i * C + k] = p0[k + C];
+        taps[2][i * C + k] = p1[k];
+        taps[3][i * C + k] = p1[k + C];
+        wx[i * C + k] = fx[i];
+        wy[i * C + k] = fy[i];
+      }
+    }
+    // each pass is rounded back to 8 bits such that it fits in 16 bits lanes
+    auto out = dst + t * C;
+    for (int64_t j = 0; j < n * C; j++) {
+      uint16_t top =
+          (taps[0][j] * (256 - wx[j]) + taps[1][j] * wx[j] + 128) >> 8;
+      uint16_t bottom =
+          (taps[2][j] * (256 - wx[j]) + taps[3][j] * wx[j] + 128) >> 8;
+      out[j] = (top * (256 - wy[j]) + bottom * wy[j] + 128) >> 8;
+    }
+  }
+
+  for (int64_t t = i1; t < o1; t++) {
+    border(t);
+  }
+  std::memset(dst + C * o1, 0, C * (tw - o1));
+}
+
+template <int C>
+void affine_image(
+    const uint8_t* src,
+    int64_t w,
+    int64_t h,
+    uint8_t* dst,
+    int64_t tw,
+    int64_t th,
+    const float mx[6],
+    Interpolation interpolation) {
+  // the matrix maps the centers of the output pixels, relative to the center
+  // of the output, to the source pixels relative to the center of the image
+  const double twh = tw / 2.0 - 0.5;
+  const double thh = th / 2.0 - 0.5;
+  const double wh = w / 2.0 - 0.5;
+  const double hh = h / 2.0 - 0.5;
+  // nearest rounds the source coordinates, bilinear takes their floor and
+  // fractional part
+  const double offset = (interpolation == Interpolation::Nearest) ? 0.5 : 0;
+  const int64_t dx = std::llround(mx[0] * kOne);
+  const int64_t dy = std::llround(mx[3] * kOne);
+  for (int64_t ty = 0; ty < th; ty++) {
+    int64_t x = std::llround(
+        (mx[0] * -twh + mx[1] * (ty - thh) + mx[2] + wh + offset) * kOne);
+    int64_t y = std::llround(
+        (mx[3] * -twh + mx[4] * (ty - thh) + mx[5] + hh + offset) * kOne);
+    if (interpolation == Interpolation::Nearest) {
+      affine_row_nearest<C>(src, w, h, dst + ty * tw * C, tw, x, y, dx, dy);
+    } else {
+      affine_row_bilinear<C>(src, w, h, dst + ty * tw * C, tw, x, y, dx, dy);
+    }
+  }
+}
+
+} // namespace
+
 std::shared_ptr<Array> affine(
     const std::shared_ptr<const Array>& image,
     const float mx[6],
-    bool crop) {
+    bool crop,
+    Interpolation interpolation,
+    std::shared_ptr<Array> destination) {
   int64_t w = width(image);
   int64_t h = height(image);
   int64_t c = channels(image);
   int64_t tw = w;
   int64_t th = h;
   if (!crop) {
-    tw = w * fabs(mx[0]) + h * fabs(mx[1]);
-    th = h * fabs(mx[3]) + w * fabs(mx[4]);
+    // the bounding box of the image mapped by the inverse of mx
+    float det = mx[0] * mx[4] - mx[1] * mx[3];
+    if (det == 0) {
+      throw std::runtime_error("image::affine: singular matrix");
+    }
+    tw = (w * fabs(mx[4]) + h * fabs(mx[1])) / fabs(det);
+    th = (w * fabs(mx[3]) + h * fabs(mx[0])) / fabs(det);
   }
-  const float twh = tw / 2.0;
-  const float thh = th / 2.0;
-  const float wh = w / 2.0;
-  const float hh = h / 2.0;
   verify_dimensions(tw, th, c);
   verify_type(image);
-  auto result = std::make_shared<Array>(UInt8, th, tw, c);
-  auto src = (unsigned char*)image->data();
-  auto dst = (unsigned char*)result->data();
-  for (int64_t ty = 0; ty < th; ty++) {
-    for (int64_t tx = 0; tx < tw; tx++) {
-      int64_t x =
-          (int64_t)(mx[0] * (tx - twh) + mx[1] * (ty - thh) + mx[2] + 0.5 + wh);
-      int64_t y =
-          (int64_t)(mx[3] * (tx - twh) + mx[4] * (ty - thh) + mx[5] + 0.5 + hh);
-      if (x < 0 || y < 0 || x >= w || y >= h) {
-        memset(dst + ty * tw * c + tx * c, 0, c);
-      } else {
-        memcpy(dst + ty * tw * c + tx * c, src + y * w * c + x * c, c);
-      }
-    }
+  auto result = make_result(destination, UInt8, {th, tw, c}, "affine");
+  auto src = static_cast<const uint8_t*>(image->data());
+  auto dst = static_cast<uint8_t*>(result->data());
+  switch (c) {
+    case 1:
+      affine_image<1>(src, w, h, dst, tw, th, mx, interpolation);
+      break;
+    case 2:
+      affine_image<2>(src, w, h, dst, tw, th, mx, interpolation);
+      break;
+    case 3:
+      affine_image<3>(src, w, h, dst, tw, th, mx, interpolation);
+      break;
+    default:
+      affine_image<4>(src, w, h, dst, tw, th, mx, interpolation);
+      break;
   }
   return result;
 }
 
-std::shared_ptr<Array>
-rotate(const std::shared_ptr<const Array>& image, double angle, bool crop) {
+std::shared_ptr<Array> rotate(
+    const std::shared_ptr<const Array>& image,
+    double angle,
+    bool crop,
+    Interpolation interpolation,
+    std::shared_ptr<Array> destination) {
   const float pi = std::atan(1.0) * 4;
   float rangle = angle * pi / 180.;
   float c = std::cos(rangle);
   float s = std::sin(rangle);
   float mx[6] = {c, s, 0, -s, c, 0};
-  return affine(image, mx, crop);
+  return affine(image, mx, crop, interpolation, destination);
 }
 
-std::shared_ptr<Array> hflip(const std::shared_ptr<const Array>& image) {
+std::shared_ptr<Array> hflip(
+    const std::shared_ptr<const Array>& image,
+    std::shared_ptr<Array> destination) {
   int64_t w = width(image);
   int64_t h = height(image);
   int64_t c = channels(image);
   verify_dimensions(w, h, c);
   verify_type(image);
-  auto result = std::make_shared<Array>(UInt8, h, w, c);
+  auto result = make_result(destination, UInt8, {h, w, c}, "hflip");
   auto src = (unsigned char*)image->data();
   auto dst = (unsigned char*)result->data();
   for (int64_t y = 0; y < h; y++) {
@@ -181,6 +438,99 @@ std::shared_ptr<Array> channel_reduction(
   return result;
 }
 
+namespace {
+
+template <int C>
+void normalize_pixels(
+    const uint8_t* src,
+    float* dst,
+    int64_t n,
+    const float scale[C],
+    const float bias[C],
+    bool channels_first) {
+  if (channels_first) {
+    for (int k = 0; k < C; k++) {
+      auto plane = dst + k * n;
+      for (int64_t i = 0; i < n; i++) {
+        plane[i] = src[i * C + k] * scale[k] + bias[k];
+      }
+    }
+  } else {
+    for (int64_t i = 0; i < n; i++) {
+      for (int k = 0; k < C; k++) {
+        dst[i * C + k] = src[i * C + k] * scale[k] + bias[k];
+      }
+    }
+  }
+}
+
+} // namespace
+
+std::shared_ptr<Array> normalize(
+    const std::shared_ptr<const Array>& images,
+    const std::vector<float>& mean,
+    const std::vector<float>& stddev,
+    bool channels_first,
+    std::shared_ptr<Array> destination) {
+  verify_type(images);
+  auto shape = images->shape();
+  if (shape.size() != 3 && shape.size() != 4) {
+    throw std::runtime_error(
+        "image::normalize: expected an HWC image or a NHWC batch");
+  }
+  int64_t c = shape.back();
+  if (c < 1 || c > 4) {
+    throw std::runtime_error("image::normalize: channels must be 0 < c <= 4");
+  }
+  if ((mean.size() != 1 && mean.size() != c) ||
+      (stddev.size() != 1 && stddev.size() != c)) {
+    throw std::runtime_error(
+        "image::normalize: mean and stddev must have 1 or channels values");
+  }
+
+  // y = x * scale + bias
+  float scale[4];
+  float bias[4];
+  for (int64_t k = 0; k < c; k++) {
+    float m = mean[mean.size() == 1 ? 0 : k];
+    float s = stddev[stddev.size() == 1 ? 0 : k];
+    if (s == 0) {
+      throw std::runtime_error("image::normalize: stddev must be non zero");
+    }
+    scale[k] = 1 / (255 * s);
+    bias[k] = -m / s;
+  }
+
+  int64_t n = shape.size() == 4 ? shape[0] : 1;
+  int64_t h = shape[shape.size() - 3];
+  int64_t w = shape[shape.size() - 2];
+  if (channels_first) {
+    std::rotate(shape.end() - 3, shape.end() - 1, shape.end());
+  }
+  auto result = make_result(destination, Float, shape, "normalize");
+  auto src = static_cast<const uint8_t*>(images->data());
+  auto dst = result->data<float>();
+  for (int64_t i = 0; i < n; i++) {
+    auto s = src + i * h * w * c;
+    auto d = dst + i * h * w * c;
+    switch (c) {
+      case 1:
+        normalize_pixels<1>(s, d, h * w, scale, bias, channels_first);
+        break;
+      case 2:
+        normalize_pixels<2>(s, d, h * w, scale, bias, channels_first);
+        break;
+      case 3:
+        normalize_pixels<3>(s, d, h * w, scale, bias, channels_first);
+        break;
+      default:
+        normalize_pixels<4>(s, d, h * w, scale, bias, channels_first);
+        break;
+    }
+  }
+  return result;
+}
+
 } // namespace image
 } // namespace core
 } // namespace data
@@ -0,0 +1,101 @@
+// Copyright © 2023 Apple Inc.
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "mlx/data/core/image/ImagePrivate.h"
+
+#ifdef MLX_HAS_WEBP
+#include <webp/decode.h>
+#endif
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace image {
+
+#ifdef MLX_HAS_WEBP
+
+static bool verify_signature(const uint8_t* signature, int64_t signature_size) {
+  return (signature_size >= 12) && (std::memcmp(signature, "RIFF", 4) == 0) &&
+      (std::memcmp(signature + 8, "WEBP", 4) == 0);
+}
+
+static std::shared_ptr<Array> load_webp(const uint8_t* data, size_t size) {
+  int w, h;
+  if (!WebPGetInfo(data, size, &w, &h)) {
+    return nullptr;
+  }
+  auto result = std::make_shared<Array>(UInt8, h, w, 3);
+  if (!WebPDecodeRGBInto(
+          data,
+          size,
+          static_cast<uint8_t*>(result->data()),
+          result->size(),
+          3 * w)) {
+    return nullptr;
+  }
+  return result;
+}
+
+std::shared_ptr<Array> load_webp(const std::string& path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) {
+    throw std::runtime_error("load_webp: could not load <" + path + ">");
+  }
+  uint8_t signature[12];
+  f.read(reinterpret_cast<char*>(signature), 12);
+  if (!verify_signature(signature, f.gcount())) {
+    // not a webp
+    return nullptr;
+  }
+
+  // the decoder needs the whole file
+  f.seekg(0, std::ios::end);
+  std::vector<uint8_t> data(f.tellg());
+  f.seekg(0, std::ios::beg);
+  f.read(reinterpret_cast<char*>(data.data()), data.size());
+  if (!f) {
+    throw std::runtime_error("load_webp: could not read <" + path + ">");
+  }
+
+  auto result = load_webp(data.data(), data.size());
+  if (!result) {
+    throw std::runtime_error(
+        "load_webp: could not load <" + path + "> (invalid or animated)");
+  }
+  return result;
+}
+
+std::shared_ptr<Array> load_webp(const std::shared_ptr<const Array> contents) {
+  auto data = static_cast<const uint8_t*>(contents->data());
+  if (!verify_signature(data, contents->size())) {
+    // not a webp
+    return nullptr;
+  }
+
+  auto result = load_webp(data, contents->size());
+  if (!result) {
+    throw std::runtime_error(
+        "load_webp: could not load from memory (invalid or animated)");
+  }
+  return result;
+}
+
+#else
+
+std::shared_ptr<Array> load_webp(const std::string& path) {
+  return nullptr;
+}
+
+std::shared_ptr<Array> load_webp(const std::shared_ptr<const Array> contents) {
+  return nullptr;
+}
+
+#endif
+
+} // namespace image
+} // namespace core
+} // namespace data
+} // namespace mlx
@@ -13,6 +13,26 @@ struct membuf : std::streambuf {
     char* p(const_cast<char*>(base));
     this->setg(p, p, p + size);
   }
+
+ protected:
+  pos_type seekoff(
+      off_type off,
+      std::ios_base::seekdir dir,
+      std::ios_base::openmode which = std::ios_base::in) override {
+    off_type base = (dir == std::ios_base::beg) ? 0
+        : (dir == std::ios_base::cur)           ? gptr() - eback()
+                                                : egptr() - eback();
+    return seekpos(base + off, which);
+  }
+  pos_type seekpos(
+      pos_type pos,
+      std::ios_base::openmode which = std::ios_base::in) override {
+    if (pos < 0 || pos > egptr() - eback() || !(which & std::ios_base::in)) {
+      return pos_type(off_type(-1));
+    }
+    setg(eback(), eback() + pos, egptr());
+    return pos;
+  }
 };
 struct imemstream : virtual membuf, std::istream {
   imemstream(std::shared_ptr<const mlx::data::Array> array)
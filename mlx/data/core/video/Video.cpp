@@ -1,5 +1,7 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+
 #include "mlx/data/core/video/VideoPrivate.h"
 
 namespace mlx {
@@ -21,12 +23,9 @@ static std::shared_ptr<Array> load(VideoReader& reader) {
   for (int frame_number = 0; frame_number < video_info.frames; frame_number++) {
     auto frame = reader.read_frame(array::slice(result, frame_number));
 
-    if (result == nullptr) {
+    if (frame == nullptr) {
       // finished early -- metadata does not match actual
       // number of frames, make a new buffer to fit the data
-
-      auto new_shape = result->shape();
-      new_shape[0] = frame_number;
       auto new_frames = std::make_shared<Array>(
           ArrayType::UInt8,
           frame_number,
@@ -46,16 +45,83 @@ static std::shared_ptr<Array> load(VideoReader& reader) {
   return result;
 }
 
-std::shared_ptr<Array> load(const std::string& path) {
-  VideoReader reader = VideoReader(path);
+static std::shared_ptr<Array> load_frames(
+    VideoReader& reader,
+    const FrameFunction& frame_fn) {
+  VideoInfo video_info = reader.info();
+  auto frames = frame_fn(video_info);
+  if (frames.empty()) {
+    throw std::runtime_error("video::load_frames: no frame to load");
+  }
+  if (!std::is_sorted(frames.begin(), frames.end())) {
+    throw std::runtime_error(
+        "video::load_frames: frame indices must be non decreasing");
+  }
+
+  int64_t num_frames = frames.size();
+  auto result = std::make_shared<Array>(
+      ArrayType::UInt8,
+      num_frames,
+      video_info.height,
+      video_info.width,
+      3);
+
+  bool finished = false;
+  for (int64_t i = 0; i < num_frames; i++) {
+    auto destination = array::slice(result, i);
+    if (i > 0 && (finished || frames[i] == frames[i - 1])) {
+      array::copy(destination, array::slice(result, i - 1));
+      continue;
+    }
+    reader.seek(frames[i]);
+    if (reader.read_frame(destination) == nullptr) {
+      finished = true;
+      if (i > 0) {
+        array::copy(destination, array::slice(result, i - 1));
+        continue;
+      }
+      // the video is shorter than announced, use its last frame
+      reader.seek(0);
+      if (reader.read_frame(destination) == nullptr) {
+        return nullptr;
+      }
+      while (reader.read_frame(destination) != nullptr) {
+      }
+    }
+  }
+
+  return result;
+}
+std::shared_ptr<Array> load(
+    const std::string& path,
+    const VideoDecodeOptions& options) {
+  VideoReader reader = VideoReader(path, options);
   return load(reader);
 }
 
-std::shared_ptr<Array> load(const std::shared_ptr<const Array>& contents) {
-  VideoReader reader = VideoReader(contents);
+std::shared_ptr<Array> load(
+    const std::shared_ptr<const Array>& contents,
+    const VideoDecodeOptions& options) {
+  VideoReader reader = VideoReader(contents, options);
   return load(reader);
 }
 
+std::shared_ptr<Array> load_frames(
+    const std::string& path,
+    const FrameFunction& frames,
+    const VideoDecodeOptions& options) {
+  VideoReader reader = VideoReader(path, options);
+  return load_frames(reader, frames);
+}
+
+std::shared_ptr<Array> load_frames(
+    const std::shared_ptr<const Array>& contents,
+    const FrameFunction& frames,
+    const VideoDecodeOptions& options) {
+  VideoReader reader = VideoReader(contents, options);
+  return load_frames(reader, frames);
+}
+
 VideoInfo info(const std::string& path) {
   VideoReader reader = VideoReader(path);
   return reader.info();
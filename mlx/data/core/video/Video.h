@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "mlx/data/Array.h"
 
 namespace mlx {
@@ -16,10 +19,46 @@ struct VideoInfo {
   int height;
   int channels;
   int64_t frames;
+  double fps; // 0 if unknown
+};
+
+/// Decoding options
+struct VideoDecodeOptions {
+  /// number of decoding threads (frame and slice threading), 0 for one per
+  /// core
+  int num_threads = 1;
+
+  /// if positive, the frames are resized such that their smallest side is
+  /// that size, by the scaler and, when the codec supports it, by decoding
+  /// them at a reduced resolution
+  int64_t resize_smallest_side = 0;
 };
 
-std::shared_ptr<Array> load(const std::string& path);
-std::shared_ptr<Array> load(const std::shared_ptr<const Array>& contents);
+/// Returns the indices of the frames to load given the video metadata.
+typedef std::function<std::vector<int64_t>(const VideoInfo& info)>
+    FrameFunction;
+
+std::shared_ptr<Array> load(
+    const std::string& path,
+    const VideoDecodeOptions& options = {});
+std::shared_ptr<Array> load(
+    const std::shared_ptr<const Array>& contents,
+    const VideoDecodeOptions& options = {});
+
+/// Load the frames returned by frames(), which is called once the video
+/// metadata is known, in a (len(frames), h, w, 3) array. The indices must be
+/// non decreasing and the frames past the end of the video repeat its last
+/// frame. Only the selected frames are converted to RGB, and the reader seeks
+/// to the keyframe preceding a frame rather than decoding everything up to
+/// it when that is faster.
+std::shared_ptr<Array> load_frames(
+    const std::string& path,
+    const FrameFunction& frames,
+    const VideoDecodeOptions& options = {});
+std::shared_ptr<Array> load_frames(
+    const std::shared_ptr<const Array>& contents,
+    const FrameFunction& frames,
+    const VideoDecodeOptions& options = {});
 
 VideoInfo info(const std::string& path);
 VideoInfo info(const std::shared_ptr<const Array>& contents);
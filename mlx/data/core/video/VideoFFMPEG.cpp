@@ -1,8 +1,12 @@
 // Copyright © 2023 Apple Inc.
 
 #include "mlx/data/core/video/VideoPrivate.h"
+#include "mlx/data/core/image/ImagePrivate.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
+#include <tuple>
 
 #if MLX_HAS_FFMPEG
 
@@ -97,53 +101,72 @@ static AVHWDeviceType find_hwdevice_type() {
   return AV_HWDEVICE_TYPE_NONE;
 }
 
-/// Opaque state of the public `VideoReader`.
-class VideoReaderState {
- public:
-  VideoReaderState(const std::string& filename);
-  VideoReaderState(const std::shared_ptr<const Array>& contents);
-
-  ~VideoReaderState();
-
-  VideoInfo info();
-  std::shared_ptr<Array> read_frame(std::shared_ptr<Array> destination);
-
-  std::string filename_;
-
-  /// state for stream based readers.  This is referenced via an AVIOContext
-  /// and a callback (see `streamReadFunction()`).
-  std::shared_ptr<const Array> streamContents_;
-  size_t streamPosition_;
-  size_t streamLength_;
+/// the frame rate of the stream, 0/1 if unknown
+static AVRational frame_rate(AVStream* stream) {
+  if (stream->avg_frame_rate.num > 0 && stream->avg_frame_rate.den > 0) {
+    return stream->avg_frame_rate;
+  }
+  if (stream->r_frame_rate.num > 0 && stream->r_frame_rate.den > 0) {
+    return stream->r_frame_rate;
+  }
+  return {0, 1};
+}
 
-  /// represents the file
-  AVFormatContext* formatContext_;
+static int64_t start_time(AVStream* stream) {
+  return stream->start_time == AV_NOPTS_VALUE ? 0 : stream->start_time;
+}
 
-  /// represents the decoder
-  AVCodecContext* decoderContext_;
+/// timestamp of the given frame, requires a known frame rate
+static int64_t frame_timestamp(AVStream* stream, int64_t frame) {
+  return start_time(stream) +
+      av_rescale_q(frame, av_inv_q(frame_rate(stream)), stream->time_base);
+}
 
-  /// optional hardware context if we are able to use hardware acceleration
-  AVBufferRef* hardwareDeviceContext_;
+/// timestamp of the keyframe preceding the timestamp, AV_NOPTS_VALUE if the
+/// container has no index
+static int64_t keyframe_timestamp(AVStream* stream, int64_t timestamp) {
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+  int i = av_index_search_timestamp(stream, timestamp, AVSEEK_FLAG_BACKWARD);
+  if (i >= 0) {
+    auto entry = avformat_index_get_entry(stream, i);
+    if (entry) {
+      return entry->timestamp;
+    }
+  }
+#endif
+  return AV_NOPTS_VALUE;
+}
 
-  /// the stream we are reading (pointer to `formatContext_->streams[i]`)
-  AVStream* videoStream_;
+/// without an index, seek forward only when the frame is at least that many
+/// seconds ahead
+static constexpr double seek_min_seconds = 2.0;
 
-  void init(std::string filename);
-};
-
-/// RAII container for reading a single frame and managing the state associated
+/// RAII container for reading frames and managing the state associated
 /// with that
 class FrameReader {
  public:
   FrameReader();
   ~FrameReader();
 
+  FrameReader(const FrameReader&) = delete;
+  FrameReader& operator=(const FrameReader&) = delete;
+
+  /// read the next frame whose index is at least `first_index`
   std::shared_ptr<Array> read_frame(
-      std::string filename,
+      const std::string& filename,
       std::shared_ptr<Array> destination,
       AVFormatContext* format_context,
       AVCodecContext* decoder_context,
-      AVStream* stream);
+      AVStream* stream,
+      int64_t first_index);
+
+  /// forget the position after a seek
+  void reset();
+
+  /// index of the next frame, -1 if unknown (after a seek)
+  int64_t next_index() const {
+    return nextIndex_;
+  }
 
  private:
   /// the input packet (bytes from the input file)
@@ -155,21 +178,83 @@ class FrameReader {
   /// optional, the frame in main memory
   AVFrame* cpuFrame_;
 
-  /// context used to do format translation, e.g. YUV420 to RGB
+  /// context used to do format translation, e.g. YUV420 to RGB, and scaling.
+  /// It is rebuilt only when the input or output format changes.
   SwsContext* scalerContext_;
 
   enum State { FRAME_READER_READING, FRAME_READER_FLUSHING, FRAME_READER_EOF };
 
   State state_;
 
+  int64_t nextIndex_;
+
   std::shared_ptr<Array> decode_(
-      std::string filename,
+      const std::string& filename,
       std::shared_ptr<Array> destination,
-      AVCodecContext* decoder_context);
+      AVCodecContext* decoder_context,
+      AVStream* stream,
+      int64_t first_index);
+
+  std::shared_ptr<Array> convert_(
+      const std::string& filename,
+      std::shared_ptr<Array> destination);
+
+  int64_t frame_index_(AVStream* stream);
+};
+
+/// Opaque state of the public `VideoReader`.
+class VideoReaderState {
+ public:
+  VideoReaderState(
+      const std::string& filename,
+      const VideoDecodeOptions& options);
+  VideoReaderState(
+      const std::shared_ptr<const Array>& contents,
+      const VideoDecodeOptions& options);
+
+  ~VideoReaderState();
+
+  VideoInfo info();
+  std::shared_ptr<Array> read_frame(std::shared_ptr<Array> destination);
+  void seek(int64_t frame);
+
+  std::string filename_;
+
+  /// state for stream based readers.  This is referenced via an AVIOContext
+  /// and a callback (see `streamReadFunction()`).
+  std::shared_ptr<const Array> streamContents_;
+  size_t streamPosition_;
+  size_t streamLength_;
+
+  /// represents the file
+  AVFormatContext* formatContext_;
+
+  /// represents the decoder
+  AVCodecContext* decoderContext_;
+
+  /// optional hardware context if we are able to use hardware acceleration
+  AVBufferRef* hardwareDeviceContext_;
+
+  /// the stream we are reading (pointer to `formatContext_->streams[i]`)
+  AVStream* videoStream_;
+
+  /// decoding state kept from one frame to the next
+  FrameReader frameReader_;
+
+  /// frames before this index are skipped (see `seek()`)
+  int64_t firstIndex_;
+
+  /// size of the frames returned by `read_frame()`
+  int64_t outputWidth_;
+  int64_t outputHeight_;
+
+  void init(std::string filename, const VideoDecodeOptions& options);
 };
 
-VideoReaderState::VideoReaderState(const std::string& filename)
-    : filename_(filename) {
+VideoReaderState::VideoReaderState(
+    const std::string& filename,
+    const VideoDecodeOptions& options)
+    : filename_(filename), firstIndex_(std::numeric_limits<int64_t>::min()) {
   int ret;
 
   formatContext_ = nullptr;
@@ -178,7 +263,7 @@ VideoReaderState::VideoReaderState(const std::string& filename)
   ret = avformat_open_input(&formatContext_, filename.c_str(), NULL, NULL);
   check_av_error("opening file", filename, ret);
 
-  init(filename);
+  init(filename, options);
 }
 
 /// callback from AVIOContext
@@ -198,7 +283,7 @@ static int stream_read_function(void* opaque, uint8_t* buf, int buf_size) {
   memcpy(buf, src, read_size);
 
   state.streamPosition_ += read_size;
-  return (int)read_size;
+  return read_size > 0 ? (int)read_size : AVERROR_EOF;
 }
 
 /// callback from AVIOContext
@@ -225,7 +310,10 @@ static int64_t stream_seek_function(void* opaque, int64_t offset, int whence) {
 }
 
 VideoReaderState::VideoReaderState(
-    const std::shared_ptr<const Array>& contents) {
+    const std::shared_ptr<const Array>& contents,
+    const VideoDecodeOptions& options)
+    : filename_("<stream>"),
+      firstIndex_(std::numeric_limits<int64_t>::min()) {
   int ret;
 
   // set up the stream state
@@ -255,12 +343,14 @@ VideoReaderState::VideoReaderState(
   ret = avformat_open_input(&formatContext_, "<stream>", nullptr, nullptr);
   check_av_error("opening file", "<stream>", ret);
 
-  init("<stream>");
+  init("<stream>", options);
 }
 
 /// finish initializing the `VideoReaderState`.  Requires that the
 /// `formatContext_` be set.
-void VideoReaderState::init(std::string filename) {
+void VideoReaderState::init(
+    std::string filename,
+    const VideoDecodeOptions& options) {
   int ret;
 
 #if LIBAVFORMAT_VERSION_MAJOR <= 58
@@ -318,6 +408,34 @@ void VideoReaderState::init(std::string filename) {
   ret = avcodec_parameters_to_context(decoderContext_, videoStream_->codecpar);
   check_av_error("avcodec_parameters_to_context", filename, ret);
 
+  // frame and slice threading, the decoder then returns frames with a delay
+  // of num_threads frames
+  if (options.num_threads < 0) {
+    throw std::runtime_error(
+        "VideoReader error: negative number of threads <" + filename + ">");
+  }
+  decoderContext_->thread_count = options.num_threads;
+  decoderContext_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+  outputWidth_ = decoderContext_->width;
+  outputHeight_ = decoderContext_->height;
+  if (options.resize_smallest_side > 0) {
+    int64_t size = options.resize_smallest_side;
+    std::tie(outputWidth_, outputHeight_) =
+        image::smallest_side_dimensions(outputWidth_, outputHeight_, size);
+
+    // decode at 1/2, 1/4 or 1/8 of the resolution if the codec supports it,
+    // as long as the frames stay larger than the target size
+    int64_t smallest_side =
+        std::min(decoderContext_->width, decoderContext_->height);
+    int lowres = 0;
+    while (lowres < decoder->max_lowres &&
+           (smallest_side >> (lowres + 1)) >= size) {
+      lowres++;
+    }
+    decoderContext_->lowres = lowres;
+  }
+
   ret = avcodec_open2(decoderContext_, decoder, NULL);
   check_av_error("avcodec_open2", filename, ret);
 }
@@ -343,18 +461,87 @@ VideoReaderState::~VideoReaderState() {
 }
 
 VideoInfo VideoReaderState::info() {
+  auto rate = frame_rate(videoStream_);
+  int64_t frames = videoStream_->nb_frames;
+  if (frames <= 0 && rate.num > 0) {
+    // not in the container, estimate it from the duration
+    if (videoStream_->duration != AV_NOPTS_VALUE) {
+      frames = av_rescale_q(
+          videoStream_->duration, videoStream_->time_base, av_inv_q(rate));
+    } else if (formatContext_->duration != AV_NOPTS_VALUE) {
+      frames = av_rescale_q(
+          formatContext_->duration, AV_TIME_BASE_Q, av_inv_q(rate));
+    }
+  }
   return {
-      decoderContext_->width,
-      decoderContext_->height,
+      static_cast<int>(outputWidth_),
+      static_cast<int>(outputHeight_),
       3,
-      videoStream_->nb_frames};
+      frames,
+      rate.num > 0 ? av_q2d(rate) : 0};
 }
 
 std::shared_ptr<Array> VideoReaderState::read_frame(
     std::shared_ptr<Array> destination) {
-  FrameReader reader;
-  return reader.read_frame(
-      filename_, destination, formatContext_, decoderContext_, videoStream_);
+  if (destination == nullptr) {
+    destination = std::make_shared<Array>(
+        ArrayType::UInt8, outputHeight_, outputWidth_, 3);
+  }
+  auto result = frameReader_.read_frame(
+      filename_,
+      destination,
+      formatContext_,
+      decoderContext_,
+      videoStream_,
+      firstIndex_);
+  firstIndex_ = std::numeric_limits<int64_t>::min();
+  return result;
+}
+
+void VideoReaderState::seek(int64_t frame) {
+  firstIndex_ = frame;
+
+  int64_t next = frameReader_.next_index();
+  bool backward = next < 0 || frame < next;
+  auto rate = frame_rate(videoStream_);
+  if (rate.num == 0) {
+    // no way to find the timestamp of the frame, decode up to it from the
+    // current position or from the start where the frames are counted from
+    if (!backward) {
+      return;
+    }
+    int ret = av_seek_frame(
+        formatContext_,
+        videoStream_->index,
+        start_time(videoStream_),
+        AVSEEK_FLAG_BACKWARD);
+    check_av_error("av_seek_frame", filename_, ret);
+    avcodec_flush_buffers(decoderContext_);
+    frameReader_.reset();
+    return;
+  }
+
+  int64_t timestamp = frame_timestamp(videoStream_, frame);
+  if (!backward) {
+    int64_t keyframe = keyframe_timestamp(videoStream_, timestamp);
+    bool skip = keyframe != AV_NOPTS_VALUE
+        ? keyframe > frame_timestamp(videoStream_, next)
+        : frame - next > av_q2d(rate) * seek_min_seconds;
+    if (!skip) {
+      // decoding the frames in between is cheaper
+      return;
+    }
+  }
+
+  int ret = av_seek_frame(
+      formatContext_, videoStream_->index, timestamp, AVSEEK_FLAG_BACKWARD);
+  if (ret < 0 && !backward) {
+    // not seekable, decode up to the frame
+    return;
+  }
+  check_av_error("av_seek_frame", filename_, ret);
+  avcodec_flush_buffers(decoderContext_);
+  frameReader_.reset();
 }
 
 FrameReader::FrameReader() {
@@ -363,6 +550,7 @@ FrameReader::FrameReader() {
   packet_ = av_packet_alloc();
   cpuFrame_ = nullptr;
   scalerContext_ = nullptr;
+  nextIndex_ = 0;
 }
 
 FrameReader::~FrameReader() {
@@ -372,12 +560,18 @@ FrameReader::~FrameReader() {
   sws_freeContext(scalerContext_);
 }
 
+void FrameReader::reset() {
+  state_ = FRAME_READER_READING;
+  nextIndex_ = -1;
+}
+
 std::shared_ptr<Array> FrameReader::read_frame(
-    std::string filename,
+    const std::string& filename,
     std::shared_ptr<Array> destination,
     AVFormatContext* format_context,
     AVCodecContext* decoder_context,
-    AVStream* stream) {
+    AVStream* stream,
+    int64_t first_index) {
   // read packets until we hit the end of file or read a frame for our stream
 
   if (state_ == FRAME_READER_EOF) {
@@ -385,12 +579,14 @@ std::shared_ptr<Array> FrameReader::read_frame(
   }
 
   // see if there is anything left in the codec and return it
-  auto result = decode_(filename, destination, decoder_context);
+  auto result =
+      decode_(filename, destination, decoder_context, stream, first_index);
   if (result != nullptr) {
     return result;
   } else if (state_ == FRAME_READER_FLUSHING) {
     // we were flushing the remaining frames out and ran empty
     state_ = FRAME_READER_EOF;
+    return nullptr;
   }
 
   // read packets from the input until 1) we get a packet for our target
@@ -410,7 +606,8 @@ std::shared_ptr<Array> FrameReader::read_frame(
       ret = avcodec_send_packet(decoder_context, nullptr);
       check_av_error("avcodec_send_packet (eof)", filename, ret);
 
-      auto result = decode_(filename, destination, decoder_context);
+      auto result =
+          decode_(filename, destination, decoder_context, stream, first_index);
 
       if (result == nullptr) {
         state_ = FRAME_READER_EOF;
@@ -428,7 +625,8 @@ std::shared_ptr<Array> FrameReader::read_frame(
 
       av_packet_unref(packet_);
 
-      auto result = decode_(filename, destination, decoder_context);
+      auto result =
+          decode_(filename, destination, decoder_context, stream, first_index);
       if (result != nullptr) {
         return result;
       }
@@ -438,54 +636,105 @@ std::shared_ptr<Array> FrameReader::read_frame(
   }
 }
 
+int64_t FrameReader::frame_index_(AVStream* stream) {
+  auto rate = frame_rate(stream);
+  int64_t timestamp = frame_->best_effort_timestamp;
+  int64_t index;
+  if (timestamp != AV_NOPTS_VALUE && rate.num > 0) {
+    index = av_rescale_q(
+        timestamp - start_time(stream), stream->time_base, av_inv_q(rate));
+  } else {
+    index = std::max<int64_t>(nextIndex_, 0);
+  }
+  nextIndex_ = index + 1;
+  return index;
+}
+
 std::shared_ptr<Array> FrameReader::decode_(
-    std::string filename,
+    const std::string& filename,
     std::shared_ptr<Array> destination,
-    AVCodecContext* decoder_context) {
-  int ret;
+    AVCodecContext* decoder_context,
+    AVStream* stream,
+    int64_t first_index) {
+  while (true) {
+    int ret = avcodec_receive_frame(decoder_context, frame_);
+    if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
+      return nullptr;
+    }
+    check_av_error("avcodec_receive_frame", filename, ret);
 
-  ret = avcodec_receive_frame(decoder_context, frame_);
-  if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
-    return nullptr;
+    // frames before the requested one are not converted
+    if (frame_index_(stream) >= first_index) {
+      return convert_(filename, destination);
+    }
   }
-  check_av_error("avcodec_receive_frame", filename, ret);
+}
+
+std::shared_ptr<Array> FrameReader::convert_(
+    const std::string& filename,
+    std::shared_ptr<Array> destination) {
+  int ret;
 
   AVFrame* frame_to_process = frame_;
 
   // if the frame has a hardware context it needs to be transferred from the gpu
   if (frame_->hw_frames_ctx) {
-    cpuFrame_ = av_frame_alloc();
+    // the buffers of cpuFrame_ are reused as long as the size is the same
+    if (!cpuFrame_) {
+      cpuFrame_ = av_frame_alloc();
+    } else if (
+        cpuFrame_->width != frame_->width ||
+        cpuFrame_->height != frame_->height) {
+      av_frame_unref(cpuFrame_);
+    }
     frame_to_process = cpuFrame_;
 
     ret = av_hwframe_transfer_data(cpuFrame_, frame_, 0);
     check_av_error("av_hwframe_transfer_data", filename, ret);
   }
 
-  auto result = destination == nullptr ? std::make_shared<Array>(
-                                             ArrayType::UInt8,
-                                             frame_to_process->height,
-                                             frame_to_process->width,
-                                             3)
-                                       : destination;
-
-  // convert from the video fram format, e.g. a planar YUV, into RGB24.
-  scalerContext_ = sws_getContext(
+  int64_t width = frame_to_process->width;
+  int64_t height = frame_to_process->height;
+  int64_t channels = 3;
+  if (destination != nullptr) {
+    if (destination->type() != ArrayType::UInt8 ||
+        destination->ndim() != 3 ||
+        (destination->shape(2) != 1 && destination->shape(2) != 3)) {
+      throw std::runtime_error(
+          "VideoReader error: destination must be a (h, w, 1 or 3) uint8 "
+          "array");
+    }
+    height = destination->shape(0);
+    width = destination->shape(1);
+    channels = destination->shape(2);
+  }
+  auto result = destination == nullptr
+      ? std::make_shared<Array>(ArrayType::UInt8, height, width, channels)
+      : destination;
+
+  // convert from the video frame format, e.g. a planar YUV, into RGB24 (or
+  // gray) at the requested size. The context is only rebuilt when one of
+  // the formats changes.
+  bool downscale =
+      width < frame_to_process->width || height < frame_to_process->height;
+  scalerContext_ = sws_getCachedContext(
+      scalerContext_,
       frame_to_process->width,
       frame_to_process->height,
       (enum AVPixelFormat)frame_to_process->format,
-      frame_to_process->width,
-      frame_to_process->height,
-      AV_PIX_FMT_RGB24,
-      (int)SWS_FAST_BILINEAR,
+      width,
+      height,
+      channels == 1 ? AV_PIX_FMT_GRAY8 : AV_PIX_FMT_RGB24,
+      downscale ? SWS_AREA : SWS_FAST_BILINEAR,
       nullptr,
       nullptr,
       nullptr);
+  if (!scalerContext_) {
+    throw std::runtime_error(
+        "VideoReader error sws_getCachedContext <" + filename + ">");
+  }
 
-  int dest_strides[4];
-  ret = av_image_fill_linesizes(
-      dest_strides, AV_PIX_FMT_RGB24, frame_to_process->width);
-  check_av_error("av_image_fill_linesizes", filename, ret);
-
+  int dest_strides[4] = {static_cast<int>(width * channels), 0, 0, 0};
   uint8_t* dest_data[4] = {0};
   dest_data[0] = (uint8_t*)result->data();
 
@@ -502,12 +751,16 @@ std::shared_ptr<Array> FrameReader::decode_(
   return result;
 }
 
-VideoReader::VideoReader(const std::string& filename) {
-  state_ = new VideoReaderState(filename);
+VideoReader::VideoReader(
+    const std::string& filename,
+    const VideoDecodeOptions& options) {
+  state_ = new VideoReaderState(filename, options);
 }
 
-VideoReader::VideoReader(const std::shared_ptr<const Array>& stream) {
-  state_ = new VideoReaderState(stream);
+VideoReader::VideoReader(
+    const std::shared_ptr<const Array>& stream,
+    const VideoDecodeOptions& options) {
+  state_ = new VideoReaderState(stream, options);
 }
 
 VideoReader::~VideoReader() {
@@ -523,13 +776,21 @@ std::shared_ptr<Array> VideoReader::read_frame(
   return state_->read_frame(destination);
 }
 
+void VideoReader::seek(int64_t frame) {
+  state_->seek(frame);
+}
+
 #else // MLX_HAS_FFMPEG
 
-VideoReader::VideoReader(const std::string& filename) {
+VideoReader::VideoReader(
+    const std::string& filename,
+    const VideoDecodeOptions& options) {
   state_ = nullptr; // avoids unused warning
 }
 
-VideoReader::VideoReader(const std::shared_ptr<const Array>& stream) {
+VideoReader::VideoReader(
+    const std::shared_ptr<const Array>& stream,
+    const VideoDecodeOptions& options) {
   state_ = nullptr; // avoids unused warning
 }
 
@@ -546,6 +807,11 @@ std::shared_ptr<Array> VideoReader::read_frame(
       std::string("VideoReader error: ffmpg libraries not found"));
 }
 
+void VideoReader::seek(int64_t frame) {
+  throw std::runtime_error(
+      std::string("VideoReader error: ffmpg libraries not found"));
+}
+
 #endif
 
 } // namespace video
@@ -16,15 +16,30 @@ class VideoReaderState;
 
 class VideoReader {
  public:
-  VideoReader(const std::string& filename);
-  VideoReader(const std::shared_ptr<const Array>& contents);
+  VideoReader(
+      const std::string& filename,
+      const VideoDecodeOptions& options = {});
+  VideoReader(
+      const std::shared_ptr<const Array>& contents,
+      const VideoDecodeOptions& options = {});
 
   ~VideoReader();
 
   VideoInfo info();
+
+  /// Read the next frame, nullptr at the end of the video. It has the size
+  /// given by info() unless destination is provided, in which case the frame
+  /// is scaled to its (h, w) and converted to its number of channels (1 or 3)
+  /// while being written to it.
   std::shared_ptr<Array> read_frame(
       std::shared_ptr<Array> destination = nullptr);
 
+  /// Make the next read_frame() return the frame of the given index (or the
+  /// first one after it). The reader seeks to the keyframe preceding the
+  /// frame when it is after the current position, otherwise the frames in
+  /// between are decoded but not converted.
+  void seek(int64_t frame);
+
  private:
   VideoReaderState* state_;
 };
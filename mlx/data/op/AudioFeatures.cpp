@@ -0,0 +1,102 @@
+// Copyright © 2023 Apple Inc.
+
+#include <algorithm>
+
+#include "mlx/data/op/AudioFeatures.h"
+
+namespace mlx {
+namespace data {
+namespace op {
+
+AudioSTFT::AudioSTFT(
+    const std::string& ikey,
+    int64_t n_fft,
+    int64_t frame_length,
+    int64_t hop_length,
+    const std::string& window,
+    float pre_emphasis,
+    float power,
+    const std::string& okey)
+    : KeyTransformOp(ikey, okey),
+      nFFT_(n_fft),
+      frameLength_(frame_length > 0 ? frame_length : n_fft),
+      hopLength_(
+          hop_length > 0 ? hop_length
+                         : std::max<int64_t>(frameLength_ / 4, 1)),
+      window_(core::audio::window_type(window)),
+      preEmphasis_(pre_emphasis),
+      power_(power) {
+  if (n_fft < 2 || (n_fft & (n_fft - 1)) != 0) {
+    throw std::runtime_error("AudioSTFT: n_fft must be a power of 2");
+  }
+  if (frameLength_ > n_fft) {
+    throw std::runtime_error("AudioSTFT: frame length must be <= n_fft");
+  }
+  if (power <= 0) {
+    throw std::runtime_error("AudioSTFT: power must be positive");
+  }
+}
+
+std::shared_ptr<Array> AudioSTFT::apply_key(
+    const std::shared_ptr<const Array>& src) const {
+  return core::audio::stft(
+      src, nFFT_, frameLength_, hopLength_, window_, preEmphasis_, power_);
+}
+
+AudioMelFilterbank::AudioMelFilterbank(
+    const std::string& ikey,
+    int sample_rate,
+    int num_filters,
+    float low_freq,
+    float high_freq,
+    const std::string& scale,
+    float floor,
+    bool log,
+    const std::string& okey)
+    : KeyTransformOp(ikey, okey),
+      sampleRate_(sample_rate),
+      numFilters_(num_filters),
+      lowFreq_(low_freq),
+      highFreq_(high_freq),
+      scale_(core::audio::frequency_scale(scale)),
+      floor_(floor),
+      log_(log) {
+  if (sample_rate <= 0 || num_filters <= 0) {
+    throw std::runtime_error(
+        "AudioMelFilterbank: sample rate and number of filters must be "
+        "positive");
+  }
+}
+
+std::shared_ptr<Array> AudioMelFilterbank::apply_key(
+    const std::shared_ptr<const Array>& src) const {
+  return core::audio::mel_filterbank(
+      src,
+      sampleRate_,
+      numFilters_,
+      lowFreq_,
+      highFreq_,
+      scale_,
+      floor_,
+      log_);
+}
+
+AudioMFCC::AudioMFCC(
+    const std::string& ikey,
+    int num_coefficients,
+    const std::string& okey)
+    : KeyTransformOp(ikey, okey), numCoefficients_(num_coefficients) {
+  if (num_coefficients <= 0) {
+    throw std::runtime_error(
+        "AudioMFCC: number of coefficients must be positive");
+  }
+}
+
+std::shared_ptr<Array> AudioMFCC::apply_key(
+    const std::shared_ptr<const Array>& src) const {
+  return core::audio::mfcc(src, numCoefficients_);
+}
+
+} // namespace op
+} // namespace data
+} // namespace mlx
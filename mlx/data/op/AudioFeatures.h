@@ -0,0 +1,82 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include "mlx/data/core/audio/Audio.h"
+#include "mlx/data/op/KeyTransform.h"
+
+namespace mlx {
+namespace data {
+namespace op {
+
+/// Spectrogram of mono audio (see core::audio::stft()).
+class AudioSTFT : public KeyTransformOp {
+ public:
+  AudioSTFT(
+      const std::string& ikey,
+      int64_t n_fft = 512,
+      int64_t frame_length = 0, // n_fft if <= 0
+      int64_t hop_length = 0, // frame_length / 4 if <= 0
+      const std::string& window = "hann",
+      float pre_emphasis = 0,
+      float power = 1,
+      const std::string& okey = "");
+
+  virtual std::shared_ptr<Array> apply_key(
+      const std::shared_ptr<const Array>& src) const override;
+
+ private:
+  int64_t nFFT_;
+  int64_t frameLength_;
+  int64_t hopLength_;
+  core::audio::WindowType window_;
+  float preEmphasis_;
+  float power_;
+};
+
+/// Filterbank energies of a spectrogram (see core::audio::mel_filterbank()).
+class AudioMelFilterbank : public KeyTransformOp {
+ public:
+  AudioMelFilterbank(
+      const std::string& ikey,
+      int sample_rate,
+      int num_filters = 80,
+      float low_freq = 0,
+      float high_freq = 0, // sample_rate / 2 if <= 0
+      const std::string& scale = "mel",
+      float floor = 0,
+      bool log = true,
+      const std::string& okey = "");
+
+  virtual std::shared_ptr<Array> apply_key(
+      const std::shared_ptr<const Array>& src) const override;
+
+ private:
+  int sampleRate_;
+  int numFilters_;
+  float lowFreq_;
+  float highFreq_;
+  core::audio::FrequencyScale scale_;
+  float floor_;
+  bool log_;
+};
+
+/// Cepstral coefficients of log filterbank energies (see
+/// core::audio::mfcc()).
+class AudioMFCC : public KeyTransformOp {
+ public:
+  AudioMFCC(
+      const std::string& ikey,
+      int num_coefficients = 13,
+      const std::string& okey = "");
+
+  virtual std::shared_ptr<Array> apply_key(
+      const std::shared_ptr<const Array>& src) const override;
+
+ private:
+  int numCoefficients_;
+};
+
+} // namespace op
+} // namespace data
+} // namespace mlx
@@ -1,5 +1,7 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <random>
@@ -30,12 +32,54 @@ std::shared_ptr<Array> ImageTransformOp::apply_key(
   }
 }
 
+bool ImageTransformOp::output_shape(
+    const std::shared_ptr<const Array>& x,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  if (x->shape().size() != 3) {
+    return false;
+  }
+  core::image::verify_image(x);
+  return image_output_shape(x, type, shape);
+}
+
+void ImageTransformOp::apply_key_into(
+    const std::shared_ptr<const Array>& x,
+    const std::shared_ptr<Array>& destination) const {
+  apply_image_into(x, destination);
+}
+
+bool ImageTransformOp::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  return false;
+}
+
+void ImageTransformOp::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  KeyTransformOp::apply_key_into(image, destination);
+}
+
 std::shared_ptr<Array> ImageTransformOp::apply_video(
     const std::shared_ptr<const Array>& video) const {
   // default implementation of applyVideo just calls apply on each frame
 
   auto frame_count = core::video::frames(video);
 
+  // transforms which know their output shape write the frames in place
+  ArrayType type;
+  std::vector<int64_t> shape;
+  if (image_output_shape(array::slice(video, 0), type, shape)) {
+    shape.insert(shape.begin(), frame_count);
+    auto result = std::make_shared<Array>(type, shape);
+    for (int i = 0; i < frame_count; i++) {
+      apply_image_into(array::slice(video, i), array::slice(result, i));
+    }
+    return result;
+  }
+
   // transform the first frame to determine geometry for the result
   auto frame = apply_image(array::slice(video, 0));
 
@@ -105,6 +149,21 @@ std::shared_ptr<Array> ImageResize::apply_image(
   return core::image::resize(image, w_, h_);
 }
 
+bool ImageResize::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = UInt8;
+  shape = {h_, w_, core::image::channels(image)};
+  return true;
+}
+
+void ImageResize::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  core::image::resize(image, w_, h_, destination);
+}
+
 ImageCenterCrop::ImageCenterCrop(
     const std::string& ikey,
     int64_t w,
@@ -125,6 +184,29 @@ std::shared_ptr<Array> ImageCenterCrop::apply_image(
   return core::image::crop(image, x, y, w_, h_);
 }
 
+bool ImageCenterCrop::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = image->type();
+  shape = {h_, w_, core::image::channels(image)};
+  return true;
+}
+
+void ImageCenterCrop::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  const int64_t w = core::image::width(image);
+  const int64_t h = core::image::height(image);
+  if (h_ > h || w_ > w) {
+    throw std::runtime_error(
+        "ImageCenterCrop: target image size larger than input image");
+  }
+  int64_t x = (w - w_) / 2;
+  int64_t y = (h - h_) / 2;
+  core::image::crop(image, x, y, w_, h_, destination);
+}
+
 ImageRandomCrop::ImageRandomCrop(
     const std::string& ikey,
     int64_t w,
@@ -157,6 +239,24 @@ std::shared_ptr<Array> ImageRandomCrop::apply_image(
   return core::image::crop(image, p.tx, p.ty, p.tw, p.th);
 }
 
+bool ImageRandomCrop::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = image->type();
+  shape = {h_, w_, core::image::channels(image)};
+  return true;
+}
+
+void ImageRandomCrop::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  const int64_t w = core::image::width(image);
+  const int64_t h = core::image::height(image);
+  auto p = generate_random_crop_(w, h);
+  core::image::crop(image, p.tx, p.ty, p.tw, p.th, destination);
+}
+
 std::shared_ptr<Array> ImageRandomCrop::apply_video(
     const std::shared_ptr<const Array>& video) const {
   // apply a consistent crop to every frame
@@ -173,9 +273,13 @@ std::shared_ptr<Array> ImageRandomCrop::apply_video(
       std::make_shared<Array>(ArrayType::UInt8, frame_count, p.th, p.tw, c);
 
   for (int i = 0; i < frame_count; i++) {
-    auto frame =
-        core::image::crop(array::slice(video, i), p.tx, p.ty, p.tw, p.th);
-    array::copy(array::slice(result, i), frame);
+    core::image::crop(
+        array::slice(video, i),
+        p.tx,
+        p.ty,
+        p.tw,
+        p.th,
+        array::slice(result, i));
   }
 
   return result;
@@ -210,7 +314,7 @@ ImageRandomAreaCrop::ImageRandomAreaCrop(
   }
 }
 
-ImageRandomAreaCrop::Parameters ImageRandomAreaCrop::generate_random_crop_(
+ImageRandomAreaCrop::Parameters ImageRandomAreaCrop::generate_random_crop(
     int64_t w,
     int64_t h) const {
   const float wf = static_cast<float>(w);
@@ -283,7 +387,7 @@ std::shared_ptr<Array> ImageRandomAreaCrop::apply_image(
     const std::shared_ptr<const Array>& image) const {
   const int64_t w = core::image::width(image);
   const int64_t h = core::image::height(image);
-  auto p = generate_random_crop_(w, h);
+  auto p = generate_random_crop(w, h);
   if (p.tw == 0 || p.th == 0) {
     return std::make_shared<Array>(image);
   }
@@ -297,7 +401,7 @@ std::shared_ptr<Array> ImageRandomAreaCrop::apply_video(
   const int64_t h = core::video::height(video);
   const int64_t frame_count = core::video::frames(video);
   const int64_t c = core::video::channels(video);
-  auto p = generate_random_crop_(w, h);
+  auto p = generate_random_crop(w, h);
   if (p.tw == 0 || p.th == 0) {
     return std::make_shared<Array>(video);
   }
@@ -306,9 +410,13 @@ std::shared_ptr<Array> ImageRandomAreaCrop::apply_video(
       std::make_shared<Array>(ArrayType::UInt8, frame_count, p.th, p.tw, c);
 
   for (int i = 0; i < frame_count; i++) {
-    auto frame =
-        core::image::crop(array::slice(video, i), p.tx, p.ty, p.tw, p.th);
-    array::copy(array::slice(result, i), frame);
+    core::image::crop(
+        array::slice(video, i),
+        p.tx,
+        p.ty,
+        p.tw,
+        p.th,
+        array::slice(result, i));
   }
 
   return result;
@@ -331,6 +439,27 @@ std::shared_ptr<Array> ImageRandomHFlip::apply_image(
   return std::make_shared<Array>(image);
 }
 
+bool ImageRandomHFlip::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = image->type();
+  shape = image->shape();
+  return true;
+}
+
+void ImageRandomHFlip::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  std::uniform_real_distribution<float> uniform{0, 1.0};
+  auto state = core::get_state();
+  if (uniform(state->randomGenerator) <= prob_) {
+    core::image::hflip(image, destination);
+  } else {
+    array::copy(destination, image);
+  }
+}
+
 std::shared_ptr<Array> ImageRandomHFlip::apply_video(
     const std::shared_ptr<const Array>& video) const {
   // apply a consistent flip to every frame
@@ -346,8 +475,7 @@ std::shared_ptr<Array> ImageRandomHFlip::apply_video(
         std::make_shared<Array>(ArrayType::UInt8, frame_count, h, w, c);
 
     for (int i = 0; i < frame_count; i++) {
-      auto frame = core::image::hflip(array::slice(video, i));
-      array::copy(array::slice(result, i), frame);
+      core::image::hflip(array::slice(video, i), array::slice(result, i));
     }
 
     return result;
@@ -356,16 +484,209 @@ std::shared_ptr<Array> ImageRandomHFlip::apply_video(
   }
 }
 
+static core::image::Interpolation parse_interpolation(
+    const std::string& interpolation,
+    const std::string& op) {
+  if (interpolation == "nearest") {
+    return core::image::Interpolation::Nearest;
+  } else if (interpolation == "bilinear") {
+    return core::image::Interpolation::Bilinear;
+  }
+  throw std::runtime_error(
+      op + ": unknown interpolation '" + interpolation +
+      "' (expected 'nearest' or 'bilinear')");
+}
+
+/// Inverts the 2x3 affine matrix a into mx.
+static void
+invert_affine(const float a[6], float mx[6], const std::string& op) {
+  float det = a[0] * a[4] - a[1] * a[3];
+  if (det == 0) {
+    throw std::runtime_error(op + ": singular matrix");
+  }
+  mx[0] = a[4] / det;
+  mx[1] = -a[1] / det;
+  mx[3] = -a[3] / det;
+  mx[4] = a[0] / det;
+  mx[2] = -(mx[0] * a[2] + mx[1] * a[5]);
+  mx[5] = -(mx[3] * a[2] + mx[4] * a[5]);
+}
+
 ImageRotate::ImageRotate(
     const std::string& ikey,
     double angle,
     bool crop,
+    const std::string& interpolation,
     const std::string& okey)
-    : ImageTransformOp(ikey, okey), angle_(angle), crop_(crop) {};
+    : ImageTransformOp(ikey, okey),
+      angle_(angle),
+      crop_(crop),
+      interpolation_(parse_interpolation(interpolation, "ImageRotate")) {};
 
 std::shared_ptr<Array> ImageRotate::apply_image(
     const std::shared_ptr<const Array>& image) const {
-  return core::image::rotate(image, angle_, crop_);
+  return core::image::rotate(image, angle_, crop_, interpolation_);
+}
+
+bool ImageRotate::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  // the output is enlarged to fit the rotated image unless cropping
+  type = UInt8;
+  shape = image->shape();
+  return crop_;
+}
+
+void ImageRotate::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  core::image::rotate(image, angle_, crop_, interpolation_, destination);
+}
+
+ImageAffine::ImageAffine(
+    const std::string& ikey,
+    const std::vector<float>& matrix,
+    bool crop,
+    const std::string& interpolation,
+    const std::string& okey)
+    : ImageTransformOp(ikey, okey),
+      crop_(crop),
+      interpolation_(parse_interpolation(interpolation, "ImageAffine")) {
+  if (matrix.size() != 6) {
+    throw std::runtime_error(
+        "ImageAffine: the matrix must have 6 elements (2x3, row major)");
+  }
+  invert_affine(matrix.data(), mx_, "ImageAffine");
+}
+
+std::shared_ptr<Array> ImageAffine::apply_image(
+    const std::shared_ptr<const Array>& image) const {
+  return core::image::affine(image, mx_, crop_, interpolation_);
+}
+
+bool ImageAffine::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = UInt8;
+  shape = image->shape();
+  return crop_;
+}
+
+void ImageAffine::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  core::image::affine(image, mx_, crop_, interpolation_, destination);
+}
+
+ImageRandomAffine::ImageRandomAffine(
+    const std::string& ikey,
+    std::pair<float, float> rotation_range,
+    std::pair<float, float> scale_range,
+    std::pair<float, float> shear_range,
+    std::pair<float, float> translate_range,
+    bool crop,
+    const std::string& interpolation,
+    const std::string& okey)
+    : ImageTransformOp(ikey, okey),
+      rotationRange_(rotation_range),
+      scaleRange_(scale_range),
+      shearRange_(shear_range),
+      translateRange_(translate_range),
+      crop_(crop),
+      interpolation_(
+          parse_interpolation(interpolation, "ImageRandomAffine")) {
+  if (rotation_range.first > rotation_range.second ||
+      scale_range.first > scale_range.second ||
+      shear_range.first > shear_range.second ||
+      translate_range.first > translate_range.second) {
+    throw std::runtime_error(
+        "ImageRandomAffine: ranges must be given as (low, high)");
+  }
+  if (scale_range.first <= 0) {
+    throw std::runtime_error("ImageRandomAffine: scale must be positive");
+  }
+  if (shear_range.first <= -90 || shear_range.second >= 90) {
+    throw std::runtime_error(
+        "ImageRandomAffine: shear must be in (-90, 90) degrees");
+  }
+}
+
+void ImageRandomAffine::generate_random_matrix_(
+    int64_t w,
+    int64_t h,
+    float mx[6]) const {
+  auto state = core::get_state();
+  auto uniform = [&state](std::pair<float, float> range) {
+    std::uniform_real_distribution<float> dist{range.first, range.second};
+    return dist(state->randomGenerator);
+  };
+  const float pi = std::atan(1.0) * 4;
+  float angle = uniform(rotationRange_) * pi / 180;
+  float scale = uniform(scaleRange_);
+  float shear = std::tan(uniform(shearRange_) * pi / 180);
+  float tx = uniform(translateRange_) * w;
+  float ty = uniform(translateRange_) * h;
+
+  // rotation * shear * scale, rotating the same way as ImageRotate
+  float c = std::cos(angle) * scale;
+  float s = std::sin(angle) * scale;
+  float a[6] = {c, c * shear - s, tx, s, s * shear + c, ty};
+  invert_affine(a, mx, "ImageRandomAffine");
+}
+
+std::shared_ptr<Array> ImageRandomAffine::apply_image(
+    const std::shared_ptr<const Array>& image) const {
+  float mx[6];
+  generate_random_matrix_(
+      core::image::width(image), core::image::height(image), mx);
+  return core::image::affine(image, mx, crop_, interpolation_);
+}
+
+bool ImageRandomAffine::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = UInt8;
+  shape = image->shape();
+  return crop_;
+}
+
+void ImageRandomAffine::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  float mx[6];
+  generate_random_matrix_(
+      core::image::width(image), core::image::height(image), mx);
+  core::image::affine(image, mx, crop_, interpolation_, destination);
+}
+
+std::shared_ptr<Array> ImageRandomAffine::apply_video(
+    const std::shared_ptr<const Array>& video) const {
+  float mx[6];
+  generate_random_matrix_(
+      core::video::width(video), core::video::height(video), mx);
+
+  auto frame = core::image::affine(
+      array::slice(video, 0), mx, crop_, interpolation_);
+  auto result = std::make_shared<Array>(
+      ArrayType::UInt8,
+      core::video::frames(video),
+      core::image::height(frame),
+      core::image::width(frame),
+      core::image::channels(frame));
+  array::copy(array::slice(result, 0), frame);
+  for (int i = 1; i < core::video::frames(video); i++) {
+    core::image::affine(
+        array::slice(video, i),
+        mx,
+        crop_,
+        interpolation_,
+        array::slice(result, i));
+  }
+
+  return result;
 }
 
 struct ImageChannelReductionSettings {
@@ -420,6 +741,258 @@ std::shared_ptr<Array> ImageChannelReduction::apply_image(
   return core::image::channel_reduction(image, this->bias_, this->m_);
 }
 
+ImageNormalize::ImageNormalize(
+    const std::string& ikey,
+    const std::vector<float>& mean,
+    const std::vector<float>& stddev,
+    bool channels_first,
+    const std::string& okey)
+    : ImageTransformOp(ikey, okey),
+      mean_(mean),
+      stddev_(stddev),
+      channelsFirst_(channels_first) {
+  if (mean_.empty() || stddev_.empty()) {
+    throw std::runtime_error(
+        "ImageNormalize: mean and stddev cannot be empty");
+  }
+  for (auto s : stddev_) {
+    if (s == 0) {
+      throw std::runtime_error("ImageNormalize: stddev must be non zero");
+    }
+  }
+}
+
+std::shared_ptr<Array> ImageNormalize::apply_image(
+    const std::shared_ptr<const Array>& image) const {
+  return core::image::normalize(image, mean_, stddev_, channelsFirst_);
+}
+
+bool ImageNormalize::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = Float;
+  shape = image->shape();
+  if (channelsFirst_) {
+    std::rotate(shape.begin(), shape.end() - 1, shape.end());
+  }
+  return true;
+}
+
+void ImageNormalize::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  core::image::normalize(
+      image, mean_, stddev_, channelsFirst_, destination);
+}
+
+std::shared_ptr<Array> ImageNormalize::apply_video(
+    const std::shared_ptr<const Array>& video) const {
+  // the frames (or the images of a batch) are normalized in a single pass
+  return core::image::normalize(video, mean_, stddev_, channelsFirst_);
+}
+
+ImageRandomColorJitter::ImageRandomColorJitter(
+    const std::string& ikey,
+    float brightness,
+    float contrast,
+    float saturation,
+    float hue,
+    const std::string& okey)
+    : ImageTransformOp(ikey, okey),
+      brightness_(brightness),
+      contrast_(contrast),
+      saturation_(saturation),
+      hue_(hue) {
+  if (brightness < 0 || contrast < 0 || saturation < 0) {
+    throw std::runtime_error(
+        "ImageRandomColorJitter: brightness, contrast and saturation must be "
+        "non negative");
+  }
+  if (hue < 0 || hue > 0.5) {
+    throw std::runtime_error(
+        "ImageRandomColorJitter: hue must be in [0, 0.5]");
+  }
+}
+
+ImageRandomColorJitter::Parameters
+ImageRandomColorJitter::generate_random_parameters_() const {
+  auto state = core::get_state();
+  auto factor = [&state](float x) {
+    if (x == 0) {
+      return 1.0f;
+    }
+    std::uniform_real_distribution<float> uniform{
+        std::max(0.0f, 1 - x), 1 + x};
+    return uniform(state->randomGenerator);
+  };
+  Parameters p;
+  p.brightness = factor(brightness_);
+  p.contrast = factor(contrast_);
+  p.saturation = factor(saturation_);
+  p.hue = 0;
+  if (hue_ > 0) {
+    std::uniform_real_distribution<float> uniform{-hue_, hue_};
+    p.hue = uniform(state->randomGenerator);
+  }
+  return p;
+}
+
+std::shared_ptr<Array> ImageRandomColorJitter::apply_image(
+    const std::shared_ptr<const Array>& image) const {
+  auto p = generate_random_parameters_();
+  return core::image::color_jitter(
+      image, p.brightness, p.contrast, p.saturation, p.hue);
+}
+
+bool ImageRandomColorJitter::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = UInt8;
+  shape = image->shape();
+  return true;
+}
+
+void ImageRandomColorJitter::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  auto p = generate_random_parameters_();
+  core::image::color_jitter(
+      image, p.brightness, p.contrast, p.saturation, p.hue, destination);
+}
+
+std::shared_ptr<Array> ImageRandomColorJitter::apply_video(
+    const std::shared_ptr<const Array>& video) const {
+  // apply the same factors to every frame
+  auto p = generate_random_parameters_();
+  auto result = std::make_shared<Array>(UInt8, video->shape());
+  for (int i = 0; i < core::video::frames(video); i++) {
+    core::image::color_jitter(
+        array::slice(video, i),
+        p.brightness,
+        p.contrast,
+        p.saturation,
+        p.hue,
+        array::slice(result, i));
+  }
+  return result;
+}
+
+ImageRandomGrayscale::ImageRandomGrayscale(
+    const std::string& ikey,
+    float prob,
+    const std::string& okey)
+    : ImageTransformOp(ikey, okey), prob_(prob) {};
+
+std::shared_ptr<Array> ImageRandomGrayscale::apply_image(
+    const std::shared_ptr<const Array>& image) const {
+  std::uniform_real_distribution<float> uniform{0, 1.0};
+  auto state = core::get_state();
+  if (uniform(state->randomGenerator) <= prob_) {
+    return core::image::grayscale(image);
+  }
+  return std::make_shared<Array>(image);
+}
+
+bool ImageRandomGrayscale::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = UInt8;
+  shape = image->shape();
+  return true;
+}
+
+void ImageRandomGrayscale::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  std::uniform_real_distribution<float> uniform{0, 1.0};
+  auto state = core::get_state();
+  if (uniform(state->randomGenerator) <= prob_) {
+    core::image::grayscale(image, destination);
+  } else {
+    array::copy(destination, image);
+  }
+}
+
+std::shared_ptr<Array> ImageRandomGrayscale::apply_video(
+    const std::shared_ptr<const Array>& video) const {
+  // convert all the frames or none
+  std::uniform_real_distribution<float> uniform{0, 1.0};
+  auto state = core::get_state();
+  if (uniform(state->randomGenerator) > prob_) {
+    return std::make_shared<Array>(video);
+  }
+  auto result = std::make_shared<Array>(UInt8, video->shape());
+  for (int i = 0; i < core::video::frames(video); i++) {
+    core::image::grayscale(array::slice(video, i), array::slice(result, i));
+  }
+  return result;
+}
+
+ImageGaussianBlur::ImageGaussianBlur(
+    const std::string& ikey,
+    std::pair<float, float> sigma_range,
+    int kernel_size,
+    const std::string& okey)
+    : ImageTransformOp(ikey, okey),
+      sigmaRange_(sigma_range),
+      kernelSize_(kernel_size) {
+  if (sigma_range.first <= 0 || sigma_range.first > sigma_range.second) {
+    throw std::runtime_error("ImageGaussianBlur: invalid sigma range");
+  }
+  if (kernel_size < 0 || (kernel_size > 0 && kernel_size % 2 == 0)) {
+    throw std::runtime_error(
+        "ImageGaussianBlur: kernel size must be odd (or 0 to pick it from "
+        "sigma)");
+  }
+}
+
+float ImageGaussianBlur::generate_random_sigma_() const {
+  if (sigmaRange_.first == sigmaRange_.second) {
+    return sigmaRange_.first;
+  }
+  std::uniform_real_distribution<float> uniform{
+      sigmaRange_.first, sigmaRange_.second};
+  auto state = core::get_state();
+  return uniform(state->randomGenerator);
+}
+
+std::shared_ptr<Array> ImageGaussianBlur::apply_image(
+    const std::shared_ptr<const Array>& image) const {
+  return core::image::gaussian_blur(
+      image, generate_random_sigma_(), kernelSize_);
+}
+
+bool ImageGaussianBlur::image_output_shape(
+    const std::shared_ptr<const Array>& image,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  type = UInt8;
+  shape = image->shape();
+  return true;
+}
+
+void ImageGaussianBlur::apply_image_into(
+    const std::shared_ptr<const Array>& image,
+    const std::shared_ptr<Array>& destination) const {
+  core::image::gaussian_blur(
+      image, generate_random_sigma_(), kernelSize_, destination);
+}
+
+std::shared_ptr<Array> ImageGaussianBlur::apply_video(
+    const std::shared_ptr<const Array>& video) const {
+  // blur all the frames the same way
+  auto sigma = generate_random_sigma_();
+  auto result = std::make_shared<Array>(UInt8, video->shape());
+  for (int i = 0; i < core::video::frames(video); i++) {
+    core::image::gaussian_blur(
+        array::slice(video, i), sigma, kernelSize_, array::slice(result, i));
+  }
+  return result;
+}
+
 } // namespace op
 } // namespace data
 } // namespace mlx
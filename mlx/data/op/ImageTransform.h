@@ -22,6 +22,26 @@ class ImageTransformOp : public KeyTransformOp {
   /// implementation simply calls `applyImage(Image)` for each frame.
   virtual std::shared_ptr<Array> apply_video(
       const std::shared_ptr<const Array>& image) const;
+
+  /// Images only: forwards to image_output_shape() and apply_image_into().
+  virtual bool output_shape(
+      const std::shared_ptr<const Array>& x,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_key_into(
+      const std::shared_ptr<const Array>& x,
+      const std::shared_ptr<Array>& destination) const override;
+
+  /// The type and shape apply_image() returns, when they can be told without
+  /// transforming the image (see KeyTransformOp::output_shape()). Transforms
+  /// overriding it must override apply_image_into() too.
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const;
 };
 
 class ImageResizeSmallestSide : public ImageTransformOp {
@@ -46,6 +66,13 @@ class ImageResize : public ImageTransformOp {
       const std::string& okey = "");
   virtual std::shared_ptr<Array> apply_image(
       const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
 
  private:
   int64_t w_;
@@ -61,6 +88,13 @@ class ImageCenterCrop : public ImageTransformOp {
       const std::string& okey = "");
   virtual std::shared_ptr<Array> apply_image(
       const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
 
  private:
   int64_t w_;
@@ -76,6 +110,13 @@ class ImageRandomCrop : public ImageTransformOp {
       const std::string& okey = "");
   virtual std::shared_ptr<Array> apply_image(
       const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
   virtual std::shared_ptr<Array> apply_video(
       const std::shared_ptr<const Array>& video) const override;
 
@@ -106,11 +147,6 @@ class ImageRandomAreaCrop : public ImageTransformOp {
   virtual std::shared_ptr<Array> apply_video(
       const std::shared_ptr<const Array>& video) const override;
 
- private:
-  std::pair<float, float> areaRange_;
-  std::pair<float, float> aspectRatioRange_;
-  int numTrial_;
-
   struct Parameters {
     int64_t tx;
     int64_t ty;
@@ -118,7 +154,13 @@ class ImageRandomAreaCrop : public ImageTransformOp {
     int64_t th;
   };
 
-  Parameters generate_random_crop_(int64_t w, int64_t h) const;
+  // Draws a crop of a w x h image, all zeros if none could be found.
+  Parameters generate_random_crop(int64_t w, int64_t h) const;
+
+ private:
+  std::pair<float, float> areaRange_;
+  std::pair<float, float> aspectRatioRange_;
+  int numTrial_;
 };
 
 class ImageRandomHFlip : public ImageTransformOp {
@@ -129,6 +171,13 @@ class ImageRandomHFlip : public ImageTransformOp {
       const std::string& okey = "");
   virtual std::shared_ptr<Array> apply_image(
       const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
   virtual std::shared_ptr<Array> apply_video(
       const std::shared_ptr<const Array>& video) const override;
 
@@ -142,13 +191,209 @@ class ImageRotate : public ImageTransformOp {
       const std::string& ikey,
       double angle,
       bool crop = false,
+      const std::string& interpolation = "nearest",
       const std::string& okey = "");
   virtual std::shared_ptr<Array> apply_image(
       const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
 
  private:
   double angle_;
   bool crop_;
+  core::image::Interpolation interpolation_;
+};
+
+/// Warps the image with a 2x3 (row major) affine matrix mapping the input
+/// pixel coordinates to the output ones, both relative to the image centers.
+class ImageAffine : public ImageTransformOp {
+ public:
+  ImageAffine(
+      const std::string& ikey,
+      const std::vector<float>& matrix,
+      bool crop = false,
+      const std::string& interpolation = "nearest",
+      const std::string& okey = "");
+  virtual std::shared_ptr<Array> apply_image(
+      const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
+
+ private:
+  // the inverse of the matrix, as expected by core::image::affine
+  float mx_[6];
+  bool crop_;
+  core::image::Interpolation interpolation_;
+};
+
+/// Rotates (in degrees), scales, shears (in degrees, along x) and translates
+/// (as a fraction of the image size) the image by amounts drawn uniformly in
+/// the given ranges. Frames of a video are all transformed the same way.
+class ImageRandomAffine : public ImageTransformOp {
+ public:
+  ImageRandomAffine(
+      const std::string& ikey,
+      std::pair<float, float> rotation_range,
+      std::pair<float, float> scale_range = {1, 1},
+      std::pair<float, float> shear_range = {0, 0},
+      std::pair<float, float> translate_range = {0, 0},
+      bool crop = true,
+      const std::string& interpolation = "bilinear",
+      const std::string& okey = "");
+  virtual std::shared_ptr<Array> apply_image(
+      const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
+  virtual std::shared_ptr<Array> apply_video(
+      const std::shared_ptr<const Array>& video) const override;
+
+ private:
+  std::pair<float, float> rotationRange_;
+  std::pair<float, float> scaleRange_;
+  std::pair<float, float> shearRange_;
+  std::pair<float, float> translateRange_;
+  bool crop_;
+  core::image::Interpolation interpolation_;
+
+  // Draws the inverse matrix of a transform of a w x h image.
+  void generate_random_matrix_(int64_t w, int64_t h, float mx[6]) const;
+};
+
+/// Converts uint8 images to float as (pixel / 255 - mean) / stddev per channel,
+/// optionally laid out channels first. Applied after batching, the whole
+/// batch is normalized at once.
+class ImageNormalize : public ImageTransformOp {
+ public:
+  ImageNormalize(
+      const std::string& ikey,
+      const std::vector<float>& mean,
+      const std::vector<float>& stddev,
+      bool channels_first = false,
+      const std::string& okey = "");
+  virtual std::shared_ptr<Array> apply_image(
+      const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
+  virtual std::shared_ptr<Array> apply_video(
+      const std::shared_ptr<const Array>& video) const override;
+
+ private:
+  std::vector<float> mean_;
+  std::vector<float> stddev_;
+  bool channelsFirst_;
+};
+
+/// Scales the brightness, contrast and saturation by factors drawn uniformly
+/// in [max(0, 1 - x), 1 + x] and rotates the hue by a number of turns drawn
+/// in [-hue, hue] (hue <= 0.5). Frames of a video are all transformed the
+/// same way.
+class ImageRandomColorJitter : public ImageTransformOp {
+ public:
+  ImageRandomColorJitter(
+      const std::string& ikey,
+      float brightness,
+      float contrast = 0,
+      float saturation = 0,
+      float hue = 0,
+      const std::string& okey = "");
+  virtual std::shared_ptr<Array> apply_image(
+      const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
+  virtual std::shared_ptr<Array> apply_video(
+      const std::shared_ptr<const Array>& video) const override;
+
+ private:
+  float brightness_;
+  float contrast_;
+  float saturation_;
+  float hue_;
+
+  struct Parameters {
+    float brightness;
+    float contrast;
+    float saturation;
+    float hue;
+  };
+
+  Parameters generate_random_parameters_() const;
+};
+
+/// Converts the image to grayscale (keeping its number of channels) with
+/// probability prob.
+class ImageRandomGrayscale : public ImageTransformOp {
+ public:
+  ImageRandomGrayscale(
+      const std::string& ikey,
+      float prob,
+      const std::string& okey = "");
+  virtual std::shared_ptr<Array> apply_image(
+      const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
+  virtual std::shared_ptr<Array> apply_video(
+      const std::shared_ptr<const Array>& video) const override;
+
+ private:
+  float prob_;
+};
+
+/// Blurs the image with a gaussian whose standard deviation is drawn
+/// uniformly in sigma_range (see core::image::gaussian_blur()).
+class ImageGaussianBlur : public ImageTransformOp {
+ public:
+  ImageGaussianBlur(
+      const std::string& ikey,
+      std::pair<float, float> sigma_range,
+      int kernel_size = 0,
+      const std::string& okey = "");
+  virtual std::shared_ptr<Array> apply_image(
+      const std::shared_ptr<const Array>& image) const override;
+  virtual bool image_output_shape(
+      const std::shared_ptr<const Array>& image,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const override;
+  virtual void apply_image_into(
+      const std::shared_ptr<const Array>& image,
+      const std::shared_ptr<Array>& destination) const override;
+  virtual std::shared_ptr<Array> apply_video(
+      const std::shared_ptr<const Array>& video) const override;
+
+ private:
+  std::pair<float, float> sigmaRange_;
+  int kernelSize_;
+
+  float generate_random_sigma_() const;
 };
 
 class ImageChannelReduction : public ImageTransformOp {
@@ -1,8 +1,10 @@
 // Copyright © 2023 Apple Inc.
 
+#include <cstring>
 #include <stdexcept>
 
 #include "mlx/data/op/KeyTransform.h"
+#include "mlx/data/core/Utils.h"
 
 namespace mlx {
 namespace data {
@@ -20,6 +22,97 @@ Sample KeyTransformOp::apply(const Sample& sample) const {
   return res;
 }
 
+bool KeyTransformOp::may_return_empty() const {
+  return false;
+}
+
+bool KeyTransformOp::output_shape(
+    const std::shared_ptr<const Array>& x,
+    ArrayType& type,
+    std::vector<int64_t>& shape) const {
+  return false;
+}
+
+void KeyTransformOp::apply_key_into(
+    const std::shared_ptr<const Array>& x,
+    const std::shared_ptr<Array>& destination) const {
+  auto dst = apply_key(x);
+  if (dst->type() != destination->type() ||
+      dst->shape() != destination->shape()) {
+    throw std::runtime_error(
+        "KeyTransformOp: output does not match the expected shape");
+  }
+  array::copy(destination, dst);
+}
+
+Sample KeyTransformOp::apply_batch(
+    const std::function<Sample()>& next,
+    int64_t batch_size,
+    const std::unordered_map<std::string, double>& pad_values,
+    const std::unordered_map<std::string, int>& batch_dims) const {
+  auto okey = (okey_.empty() ? ikey_ : okey_);
+
+  // the output is written in place as long as all the samples have the same
+  // output shape (no padding) and no batch dimension is involved
+  bool in_place = (batch_dims.find(okey) == batch_dims.end());
+  std::shared_ptr<Array> dst;
+  ArrayType type = ArrayType::Any;
+  std::vector<int64_t> shape;
+  std::vector<Sample> samples;
+  for (int64_t i = 0; i < batch_size; i++) {
+    auto sample = next();
+    if (sample.empty()) {
+      break;
+    }
+    auto src = sample::check_key(sample, ikey_, ArrayType::Any);
+    if (in_place) {
+      ArrayType src_type;
+      std::vector<int64_t> src_shape;
+      bool known = output_shape(src, src_type, src_shape) &&
+          !src_shape.empty();
+      if (i == 0 && known) {
+        type = src_type;
+        shape = src_shape;
+        auto dst_shape = shape;
+        dst_shape.insert(dst_shape.begin(), batch_size);
+        dst = std::make_shared<Array>(type, dst_shape);
+      }
+      in_place = known && dst && src_type == type && src_shape == shape;
+      if (in_place) {
+        apply_key_into(src, array::slice(dst, i));
+        sample.erase(okey);
+        samples.push_back(std::move(sample));
+        continue;
+      }
+      // give back the outputs already written to the previous samples
+      for (int64_t j = 0; j < i; j++) {
+        samples[j][okey] = array::slice(dst, j);
+      }
+    }
+    sample[okey] = apply_key(src);
+    samples.push_back(std::move(sample));
+  }
+
+  if (samples.empty()) {
+    return Sample();
+  }
+  if (!in_place) {
+    return core::merge_batch(samples, pad_values, batch_dims);
+  }
+  if (samples.size() < batch_size) {
+    // the source was exhausted before filling the batch
+    auto dst_shape = shape;
+    dst_shape.insert(dst_shape.begin(), samples.size());
+    auto batch = std::make_shared<Array>(type, dst_shape);
+    std::memcpy(
+        batch->data(), dst->data(), batch->size() * batch->itemsize());
+    dst = batch;
+  }
+  auto res = core::merge_batch(samples, pad_values, batch_dims);
+  res[okey] = dst;
+  return res;
+}
+
 KeyTransform::KeyTransform(
     const std::string& ikey,
     std::function<std::shared_ptr<Array>(const std::shared_ptr<const Array>&)>
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <functional>
+#include <unordered_map>
+#include <vector>
 
 #include "mlx/data/op/Op.h"
 
@@ -15,9 +17,36 @@ class KeyTransformOp : public Op {
   KeyTransformOp(const std::string& ikey, const std::string& okey = "");
 
   virtual Sample apply(const Sample& sample) const;
+  virtual bool may_return_empty() const override;
   virtual std::shared_ptr<Array> apply_key(
       const std::shared_ptr<const Array>& x) const = 0;
 
+  /// If the type and shape apply_key() returns for x can be told without
+  /// transforming it, sets them and returns true. Batching then allocates
+  /// the batch upfront and calls apply_key_into() with the slot of each
+  /// sample, which saves an allocation and a copy per sample.
+  virtual bool output_shape(
+      const std::shared_ptr<const Array>& x,
+      ArrayType& type,
+      std::vector<int64_t>& shape) const;
+
+  /// Writes the result of apply_key() into destination, which has the type
+  /// and shape given by output_shape(). The default implementation copies
+  /// it.
+  virtual void apply_key_into(
+      const std::shared_ptr<const Array>& x,
+      const std::shared_ptr<Array>& destination) const;
+
+  /// Applies the op to (at most) batch_size samples returned by next(),
+  /// until it returns an empty sample, and merges them into a batch (see
+  /// core::merge_batch()). As long as the output shapes are known and the
+  /// same, the output key is written in place into the batch.
+  Sample apply_batch(
+      const std::function<Sample()>& next,
+      int64_t batch_size,
+      const std::unordered_map<std::string, double>& pad_values = {},
+      const std::unordered_map<std::string, int>& batch_dims = {}) const;
+
  protected:
   std::string ikey_;
   std::string okey_;
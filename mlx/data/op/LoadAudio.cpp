@@ -2,8 +2,10 @@
 
 #include <cmath>
 #include <filesystem>
+#include <random>
 #include <unordered_map>
 
+#include "mlx/data/core/State.h"
 #include "mlx/data/core/audio/Audio.h"
 #include "mlx/data/op/LoadAudio.h"
 
@@ -71,6 +73,9 @@ LoadAudio::LoadAudio(
     int sample_rate,
     LoadAudioResamplingQuality resampling_quality,
     const std::string& infokey,
+    double offset_seconds,
+    double duration_seconds,
+    bool random_crop,
     const std::string& okey)
     : Op(),
       iKey_(ikey),
@@ -81,7 +86,33 @@ LoadAudio::LoadAudio(
       from_memory_(from_memory),
       infoType_(info_type),
       sampleRate_(sample_rate),
-      resamplingQuality_(resampling_quality) {}
+      resamplingQuality_(resampling_quality),
+      offsetSeconds_(offset_seconds),
+      durationSeconds_(duration_seconds),
+      randomCrop_(random_crop) {
+  if (offset_seconds < 0 || duration_seconds < 0) {
+    throw std::runtime_error(
+        "LoadAudio: offset and duration must be non negative");
+  }
+  if (random_crop && duration_seconds <= 0) {
+    throw std::runtime_error("LoadAudio: random crop requires a duration");
+  }
+}
+
+std::pair<int64_t, int64_t> LoadAudio::frame_range_(
+    const core::audio::AudioInfo& info) const {
+  int64_t start = std::llround(offsetSeconds_ * info.sampleRate);
+  int64_t length = (durationSeconds_ > 0)
+      ? std::llround(durationSeconds_ * info.sampleRate)
+      : info.frames - start;
+  if (randomCrop_ && info.frames - length > start) {
+    auto state = core::get_state();
+    std::uniform_int_distribution<int64_t> uniform(
+        start, info.frames - length);
+    start = uniform(state->randomGenerator);
+  }
+  return {start, length};
+}
 
 Sample LoadAudio::apply(const Sample& sample) const {
   auto src = sample::check_key(sample, iKey_, ArrayType::Any);
@@ -108,8 +139,19 @@ Sample LoadAudio::apply(const Sample& sample) const {
     res[okey] = extract_audio_info(audio_info, infoType_);
   } else {
     core::audio::AudioInfo audio_info;
-    auto audio = from_memory_ ? core::audio::load(src, &audio_info)
-                              : core::audio::load(path, &audio_info);
+    std::shared_ptr<Array> audio;
+    if (offsetSeconds_ > 0 || durationSeconds_ > 0) {
+      auto range = [this](const core::audio::AudioInfo& info) {
+        return frame_range_(info);
+      };
+      audio = from_memory_ ? core::audio::load(src, &audio_info, range)
+                           : core::audio::load(path, &audio_info, range);
+      // the info describes the loaded crop rather than the whole file
+      audio_info.frames = audio->shape(0);
+    } else {
+      audio = from_memory_ ? core::audio::load(src, &audio_info)
+                           : core::audio::load(path, &audio_info);
+    }
     audio = core::audio::resample(
         audio,
         convert_resample_mode(resamplingQuality_),
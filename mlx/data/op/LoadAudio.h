@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "mlx/data/core/audio/Audio.h"
 #include "mlx/data/op/Op.h"
 
 namespace mlx {
@@ -39,11 +40,20 @@ class LoadAudio : public Op {
       LoadAudioResamplingQuality resampling_quality =
           LoadAudioResamplingQuality::SincFastest,
       const std::string& infokey = "",
+      // if positive, only the frames in [offset, offset + duration) are
+      // decoded, at a random offset (after offset_seconds) with random_crop,
+      // and the info in infokey counts the frames of the crop
+      double offset_seconds = 0,
+      double duration_seconds = 0,
+      bool random_crop = false,
       const std::string& okey = "");
 
   virtual Sample apply(const Sample& sample) const override;
 
  private:
+  std::pair<int64_t, int64_t> frame_range_(
+      const core::audio::AudioInfo& info) const;
+
   std::string iKey_;
   std::string oKey_;
   std::string infoKey_;
@@ -53,6 +63,9 @@ class LoadAudio : public Op {
   LoadAudioInfo infoType_;
   int sampleRate_;
   LoadAudioResamplingQuality resamplingQuality_;
+  double offsetSeconds_;
+  double durationSeconds_;
+  bool randomCrop_;
 };
 
 class ResampleAudio : public Op {
@@ -14,12 +14,16 @@ LoadImage::LoadImage(
     bool info,
     const std::string& format,
     bool from_memory,
+    int64_t resize_smallest_side,
+    std::shared_ptr<core::image::ImageCache> cache,
     const std::string& okey)
     : KeyTransformOp(ikey, okey),
       prefix_(prefix),
       info_(info),
       format_(format),
-      from_memory_(from_memory) {}
+      from_memory_(from_memory),
+      resize_smallest_side_(resize_smallest_side),
+      cache_(cache) {}
 std::shared_ptr<Array> LoadImage::apply_key(
     const std::shared_ptr<const Array>& src) const {
   std::filesystem::path path;
@@ -37,12 +41,80 @@ std::shared_ptr<Array> LoadImage::apply_key(
     std::vector<int64_t> info_array({info.width, info.height});
     dst = std::make_shared<Array>(info_array);
   } else {
-    dst = from_memory_ ? core::image::load(src) : core::image::load(path);
+    std::string cache_key;
+    if (cache_) {
+      cache_key = from_memory_ ? core::image::ImageCache::content_key(src)
+                               : core::image::ImageCache::file_key(path);
+    }
+    if (!cache_key.empty()) {
+      // the same cache may be shared by several resizing loaders
+      cache_key += "@" + std::to_string(resize_smallest_side_);
+      dst = cache_->get(cache_key);
+      if (dst) {
+        return dst;
+      }
+    }
+    dst = from_memory_ ? core::image::load(src, resize_smallest_side_)
+                       : core::image::load(path, resize_smallest_side_);
     if (!dst) {
       throw std::runtime_error(
           "LoadImage: unable to load image <" +
           (from_memory_ ? "stream" : path.string()) + ">");
     }
+    if (!cache_key.empty()) {
+      cache_->put(cache_key, dst);
+    }
+  }
+  return dst;
+}
+
+LoadImageRandomAreaCrop::LoadImageRandomAreaCrop(
+    const std::string& ikey,
+    std::pair<float, float> area_range,
+    std::pair<float, float> aspect_ratio_range,
+    int num_trial,
+    const std::string& prefix,
+    bool from_memory,
+    int64_t resize_width,
+    int64_t resize_height,
+    const std::string& okey)
+    : KeyTransformOp(ikey, okey),
+      crop_(ikey, area_range, aspect_ratio_range, num_trial, okey),
+      prefix_(prefix),
+      from_memory_(from_memory),
+      resize_width_(resize_width),
+      resize_height_(resize_height) {}
+
+std::shared_ptr<Array> LoadImageRandomAreaCrop::apply_key(
+    const std::shared_ptr<const Array>& src) const {
+  auto region = [this](int64_t w, int64_t h) -> core::image::ImageRegion {
+    auto p = crop_.generate_random_crop(w, h);
+    if (p.tw == 0 || p.th == 0) {
+      // no crop found, keep the whole image
+      return {0, 0, w, h};
+    }
+    return {p.tx, p.ty, p.tw, p.th};
+  };
+  std::shared_ptr<Array> dst;
+  if (from_memory_) {
+    dst = core::image::load_region(src, region, resize_width_, resize_height_);
+    if (!dst) {
+      throw std::runtime_error(
+          "LoadImageRandomAreaCrop: unable to load image <stream>");
+    }
+  } else {
+    if (src->type() != ArrayType::Int8) {
+      throw std::runtime_error(
+          "LoadImageRandomAreaCrop: char array (int8) expected");
+    }
+    std::filesystem::path path = prefix_;
+    path /= std::string(reinterpret_cast<char*>(src->data()), src->size());
+    dst = core::image::load_region(path, region, resize_width_, resize_height_);
+    if (!dst) {
+      throw std::runtime_error(
+          "LoadImageRandomAreaCrop: unable to load image <" + path.string() +
+          ">");
+    }
   }
   return dst;
 }
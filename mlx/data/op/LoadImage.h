@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "mlx/data/core/image/ImageCache.h"
+#include "mlx/data/op/ImageTransform.h"
 #include "mlx/data/op/KeyTransform.h"
 
 namespace mlx {
@@ -12,12 +14,18 @@ class LoadImage : public KeyTransformOp {
  public:
   // note: info=true is meant to fast-retrieval of image size and thus will not
   // perform transformations
+  // If resize_smallest_side > 0, the image is resized as with
+  // ImageResizeSmallestSide, JPEG images being decoded at a reduced scale.
+  // If a cache is provided, the (resized) images are kept in it, keyed by
+  // their file or their contents.
   LoadImage(
       const std::string& ikey,
       const std::string& prefix = "",
       bool info = false,
       const std::string& format = "RGB",
       bool from_memory = false,
+      int64_t resize_smallest_side = 0,
+      std::shared_ptr<core::image::ImageCache> cache = nullptr,
       const std::string& okey = "");
 
   virtual std::shared_ptr<Array> apply_key(
@@ -28,6 +36,35 @@ class LoadImage : public KeyTransformOp {
   bool info_;
   std::string format_;
   bool from_memory_;
+  int64_t resize_smallest_side_;
+  std::shared_ptr<core::image::ImageCache> cache_;
+};
+
+// Fuses LoadImage and ImageRandomAreaCrop (and optionally ImageResize): the
+// crop is drawn once the image size is known and, for JPEG images, only the
+// cropped area is decoded.
+class LoadImageRandomAreaCrop : public KeyTransformOp {
+ public:
+  LoadImageRandomAreaCrop(
+      const std::string& ikey,
+      std::pair<float, float> area_range,
+      std::pair<float, float> aspect_ratio_range,
+      int num_trial = 10,
+      const std::string& prefix = "",
+      bool from_memory = false,
+      int64_t resize_width = 0,
+      int64_t resize_height = 0,
+      const std::string& okey = "");
+
+  virtual std::shared_ptr<Array> apply_key(
+      const std::shared_ptr<const Array>& src) const override;
+
+ private:
+  ImageRandomAreaCrop crop_;
+  std::string prefix_;
+  bool from_memory_;
+  int64_t resize_width_;
+  int64_t resize_height_;
 };
 
 } // namespace op
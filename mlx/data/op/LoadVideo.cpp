@@ -1,8 +1,10 @@
 // Copyright © 2023 Apple Inc.
 
+#include <cmath>
 #include <filesystem>
+#include <random>
 
-#include "mlx/data/core/video/Video.h"
+#include "mlx/data/core/State.h"
 #include "mlx/data/op/LoadVideo.h"
 
 namespace mlx {
@@ -13,11 +15,80 @@ LoadVideo::LoadVideo(
     const std::string& prefix,
     bool info,
     bool from_memory,
+    int64_t num_frames,
+    int64_t stride,
+    double clip_duration,
+    bool random_offset,
+    int64_t resize_smallest_side,
+    int num_threads,
     const std::string& okey)
     : KeyTransformOp(ikey, okey),
       prefix_(prefix),
       info_(info),
-      from_memory_(from_memory) {}
+      from_memory_(from_memory),
+      num_frames_(num_frames),
+      stride_(stride),
+      clip_duration_(clip_duration),
+      random_offset_(random_offset) {
+  options_.resize_smallest_side = resize_smallest_side;
+  options_.num_threads = num_threads;
+  if (num_frames < 0 || stride < 0 || clip_duration < 0) {
+    throw std::runtime_error(
+        "LoadVideo: num_frames, stride and clip_duration must be non negative");
+  }
+  if (stride > 0 && clip_duration > 0) {
+    throw std::runtime_error(
+        "LoadVideo: stride and clip_duration cannot be both set");
+  }
+}
+
+std::vector<int64_t> LoadVideo::sample_frames(
+    const core::video::VideoInfo& info) const {
+  // the number of frames of the clip
+  int64_t length;
+  if (clip_duration_ > 0) {
+    if (info.fps <= 0) {
+      throw std::runtime_error(
+          "LoadVideo: unknown frame rate, cannot sample a clip duration");
+    }
+    length = std::max<int64_t>(1, std::llround(clip_duration_ * info.fps));
+  } else if (stride_ > 0) {
+    length = (num_frames_ - 1) * stride_ + 1;
+  } else {
+    length = info.frames;
+  }
+  if (length <= 0) {
+    throw std::runtime_error("LoadVideo: unknown number of frames");
+  }
+
+  auto state = core::get_state();
+  int64_t start = 0;
+  if (info.frames > length) {
+    if (random_offset_) {
+      std::uniform_int_distribution<int64_t> uniform(0, info.frames - length);
+      start = uniform(state->randomGenerator);
+    } else {
+      start = (info.frames - length) / 2;
+    }
+  }
+
+  std::vector<int64_t> frames(num_frames_);
+  double segment = static_cast<double>(length) / num_frames_;
+  std::uniform_real_distribution<double> uniform(0, 1);
+  for (int64_t i = 0; i < num_frames_; i++) {
+    int64_t frame;
+    if (stride_ > 0) {
+      frame = start + i * stride_;
+    } else {
+      double offset = random_offset_ ? uniform(state->randomGenerator) : 0.5;
+      frame = start + static_cast<int64_t>((i + offset) * segment);
+    }
+    // frames past the end repeat the last one
+    frames[i] = info.frames > 0 ? std::min(frame, info.frames - 1) : frame;
+  }
+  return frames;
+}
+
 std::shared_ptr<Array> LoadVideo::apply_key(
     const std::shared_ptr<const Array>& src) const {
   std::filesystem::path path;
@@ -39,7 +110,16 @@ std::shared_ptr<Array> LoadVideo::apply_key(
     dst = std::make_shared<Array>(shape);
 
   } else {
-    dst = from_memory_ ? core::video::load(src) : core::video::load(path);
+    if (num_frames_ > 0) {
+      auto frames = [this](const core::video::VideoInfo& info) {
+        return sample_frames(info);
+      };
+      dst = from_memory_ ? core::video::load_frames(src, frames, options_)
+                         : core::video::load_frames(path, frames, options_);
+    } else {
+      dst = from_memory_ ? core::video::load(src, options_)
+                         : core::video::load(path, options_);
+    }
     if (!dst) {
       throw std::runtime_error(
           "LoadVideo: unable to load video <" +
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "mlx/data/core/video/Video.h"
 #include "mlx/data/op/KeyTransform.h"
 
 namespace mlx {
@@ -10,20 +11,45 @@ namespace op {
 
 class LoadVideo : public KeyTransformOp {
  public:
+  // If num_frames > 0, only num_frames frames of a clip are loaded, the
+  // decoder seeking to them instead of decoding the whole video:
+  // - with stride > 0 they are stride frames apart,
+  // - otherwise they are spread uniformly over the clip (the middle of
+  //   num_frames segments, or a random frame of each if random_offset).
+  // The clip lasts clip_duration seconds if positive, spans the sampled
+  // frames with stride > 0, or is the whole video otherwise. It is centered
+  // in the video, or at a random position if random_offset.
+  //
+  // If resize_smallest_side > 0, the frames are resized as with
+  // ImageResizeSmallestSide while being decoded. The decoder uses num_threads
+  // threads (0 for one per core).
   LoadVideo(
       const std::string& ikey,
       const std::string& prefix = "",
       bool info = false,
       bool from_memory = false,
+      int64_t num_frames = 0,
+      int64_t stride = 0,
+      double clip_duration = 0,
+      bool random_offset = false,
+      int64_t resize_smallest_side = 0,
+      int num_threads = 1,
       const std::string& okey = "");
 
   virtual std::shared_ptr<Array> apply_key(
       const std::shared_ptr<const Array>& src) const override;
 
+  std::vector<int64_t> sample_frames(const core::video::VideoInfo& info) const;
+
  private:
   std::string prefix_;
   bool info_;
   bool from_memory_;
+  int64_t num_frames_;
+  int64_t stride_;
+  double clip_duration_;
+  bool random_offset_;
+  core::video::VideoDecodeOptions options_;
 };
 
 } // namespace op
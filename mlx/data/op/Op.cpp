@@ -12,6 +12,10 @@ Sample Op::apply(const Sample& sample) const {
   throw std::runtime_error("Op::apply() NYI");
 }
 
+bool Op::may_return_empty() const {
+  return true;
+}
+
 Op::~Op() {}
 
 } // namespace op
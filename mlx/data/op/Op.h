@@ -20,6 +20,10 @@ class Op {
   // DEBUG: (debatable) sample could be not const
   virtual Sample apply(const Sample& sample) const;
 
+  // whether apply() may return an empty sample (which streams drop). Streams
+  // can skip samples without transforming them only when this is false.
+  virtual bool may_return_empty() const;
+
   virtual ~Op();
 };
 
@@ -38,19 +38,34 @@ ReadFromTAR::get_tar_reader_(const std::string& key) const {
   if (fetcher_) {
     handle = fetcher_->fetch(key);
   }
+  auto data = handle ? handle->data() : nullptr;
   {
     std::shared_lock slock(mutex_);
     auto it = tars_.find(key);
-    if (it != tars_.end()) {
-      return std::make_pair(it->second, handle);
+    if (it != tars_.end() &&
+        (!data || it->second.second.lock() == handle)) {
+      return std::make_pair(it->second.first, handle);
     }
   }
   {
     std::unique_lock ulock(mutex_);
-    auto key_path = tarPrefix_ / key;
-    auto tar = std::make_shared<core::TARReader>(
-        key_path.string(), nested_, numThreads_);
-    tars_[key] = tar;
+    std::shared_ptr<core::TARReader> tar;
+    if (data) {
+      // drop the archives the fetcher does not keep anymore
+      for (auto it = tars_.begin(); it != tars_.end();) {
+        if (it->second.second.expired()) {
+          it = tars_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      tar = std::make_shared<core::TARReader>(data, nested_, numThreads_);
+    } else {
+      auto key_path = tarPrefix_ / key;
+      tar = std::make_shared<core::TARReader>(
+          key_path.string(), nested_, numThreads_);
+    }
+    tars_[key] = std::make_pair(tar, handle);
     return std::make_pair(tar, handle);
   }
 }
@@ -46,7 +46,13 @@ class ReadFromTAR : public Op {
   std::shared_ptr<core::FileFetcher> fetcher_;
   bool nested_;
   int numThreads_;
-  mutable std::unordered_map<std::string, std::shared_ptr<core::TARReader>>
+  // Readers of archives fetched in memory are only valid for the handle
+  // they were made from.
+  mutable std::unordered_map<
+      std::string,
+      std::pair<
+          std::shared_ptr<core::TARReader>,
+          std::weak_ptr<core::FileFetcherHandle>>>
       tars_;
   mutable std::shared_mutex mutex_;
 };
@@ -24,6 +24,10 @@ Sample RemoveValue::apply(const Sample& sample) const {
   new_sample[size_key_] = size_array;
   return new_sample;
 }
+
+bool RemoveValue::may_return_empty() const {
+  return false;
+}
 } // namespace op
 } // namespace data
 } // namespace mlx
@@ -18,6 +18,7 @@ class RemoveValue : public Op {
       double pad);
 
   virtual Sample apply(const Sample& sample) const override;
+  virtual bool may_return_empty() const override;
 
  private:
   std::string key_;
@@ -17,6 +17,10 @@ Sample RenameKey::apply(const Sample& sample) const {
   res.erase(ikey_);
   return res;
 }
+
+bool RenameKey::may_return_empty() const {
+  return false;
+}
 } // namespace op
 } // namespace data
 } // namespace mlx
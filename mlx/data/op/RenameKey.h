@@ -13,6 +13,7 @@ class RenameKey : public Op {
   RenameKey(const std::string& ikey, const std::string& okey);
 
   virtual Sample apply(const Sample& sample) const override;
+  virtual bool may_return_empty() const override;
 
  private:
   std::string ikey_;
@@ -22,6 +22,10 @@ Sample Shape::apply(const Sample& sample) const {
   res[okey_] = output_array;
   return res;
 }
+
+bool Shape::may_return_empty() const {
+  return false;
+}
 } // namespace op
 } // namespace data
 } // namespace mlx
@@ -14,6 +14,7 @@ class Shape : public Op {
   Shape(const std::string& ikey, const std::string& okey);
 
   virtual Sample apply(const Sample& sample) const override;
+  virtual bool may_return_empty() const override;
 
  private:
   std::string ikey_;
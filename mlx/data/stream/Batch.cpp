@@ -20,9 +20,20 @@ Batch::Batch(
   if (batch_size <= 0) {
     throw std::runtime_error("Batch: batch size must be positive");
   }
+  transform_ = std::dynamic_pointer_cast<Transform>(stream);
+  if (transform_) {
+    keyTransform_ = transform_->last_key_transform();
+  }
 }
 
 Sample Batch::next() const {
+  if (keyTransform_) {
+    return keyTransform_->apply_batch(
+        [this]() { return transform_->next_partial(); },
+        batchSize_,
+        padValues_,
+        batchDims_);
+  }
   std::vector<Sample> samples;
   for (int i = 0; i < batchSize_; i++) {
     auto sample = stream_->next();
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "mlx/data/stream/Stream.h"
+#include "mlx/data/stream/Transform.h"
 
 namespace mlx {
 namespace data {
@@ -23,6 +24,11 @@ class Batch : public Stream {
   int64_t batchSize_;
   std::unordered_map<std::string, double> padValues_;
   std::unordered_map<std::string, int> batchDims_;
+
+  // Set when the upstream is a Transform ending with a KeyTransformOp, which
+  // is then applied directly into the batch.
+  std::shared_ptr<Transform> transform_;
+  std::shared_ptr<op::KeyTransformOp> keyTransform_;
 };
 
 } // namespace stream
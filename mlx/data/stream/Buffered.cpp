@@ -16,7 +16,7 @@ Buffered::Buffered(
     int num_thread)
     : stream_(stream),
       buffer_size_(buffer_size),
-      pool_(std::make_shared<core::ThreadPool>(num_thread + 1)),
+      pool_(std::make_shared<core::TaskGroup>(num_thread + 1)),
       current_index_(0),
       buffer_(nullptr) {}
 
@@ -36,7 +36,7 @@ Buffered::background_buffer_fetch_() const {
 
     std::vector<Sample> buffer;
     for (auto& fsample : future_buffer) {
-      Sample sample = fsample.get();
+      Sample sample = core::ThreadPool::get(fsample);
       if (!sample.empty()) {
         buffer.push_back(sample);
       }
@@ -54,11 +54,12 @@ Buffered::background_buffer_fetch_() const {
 }
 
 Sample Buffered::next() const {
-  std::unique_lock lock(mutex_);
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
 
   // First run
   if (buffer_ == nullptr) {
-    buffer_ = background_buffer_fetch_().get();
+    buffer_ = core::ThreadPool::get(background_buffer_fetch_());
     next_buffer_ = background_buffer_fetch_();
   }
 
@@ -70,7 +71,7 @@ Sample Buffered::next() const {
   // Normal running
   if (current_index_ >= buffer_->size()) {
     current_index_ = 0;
-    buffer_ = next_buffer_.get();
+    buffer_ = core::ThreadPool::get(next_buffer_);
     next_buffer_ = background_buffer_fetch_();
 
     if (buffer_->size() == 0) {
@@ -82,11 +83,12 @@ Sample Buffered::next() const {
 }
 
 void Buffered::reset() {
-  std::unique_lock lock(mutex_);
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
 
   buffer_ = nullptr;
   if (next_buffer_.valid()) {
-    next_buffer_.get();
+    core::ThreadPool::get(next_buffer_);
   }
   stream_->reset();
 }
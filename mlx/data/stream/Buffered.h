@@ -6,6 +6,7 @@
 #include <shared_mutex>
 
 #include "mlx/data/buffer/Buffer.h"
+#include "mlx/data/core/TaskGroup.h"
 #include "mlx/data/stream/Stream.h"
 
 namespace mlx {
@@ -36,7 +37,7 @@ class Buffered : public Stream {
   std::shared_ptr<Stream> stream_; // underlying stream
   int64_t buffer_size_; // how many buffer items
 
-  std::shared_ptr<core::ThreadPool> pool_;
+  std::shared_ptr<core::TaskGroup> pool_;
   bool pool_is_alive_ = true;
   mutable int current_index_;
   mutable std::shared_ptr<buffer::Buffer> buffer_;
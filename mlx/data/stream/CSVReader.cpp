@@ -15,8 +15,13 @@ CSVReader::CSVReader(
   if (fetcher) {
     fileHandle_ = fetcher->fetch(filename);
   }
-  auto file_path = local_prefix / filename;
-  csv_ = std::make_unique<core::CSVReader>(file_path.string(), sep, quote);
+  if (fileHandle_ && fileHandle_->data()) {
+    csv_ = std::make_unique<core::CSVReader>(
+        std::make_shared<core::imemstream>(fileHandle_->data()), sep, quote);
+  } else {
+    auto file_path = local_prefix / filename;
+    csv_ = std::make_unique<core::CSVReader>(file_path.string(), sep, quote);
+  }
   keys_ = csv_->next();
 }
 CSVReader::CSVReader(
@@ -53,6 +58,15 @@ Sample CSVReader::next() const {
   return sample;
 }
 
+int64_t CSVReader::skip(int64_t n) const {
+  std::unique_lock lock(mutex_);
+  int64_t skipped = 0;
+  while (skipped < n && csv_->skip()) {
+    skipped++;
+  }
+  return skipped;
+}
+
 CSVReaderFromKey::CSVReaderFromKey(
     std::shared_ptr<Stream> stream,
     const std::string& key,
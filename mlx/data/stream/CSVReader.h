@@ -28,6 +28,7 @@ class CSVReader : public Stream {
       char quote = '"',
       std::shared_ptr<core::FileFetcherHandle> file_handle = nullptr);
   virtual Sample next() const override;
+  virtual int64_t skip(int64_t n) const override;
   void reset() override;
 
  private:
@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 
+#include "mlx/data/core/ThreadPool.h"
 #include "mlx/data/stream/Compose.h"
 
 namespace mlx {
@@ -29,20 +30,22 @@ bool Compose::next_stream_() const {
 Sample Compose::next() const {
   // note: composedStream_ is read by many threads
   // and written by one thread once in a while
-  std::shared_lock slock(mutex_);
+  std::shared_lock slock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(slock);
 
   // Composed stream is not created yet
   if (composedStream_ == nullptr) {
     slock.unlock();
     {
-      std::unique_lock ulock(mutex_);
+      std::unique_lock ulock(mutex_, std::defer_lock);
+      core::ThreadPool::lock(ulock);
       if (!composedStream_) {
         if (!next_stream_()) {
           return Sample(); // EOF
         }
       }
     }
-    slock.lock();
+    core::ThreadPool::lock(slock);
   }
 
   Sample sample;
@@ -51,7 +54,8 @@ Sample Compose::next() const {
     if (sample.empty()) {
       slock.unlock();
       {
-        std::unique_lock ulock(mutex_);
+        std::unique_lock ulock(mutex_, std::defer_lock);
+        core::ThreadPool::lock(ulock);
         // maybe we got the lock after the stream was updated
         sample = composedStream_->next();
         if (sample.empty()) {
@@ -61,15 +65,55 @@ Sample Compose::next() const {
           sample = composedStream_->next();
         }
       }
-      slock.lock();
+      core::ThreadPool::lock(slock);
     }
   }
 
   return sample;
 }
 
+int64_t Compose::skip(int64_t n) const {
+  std::shared_lock slock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(slock);
+
+  if (composedStream_ == nullptr) {
+    slock.unlock();
+    {
+      std::unique_lock ulock(mutex_, std::defer_lock);
+      core::ThreadPool::lock(ulock);
+      if (!composedStream_) {
+        if (!next_stream_()) {
+          return 0; // EOF
+        }
+      }
+    }
+    core::ThreadPool::lock(slock);
+  }
+
+  int64_t skipped = composedStream_->skip(n);
+  while (skipped < n) {
+    slock.unlock();
+    {
+      std::unique_lock ulock(mutex_, std::defer_lock);
+      core::ThreadPool::lock(ulock);
+      // maybe we got the lock after the stream was updated
+      skipped += composedStream_->skip(n - skipped);
+      if (skipped < n) {
+        if (!next_stream_()) {
+          return skipped; // EOF
+        }
+        skipped += composedStream_->skip(n - skipped);
+      }
+    }
+    core::ThreadPool::lock(slock);
+  }
+
+  return skipped;
+}
+
 void Compose::reset() {
-  std::unique_lock lock(mutex_);
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
   stream_->reset();
   composedStream_ = nullptr;
 }
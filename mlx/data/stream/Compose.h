@@ -19,6 +19,7 @@ class Compose : public Stream {
       std::function<std::shared_ptr<Stream>(const Sample& sample)> op);
 
   virtual Sample next() const override;
+  virtual int64_t skip(int64_t n) const override;
   virtual void reset() override;
 
  protected:
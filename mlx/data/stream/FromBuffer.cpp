@@ -1,5 +1,7 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+
 #include "mlx/data/stream/FromBuffer.h"
 
 namespace mlx {
@@ -24,6 +26,14 @@ Sample FromBuffer::next() const {
   }
 }
 
+int64_t FromBuffer::skip(int64_t n) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto skipped =
+      std::max<int64_t>(std::min(n, buffer_->size() - currentIdx_), 0);
+  currentIdx_ += skipped;
+  return skipped;
+}
+
 void FromBuffer::reset() {
   std::lock_guard<std::mutex> lock(mutex_);
   currentIdx_ = 0;
@@ -16,6 +16,7 @@ class FromBuffer : public Stream {
   FromBuffer(const std::shared_ptr<buffer::Buffer>& buffer);
 
   virtual Sample next() const override;
+  virtual int64_t skip(int64_t n) const override;
   virtual void reset() override;
 
  private:
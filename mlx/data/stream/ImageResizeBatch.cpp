@@ -0,0 +1,66 @@
+// Copyright © 2023 Apple Inc.
+
+#include "mlx/data/stream/ImageResizeBatch.h"
+#include "mlx/data/buffer/ImageResizeBatch.h"
+
+namespace mlx {
+namespace data {
+namespace stream {
+
+ImageResizeBatch::ImageResizeBatch(
+    const std::shared_ptr<Stream>& stream,
+    int64_t batch_size,
+    const std::string& key,
+    int64_t w,
+    int64_t h,
+    const std::string& filter,
+    int num_threads,
+    const std::unordered_map<std::string, double>& pad_values,
+    const std::unordered_map<std::string, int>& batch_dims)
+    : stream_(stream),
+      batchSize_(batch_size),
+      key_(key),
+      w_(w),
+      h_(h),
+      filter_(core::image::resize_filter(filter)),
+      numThreads_(num_threads),
+      padValues_(pad_values),
+      batchDims_(batch_dims) {
+  if (batch_size <= 0) {
+    throw std::runtime_error("ImageResizeBatch: batch size must be positive");
+  }
+  if (w <= 0 || h <= 0) {
+    throw std::runtime_error("ImageResizeBatch: target size must be positive");
+  }
+}
+
+Sample ImageResizeBatch::next() const {
+  std::vector<Sample> samples;
+  for (int i = 0; i < batchSize_; i++) {
+    auto sample = stream_->next();
+    if (sample.empty()) {
+      break;
+    }
+    samples.push_back(std::move(sample));
+  }
+  if (samples.empty()) {
+    return Sample();
+  }
+  return buffer::ImageResizeBatch::merge_batch(
+      samples,
+      key_,
+      w_,
+      h_,
+      filter_,
+      numThreads_,
+      padValues_,
+      batchDims_);
+}
+
+void ImageResizeBatch::reset() {
+  stream_->reset();
+}
+
+} // namespace stream
+} // namespace data
+} // namespace mlx
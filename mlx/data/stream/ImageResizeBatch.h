@@ -0,0 +1,42 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include "mlx/data/core/image/Image.h"
+#include "mlx/data/stream/Stream.h"
+
+namespace mlx {
+namespace data {
+namespace stream {
+
+/// See buffer::ImageResizeBatch.
+class ImageResizeBatch : public Stream {
+ public:
+  ImageResizeBatch(
+      const std::shared_ptr<Stream>& stream,
+      int64_t batch_size,
+      const std::string& key,
+      int64_t w,
+      int64_t h,
+      const std::string& filter = "bilinear",
+      int num_threads = 0,
+      const std::unordered_map<std::string, double>& pad_values = {},
+      const std::unordered_map<std::string, int>& batch_dims = {});
+  virtual Sample next() const override;
+  virtual void reset() override;
+
+ private:
+  std::shared_ptr<Stream> stream_;
+  int64_t batchSize_;
+  std::string key_;
+  int64_t w_;
+  int64_t h_;
+  core::image::ResizeFilter filter_;
+  int numThreads_;
+  std::unordered_map<std::string, double> padValues_;
+  std::unordered_map<std::string, int> batchDims_;
+};
+
+} // namespace stream
+} // namespace data
+} // namespace mlx
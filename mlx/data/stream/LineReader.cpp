@@ -3,6 +3,7 @@
 #include "mlx/data/stream/LineReader.h"
 #include "mlx/data/core/imemstream.h"
 
+#include <limits>
 #include <streambuf>
 
 namespace mlx {
@@ -18,6 +19,10 @@ LineReader::LineReader(
   if (fetcher) {
     fileHandle_ = fetcher->fetch(filename);
   }
+  if (fileHandle_ && fileHandle_->data()) {
+    init_(std::make_shared<core::imemstream>(fileHandle_->data()), unzip);
+    return;
+  }
   auto file_path = local_prefix / filename;
   init_(
       std::make_shared<std::ifstream>(
@@ -70,6 +75,17 @@ Sample LineReader::next() const {
   return sample;
 }
 
+int64_t LineReader::skip(int64_t n) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& f = (uf_ ? *uf_ : *f_);
+  int64_t skipped = 0;
+  while (skipped < n && f.peek() != std::istream::traits_type::eof()) {
+    f.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    skipped++;
+  }
+  return skipped;
+}
+
 LineReaderFromKey::LineReaderFromKey(
     std::shared_ptr<Stream> stream,
     const std::string& key,
@@ -30,6 +30,7 @@ class LineReader : public Stream {
       bool unzip = false,
       std::shared_ptr<core::FileFetcherHandle> file_handle = nullptr);
   virtual Sample next() const override;
+  virtual int64_t skip(int64_t n) const override;
   void reset() override;
 
  private:
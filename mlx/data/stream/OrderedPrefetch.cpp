@@ -11,7 +11,7 @@ OrderedPrefetch::OrderedPrefetch(
     int prefetch_size,
     int num_thread)
     : buffer_(buffer),
-      pool_(std::make_shared<core::ThreadPool>(num_thread)),
+      pool_(std::make_shared<core::TaskGroup>(num_thread)),
       prefetchSize_(prefetch_size),
       currentIdx_(0) {
   if (prefetchSize_ <= 0) {
@@ -53,7 +53,7 @@ Sample OrderedPrefetch::next() const {
           pool_->enqueue([b = buffer_, next_idx] { return b->get(next_idx); });
     }
     lock.unlock();
-    return fsample.get();
+    return core::ThreadPool::get(fsample);
   }
 }
 
@@ -6,7 +6,7 @@
 #include <mutex>
 
 #include "mlx/data/buffer/Buffer.h"
-#include "mlx/data/core/ThreadPool.h"
+#include "mlx/data/core/TaskGroup.h"
 #include "mlx/data/stream/Stream.h"
 
 namespace mlx {
@@ -26,7 +26,7 @@ class OrderedPrefetch : public Stream {
 
  private:
   std::shared_ptr<buffer::Buffer> buffer_;
-  std::shared_ptr<core::ThreadPool> pool_;
+  std::shared_ptr<core::TaskGroup> pool_;
   int64_t prefetchSize_;
   mutable int64_t currentIdx_;
   mutable std::vector<std::future<Sample>> prefetchCache_;
@@ -1,5 +1,6 @@
 // Copyright © 2023 Apple Inc.
 
+#include "mlx/data/core/ThreadPool.h"
 #include "mlx/data/stream/Partition.h"
 
 namespace mlx {
@@ -21,21 +22,21 @@ Partition::Partition(
 }
 
 Sample Partition::next() const {
-  std::unique_lock lock(stream_mutex_);
-
-  Sample res;
-  for (int i = 0; i < numPartitions_; i++) {
-    auto sample = stream_->next();
-    if (i == partition_) {
-      res = std::move(sample);
-    }
-  }
+  std::unique_lock lock(stream_mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
+
+  // Let the underlying stream skip the samples of the other partitions, such
+  // that sources (and transforms over them) do not materialize them.
+  stream_->skip(partition_);
+  auto res = stream_->next();
+  stream_->skip(numPartitions_ - partition_ - 1);
 
   return res;
 }
 
 void Partition::reset() {
-  std::unique_lock lock(stream_mutex_);
+  std::unique_lock lock(stream_mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
   stream_->reset();
 }
 
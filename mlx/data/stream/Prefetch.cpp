@@ -11,7 +11,7 @@ Prefetch::Prefetch(
     int prefetch_size,
     int num_thread)
     : stream_(stream),
-      pool_(std::make_shared<core::ThreadPool>(num_thread)),
+      pool_(std::make_shared<core::TaskGroup>(num_thread)),
       prefetchSize_(prefetch_size) {
   if (prefetchSize_ < 0) {
     throw std::runtime_error("Prefetch: prefetch size must be positive");
@@ -19,15 +19,17 @@ Prefetch::Prefetch(
 }
 
 Prefetch::~Prefetch() {
-  std::unique_lock lock(mutex_);
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
   while (prefetchCache_.size()) {
-    prefetchCache_.front().get();
+    core::ThreadPool::get(prefetchCache_.front());
     prefetchCache_.pop();
   }
 }
 
 Sample Prefetch::next() const {
-  std::unique_lock lock(mutex_);
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
 
   // First time we are called so enqueue all the fetching
   if (prefetchCache_.size() < prefetchSize_) {
@@ -45,7 +47,7 @@ Sample Prefetch::next() const {
     fsample = std::move(prefetchCache_.front());
     prefetchCache_.pop();
     prefetchCache_.emplace(pool_->enqueue([s = stream_] { return s->next(); }));
-    res = fsample.get();
+    res = core::ThreadPool::get(fsample);
 
     if (!res.empty()) {
       break;
@@ -56,10 +58,11 @@ Sample Prefetch::next() const {
 }
 
 void Prefetch::reset() {
-  std::unique_lock lock(mutex_);
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
 
   while (prefetchCache_.size()) {
-    prefetchCache_.front().get();
+    core::ThreadPool::get(prefetchCache_.front());
     prefetchCache_.pop();
   }
   stream_->reset();
@@ -4,8 +4,9 @@
 
 #include <atomic>
 #include <mutex>
+#include <queue>
 
-#include "mlx/data/core/ThreadPool.h"
+#include "mlx/data/core/TaskGroup.h"
 #include "mlx/data/stream/Stream.h"
 
 namespace mlx {
@@ -25,7 +26,7 @@ class Prefetch : public Stream {
 
  private:
   std::shared_ptr<Stream> stream_;
-  std::shared_ptr<core::ThreadPool> pool_;
+  std::shared_ptr<core::TaskGroup> pool_;
   int prefetchSize_;
   mutable std::queue<std::future<Sample>> prefetchCache_;
   mutable std::mutex mutex_;
@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 
+#include "mlx/data/core/ThreadPool.h"
 #include "mlx/data/stream/Repeat.h"
 
 namespace mlx {
@@ -14,14 +15,16 @@ Repeat::Repeat(const std::shared_ptr<Stream>& stream, int64_t num_time)
 Sample Repeat::next() const {
   Sample sample;
   {
-    std::shared_lock slock(stream_reset_mutex_);
+    std::shared_lock slock(stream_reset_mutex_, std::defer_lock);
+    core::ThreadPool::lock(slock);
     sample = stream_->next();
   }
 
   // Empty sample we may need to reset the underlying stream
   if (sample.empty()) {
     {
-      std::unique_lock lock(stream_reset_mutex_);
+      std::unique_lock lock(stream_reset_mutex_, std::defer_lock);
+      core::ThreadPool::lock(lock);
 
       // Get another sample in case someone else reset the stream in the
       // meantime.
@@ -47,7 +50,8 @@ Sample Repeat::next() const {
 }
 
 void Repeat::reset() {
-  std::unique_lock ulock(stream_reset_mutex_);
+  std::unique_lock ulock(stream_reset_mutex_, std::defer_lock);
+  core::ThreadPool::lock(ulock);
   stream_->reset();
   numDone_ = 0;
 }
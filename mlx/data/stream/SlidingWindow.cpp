@@ -2,6 +2,7 @@
 
 #include <iterator>
 
+#include "mlx/data/core/ThreadPool.h"
 #include "mlx/data/stream/SlidingWindow.h"
 
 namespace mlx {
@@ -29,7 +30,8 @@ SlidingWindow::SlidingWindow(
 }
 
 Sample SlidingWindow::next() const {
-  std::unique_lock lock(mutex_);
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
 
   // Check if we already created some samples in which case simply return
   // the first one.
@@ -80,7 +82,8 @@ Sample SlidingWindow::next() const {
 }
 
 void SlidingWindow::reset() {
-  std::unique_lock lock(mutex_);
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
   buffer_ = std::queue<Sample>();
   stream_->reset();
 }
@@ -12,6 +12,14 @@ Sample Stream::next() const {
   throw std::runtime_error("Stream::next() NYI");
 }
 
+int64_t Stream::skip(int64_t n) const {
+  int64_t skipped = 0;
+  while (skipped < n && !next().empty()) {
+    skipped++;
+  }
+  return skipped;
+}
+
 void Stream::reset() {
   throw std::runtime_error("Stream::reset() NYI");
 }
@@ -19,6 +19,11 @@ class Stream {
   // fetch next sample
   virtual Sample next() const;
 
+  // skip the next n samples and return how many were skipped (less than n
+  // if the stream got exhausted). By default it simply calls next(), sources
+  // override it to avoid materializing the skipped samples.
+  virtual int64_t skip(int64_t n) const;
+
   // reset the stream
   virtual void reset();
 
@@ -0,0 +1,109 @@
+// Copyright © 2023 Apple Inc.
+
+#include "mlx/data/stream/TARReader.h"
+#include "mlx/data/core/imemstream.h"
+
+namespace mlx {
+namespace data {
+namespace stream {
+TARReader::TARReader(
+    const std::string& filename,
+    const std::filesystem::path& local_prefix,
+    std::shared_ptr<core::FileFetcher> fetcher) {
+  if (fetcher) {
+    fileHandle_ = fetcher->fetch(filename);
+  }
+  if (fileHandle_ && fileHandle_->data()) {
+    tar_ = std::make_unique<core::TARStreamReader>(
+        std::make_shared<core::imemstream>(fileHandle_->data()));
+  } else {
+    auto file_path = local_prefix / filename;
+    tar_ = std::make_unique<core::TARStreamReader>(file_path.string());
+  }
+}
+TARReader::TARReader(
+    const std::shared_ptr<std::istream>& f,
+    std::shared_ptr<core::FileFetcherHandle> file_handle)
+    : fileHandle_(file_handle) {
+  tar_ = std::make_unique<core::TARStreamReader>(f);
+}
+void TARReader::reset() {
+  std::unique_lock lock(mutex_);
+  tar_->reset();
+  hasPending_ = false;
+}
+
+// Must be called with mutex_ held. The file following the group has been
+// moved to already (but not read) and is kept in pending_.
+Sample TARReader::next_(bool read) const {
+  Sample sample;
+  std::string key;
+  while (true) {
+    if (!hasPending_) {
+      if (!tar_->next(pending_)) {
+        break;
+      }
+      hasPending_ = true;
+    }
+
+    auto slash = pending_.rfind('/');
+    auto dot = pending_.find('.', (slash == std::string::npos) ? 0 : slash + 1);
+    if (dot == std::string::npos) {
+      // no extension, no key to put it into
+      hasPending_ = false;
+      continue;
+    }
+    auto name = pending_.substr(0, dot);
+    auto ext = pending_.substr(dot + 1);
+    if (sample.empty()) {
+      key = name;
+    } else if (name != key || sample.count(ext)) {
+      break;
+    }
+    sample[ext] = read ? tar_->read() : nullptr;
+    hasPending_ = false;
+  }
+  if (!sample.empty()) {
+    sample["__key__"] = std::make_shared<Array>(key);
+  }
+  return sample;
+}
+
+Sample TARReader::next() const {
+  std::unique_lock lock(mutex_);
+  return next_(true);
+}
+
+int64_t TARReader::skip(int64_t n) const {
+  std::unique_lock lock(mutex_);
+  int64_t skipped = 0;
+  while (skipped < n && !next_(false).empty()) {
+    skipped++;
+  }
+  return skipped;
+}
+
+TARReaderFromKey::TARReaderFromKey(
+    std::shared_ptr<Stream> stream,
+    const std::string& key,
+    bool fromMemory,
+    const std::filesystem::path& local_prefix,
+    std::shared_ptr<core::FileFetcher> fetcher)
+    : Compose(stream, [=](const Sample& sample) {
+        if (fromMemory) {
+          auto array =
+              sample::check_key(sample, key, mlx::data::ArrayType::UInt8);
+          auto ms = std::make_shared<core::imemstream>(array);
+          return std::make_shared<TARReader>(ms);
+        } else {
+          auto array =
+              sample::check_key(sample, key, mlx::data::ArrayType::Int8);
+          std::string filename(
+              reinterpret_cast<char*>(array->data()), array->size());
+          return std::make_shared<TARReader>(filename, local_prefix, fetcher);
+        }
+      }) {}
+
+} // namespace stream
+} // namespace data
+} // namespace mlx
@@ -0,0 +1,57 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include <filesystem>
+#include <istream>
+#include <mutex>
+
+#include "mlx/data/core/FileFetcher.h"
+#include "mlx/data/core/TARReader.h"
+#include "mlx/data/stream/Compose.h"
+#include "mlx/data/stream/Stream.h"
+
+namespace mlx {
+namespace data {
+namespace stream {
+
+// Reads a TAR archive sequentially and groups consecutive files sharing the
+// same name up to the first dot of their basename (e.g. dir/000123.jpg and
+// dir/000123.json) in one sample. Each file goes to the key given by its
+// extension (jpg and json), and the common name to the key "__key__".
+class TARReader : public Stream {
+ public:
+  TARReader(
+      const std::string& filename,
+      const std::filesystem::path& local_prefix = "",
+      std::shared_ptr<core::FileFetcher> fetcher = nullptr);
+  TARReader(
+      const std::shared_ptr<std::istream>& f,
+      std::shared_ptr<core::FileFetcherHandle> file_handle = nullptr);
+  virtual Sample next() const override;
+  virtual int64_t skip(int64_t n) const override;
+  void reset() override;
+
+ private:
+  Sample next_(bool read) const;
+
+  std::unique_ptr<core::TARStreamReader> tar_;
+  std::shared_ptr<core::FileFetcherHandle> fileHandle_;
+  mutable std::string pending_;
+  mutable bool hasPending_ = false;
+  mutable std::mutex mutex_;
+};
+
+class TARReaderFromKey : public Compose {
+ public:
+  TARReaderFromKey(
+      std::shared_ptr<Stream> stream,
+      const std::string& key,
+      bool from_memory = false,
+      const std::filesystem::path& local_prefix = "",
+      std::shared_ptr<core::FileFetcher> fetcher = nullptr);
+};
+
+} // namespace stream
+} // namespace data
+} // namespace mlx
@@ -19,6 +19,21 @@ Transform::Transform(
     : stream_(stream), ops_(ops) {};
 
 Sample Transform::next() const {
+  return next_(ops_.size());
+}
+
+std::shared_ptr<op::KeyTransformOp> Transform::last_key_transform() const {
+  if (ops_.empty()) {
+    return nullptr;
+  }
+  return std::dynamic_pointer_cast<op::KeyTransformOp>(ops_.back());
+}
+
+Sample Transform::next_partial() const {
+  return next_(ops_.size() - 1);
+}
+
+Sample Transform::next_(int64_t num_ops) const {
   // Process the stream untill it is either exhausted or a sample is
   // generated. While doing so mark the skipped elements.
   Sample res;
@@ -33,8 +48,8 @@ Sample Transform::next() const {
 
     // Got a sample let's transform it
     res = sample;
-    for (auto& op : ops_) {
-      res = op->apply(res);
+    for (int64_t i = 0; i < num_ops; i++) {
+      res = ops_[i]->apply(res);
 
       // Hmm we should skip it
       if (res.empty()) {
@@ -46,6 +61,17 @@ Sample Transform::next() const {
   return res;
 }
 
+int64_t Transform::skip(int64_t n) const {
+  // Samples can be skipped upstream without transforming them only if no op
+  // would have dropped them.
+  for (auto& op : ops_) {
+    if (op->may_return_empty()) {
+      return Stream::skip(n);
+    }
+  }
+  return stream_->skip(n);
+}
+
 void Transform::reset() {
   stream_->reset();
 }
@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "mlx/data/op/KeyTransform.h"
 #include "mlx/data/op/Op.h"
 #include "mlx/data/stream/Stream.h"
 
@@ -23,11 +24,23 @@ class Transform : public Stream {
       const std::vector<std::shared_ptr<op::Op>>& ops);
 
   virtual Sample next() const override;
+  virtual int64_t skip(int64_t n) const override;
   virtual void reset() override;
 
+  /// The last op if it is a KeyTransformOp, nullptr otherwise. Batch then
+  /// applies it itself with next_partial(), such that it can write its
+  /// output in place into the batch (see op::KeyTransformOp::apply_batch()).
+  std::shared_ptr<op::KeyTransformOp> last_key_transform() const;
+
+  /// Returns the next sample transformed by all the ops but the last one.
+  Sample next_partial() const;
+
  protected:
   std::shared_ptr<Stream> stream_;
   std::vector<std::shared_ptr<op::Op>> ops_;
+
+ private:
+  Sample next_(int64_t num_ops) const;
 };
 
 } // namespace stream
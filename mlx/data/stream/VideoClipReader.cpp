@@ -0,0 +1,197 @@
+// Copyright © 2023 Apple Inc.
+
+#include <algorithm>
+#include <cstring>
+
+#include "mlx/data/core/ThreadPool.h"
+#include "mlx/data/core/video/VideoPrivate.h"
+#include "mlx/data/stream/VideoClipReader.h"
+
+namespace mlx {
+namespace data {
+namespace stream {
+VideoClipReader::VideoClipReader(
+    const std::string& filename,
+    const std::string& key,
+    int64_t clip_length,
+    int64_t stride,
+    const std::string& index_key,
+    const core::video::VideoDecodeOptions& options,
+    const std::filesystem::path& local_prefix,
+    std::shared_ptr<core::FileFetcher> fetcher,
+    const Sample& sample)
+    : filename_(filename), key_(key), indexKey_(index_key), sample_(sample) {
+  init_(clip_length, stride);
+  if (fetcher) {
+    fileHandle_ = fetcher->fetch(filename);
+  }
+  if (fileHandle_ && fileHandle_->data()) {
+    reader_ = std::make_unique<core::video::VideoReader>(
+        fileHandle_->data(), options);
+  } else {
+    auto file_path = local_prefix / filename;
+    reader_ = std::make_unique<core::video::VideoReader>(
+        file_path.string(), options);
+  }
+}
+VideoClipReader::VideoClipReader(
+    const std::shared_ptr<const Array>& contents,
+    const std::string& key,
+    int64_t clip_length,
+    int64_t stride,
+    const std::string& index_key,
+    const core::video::VideoDecodeOptions& options,
+    const Sample& sample)
+    : key_(key), indexKey_(index_key), sample_(sample) {
+  init_(clip_length, stride);
+  reader_ = std::make_unique<core::video::VideoReader>(contents, options);
+}
+VideoClipReader::~VideoClipReader() = default;
+
+void VideoClipReader::init_(int64_t clip_length, int64_t stride) {
+  if (clip_length <= 0) {
+    throw std::runtime_error(
+        "VideoClipReader: clip length must be strictly positive");
+  }
+  clipLength_ = clip_length;
+  stride_ = (stride > 0) ? stride : clip_length;
+  numFrames_ = 0;
+  numDecoded_ = 0;
+  clipStart_ = 0;
+  position_ = 0;
+  clipIndex_ = 0;
+  finished_ = false;
+}
+
+// Must be called with mutex_ held. Decodes the missing frames of the clip,
+// returns false if the video ended before.
+bool VideoClipReader::fill_window_() const {
+  if (!window_) {
+    auto info = reader_->info();
+    numFrames_ = info.frames;
+    window_ = std::make_shared<Array>(
+        ArrayType::UInt8, clipLength_, info.height, info.width, 3);
+  }
+  if (numDecoded_ == 0 && position_ != clipStart_) {
+    reader_->seek(clipStart_);
+    position_ = clipStart_;
+  }
+  while (numDecoded_ < clipLength_) {
+    if (reader_->read_frame(array::slice(window_, numDecoded_)) == nullptr) {
+      finished_ = true;
+      return false;
+    }
+    numDecoded_++;
+    position_++;
+  }
+  return true;
+}
+
+// Must be called with mutex_ held. Moves to the next clip, keeping the
+// decoded frames it shares with the current one.
+void VideoClipReader::advance_() const {
+  int64_t kept = numDecoded_ - stride_;
+  if (kept > 0) {
+    auto data = static_cast<uint8_t*>(window_->data());
+    int64_t frame_size = window_->size() / clipLength_;
+    std::memmove(data, data + stride_ * frame_size, kept * frame_size);
+  }
+  numDecoded_ = std::max<int64_t>(kept, 0);
+  clipStart_ += stride_;
+  clipIndex_++;
+}
+
+Sample VideoClipReader::next() const {
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
+
+  if (finished_ || !fill_window_()) {
+    return Sample(); // EOF
+  }
+  auto sample = sample_;
+  sample[key_] = array::clone(window_);
+  if (!indexKey_.empty()) {
+    sample[indexKey_] = std::make_shared<Array>(clipIndex_);
+  }
+  advance_();
+  return sample;
+}
+
+int64_t VideoClipReader::skip(int64_t n) const {
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
+
+  int64_t skipped = 0;
+  while (skipped < n && !finished_) {
+    // the clips within the announced length are skipped without decoding
+    // anything, past it we make sure they exist
+    if (!window_ || clipStart_ + clipLength_ > numFrames_) {
+      if (!fill_window_()) {
+        break;
+      }
+    }
+    advance_();
+    skipped++;
+  }
+  return skipped;
+}
+
+void VideoClipReader::reset() {
+  std::unique_lock lock(mutex_, std::defer_lock);
+  core::ThreadPool::lock(lock);
+  // rewind the decoder, which may be past the end of the video
+  reader_->seek(0);
+  position_ = 0;
+  numDecoded_ = 0;
+  clipStart_ = 0;
+  clipIndex_ = 0;
+  finished_ = false;
+}
+
+VideoClipReaderFromKey::VideoClipReaderFromKey(
+    std::shared_ptr<Stream> stream,
+    const std::string& key,
+    const std::string& dstKey,
+    int64_t clipLength,
+    int64_t stride,
+    bool fromMemory,
+    const std::string& indexKey,
+    const core::video::VideoDecodeOptions& options,
+    const std::filesystem::path& local_prefix,
+    std::shared_ptr<core::FileFetcher> fetcher)
+    : Compose(stream, [=](const Sample& sample) {
+        if (fromMemory) {
+          auto array =
+              sample::check_key(sample, key, mlx::data::ArrayType::UInt8);
+          // the clips do not carry the encoded video along
+          auto clip_sample = sample;
+          clip_sample.erase(key);
+          return std::make_shared<VideoClipReader>(
+              array,
+              dstKey,
+              clipLength,
+              stride,
+              indexKey,
+              options,
+              clip_sample);
+        } else {
+          auto array =
+              sample::check_key(sample, key, mlx::data::ArrayType::Int8);
+          std::string filename(
+              reinterpret_cast<char*>(array->data()), array->size());
+          return std::make_shared<VideoClipReader>(
+              filename,
+              dstKey,
+              clipLength,
+              stride,
+              indexKey,
+              options,
+              local_prefix,
+              fetcher,
+              sample);
+        }
+      }) {}
+
+} // namespace stream
+} // namespace data
+} // namespace mlx
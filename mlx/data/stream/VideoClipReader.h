@@ -0,0 +1,102 @@
+// Copyright © 2023 Apple Inc.
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+
+#include "mlx/data/core/FileFetcher.h"
+#include "mlx/data/core/video/Video.h"
+#include "mlx/data/stream/Compose.h"
+#include "mlx/data/stream/Stream.h"
+
+namespace mlx {
+namespace data {
+namespace core {
+namespace video {
+class VideoReader;
+} // namespace video
+} // namespace core
+
+namespace stream {
+
+// Decodes a video incrementally and yields one sample per clip of
+// clip_length consecutive frames, the clips starting every stride frames. Only
+// the current clip and the decoder state are kept in memory: the frames shared
+// with the previous clip are moved rather than decoded again and the frames
+// between two clips are skipped with a seek when they do not overlap. The
+// last clip is dropped if the video ends before it is complete.
+//
+// The samples are copies of the given sample with the clip, a (clip_length,
+// h, w, 3) array, in key and its index in index_key (if not empty).
+class VideoClipReader : public Stream {
+ public:
+  VideoClipReader(
+      const std::string& filename,
+      const std::string& key,
+      int64_t clip_length,
+      int64_t stride = 0, // clip_length if <= 0
+      const std::string& index_key = "",
+      const core::video::VideoDecodeOptions& options = {},
+      const std::filesystem::path& local_prefix = "",
+      std::shared_ptr<core::FileFetcher> fetcher = nullptr,
+      const Sample& sample = Sample());
+  VideoClipReader(
+      const std::shared_ptr<const Array>& contents,
+      const std::string& key,
+      int64_t clip_length,
+      int64_t stride = 0, // clip_length if <= 0
+      const std::string& index_key = "",
+      const core::video::VideoDecodeOptions& options = {},
+      const Sample& sample = Sample());
+  ~VideoClipReader();
+
+  virtual Sample next() const override;
+  virtual int64_t skip(int64_t n) const override;
+  void reset() override;
+
+ private:
+  void init_(int64_t clip_length, int64_t stride);
+  bool fill_window_() const;
+  void advance_() const;
+
+  std::string filename_;
+  std::string key_;
+  int64_t clipLength_;
+  int64_t stride_;
+  std::string indexKey_;
+  Sample sample_;
+  std::shared_ptr<core::FileFetcherHandle> fileHandle_;
+  std::unique_ptr<core::video::VideoReader> reader_;
+
+  mutable std::mutex mutex_;
+  // Number of frames announced by the video metadata.
+  mutable int64_t numFrames_;
+  // The clip being decoded, its first numDecoded_ frames are already there.
+  mutable std::shared_ptr<Array> window_;
+  mutable int64_t numDecoded_;
+  // Index of the first frame of the clip and of the next frame read.
+  mutable int64_t clipStart_;
+  mutable int64_t position_;
+  mutable int64_t clipIndex_;
+  mutable bool finished_;
+};
+
+class VideoClipReaderFromKey : public Compose {
+ public:
+  VideoClipReaderFromKey(
+      std::shared_ptr<Stream> stream,
+      const std::string& key,
+      const std::string& dst_key,
+      int64_t clip_length,
+      int64_t stride = 0,
+      bool from_memory = false,
+      const std::string& index_key = "",
+      const core::video::VideoDecodeOptions& options = {},
+      const std::filesystem::path& local_prefix = "",
+      std::shared_ptr<core::FileFetcher> fetcher = nullptr);
+};
+
+} // namespace stream
+} // namespace data
+} // namespace mlx
@@ -143,6 +143,43 @@ void init_mlx_data_buffer(py::module& m) {
                   pad (dict): The values to use for padding for each key in the samples.
                   dim (dict): The dimension to concatenate over.
               )pbdoc")
+          .def(
+              "image_resize_batch",
+              &Buffer::image_resize_batch,
+              py::call_guard<py::gil_scoped_release>(),
+              py::arg("batch_size"),
+              py::arg("key"),
+              py::arg("w"),
+              py::arg("h"),
+              py::arg("filter") = "bilinear",
+              py::arg("num_threads") = 0,
+              py::arg("pad") = std::unordered_map<std::string, double>(),
+              py::arg("dim") = std::unordered_map<std::string, int>(),
+              R"pbdoc(
+                Creates batches like :meth:`Buffer.batch` but resizes the
+                images in ``key`` (which can have different sizes) to ``w``
+                by ``h`` directly into the batch array.
+
+                The rows of the whole batch are resized in parallel on the
+                shared thread pool and the filter coefficients are computed
+                once per source size, which makes it faster than resizing
+                each sample with :meth:`Buffer.image_resize` before batching.
+                The filters are widened when downscaling (antialiasing).
+
+                Args:
+                  batch_size (int): How many samples to gather in a batch.
+                  key (str): The sample key that contains the images.
+                  w (int): The target width.
+                  h (int): The target height.
+                  filter (str): One of ``'box'``, ``'bilinear'``,
+                    ``'bicubic'`` or ``'lanczos'``. (default: ``'bilinear'``)
+                  num_threads (int): The maximum number of threads resizing
+                    a batch, 0 meaning the number of cores. (default: 0)
+                  pad (dict): The values to use for padding for the other
+                    keys in the samples.
+                  dim (dict): The dimension to concatenate over for the other
+                    keys.
+              )pbdoc")
           .def(
               "dynamic_batch",
               [](const Buffer& b,
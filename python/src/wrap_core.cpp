@@ -2,21 +2,30 @@
 
 #include "wrap.h"
 
-#if MLX_HAS_AWS
 #include <pybind11/functional.h>
 #include <pybind11/stl/filesystem.h>
+
+#if MLX_HAS_AWS
 #include "mlx/data/core/AWSFileFetcher.h"
 #endif
+#if MLX_HAS_CURL
+#include "mlx/data/core/HTTPFileFetcher.h"
+#endif
 
 #include "mlx/data/core/BPETokenizer.h"
 #include "mlx/data/core/FileFetcher.h"
 #include "mlx/data/core/Graph.h"
 #include "mlx/data/core/Levenshtein.h"
+#include "mlx/data/core/LocalFileFetcher.h"
 #include "mlx/data/core/State.h"
+#include "mlx/data/core/TARReader.h"
+#include "mlx/data/core/ThreadPool.h"
 #include "mlx/data/core/Tokenizer.h"
 #include "mlx/data/core/Trie.h"
+#include "mlx/data/core/URLFileFetcher.h"
 #include "mlx/data/core/Utils.h"
 #include "mlx/data/core/Version.h"
+#include "mlx/data/core/image/ImageCache.h"
 
 #include <cstring>
 
@@ -43,6 +52,49 @@ void init_mlx_data_core(py::module& m) {
 
   m.def("set_state", &set_state, py::arg("seed") = 1234);
 
+  m.def(
+      "set_global_thread_count",
+      &ThreadPool::set_global_thread_count,
+      py::arg("num_threads"),
+      R"pbcopy(
+        Set the number of threads of the process-wide pool.
+
+        All the multi-threaded stages (prefetch, buffered, file fetchers, etc)
+        run on a shared pool of worker threads, their ``num_threads`` argument
+        only limiting how many of their tasks run at the same time. The pool
+        defaults to one thread per core.
+
+        Only stages created after this call use the new pool.
+
+        Args:
+          num_threads (int): The number of threads of the pool. 0 means one
+            thread per core.
+      )pbcopy");
+
+  m.def(
+      "build_tar_index",
+      &TARReader::build_index,
+      py::arg("tarfiles"),
+      py::arg("nested") = false,
+      py::arg("num_threads") = 1,
+      R"pbcopy(
+        Index tar archives and write the index next to each archive.
+
+        Opening a tar archive (e.g. with :func:`files_from_tar` or
+        :meth:`Buffer.read_from_tar`) normally scans all its headers. If a
+        file ``<tarfile>.idx`` exists, and the archive was not modified since,
+        the index is loaded from it instead. Readers that scan an archive also
+        try to write that file, this function writes it ahead of time (and
+        fails if it cannot).
+
+        Args:
+          tarfiles (list of str): The paths to the tar archives to be indexed.
+          nested (bool): Index archives in archives, which must match the
+            ``nested`` argument used when reading. (default: False)
+          num_threads (int): How many archives to index in parallel.
+            (default: 1)
+      )pbcopy");
+
   m.def(
       "uniq", [](py::array& psrc, py::array& psrc_length, int dim, double pad) {
         auto src = mlx::pybind::to_array(psrc);
@@ -366,16 +418,29 @@ void init_mlx_data_core(py::module& m) {
           )pbcopy");
 
   py::class_<FileFetcherHandle, std::shared_ptr<FileFetcherHandle>>(
-      m, "FileFetcherHandle");
+      m, "FileFetcherHandle")
+      .def_property_readonly(
+          "data",
+          [](const FileFetcherHandle& handle) -> py::object {
+            if (!handle.data()) {
+              return py::none();
+            }
+            return mlx::pybind::to_py_array(handle.data());
+          },
+          R"pbcopy(
+          The contents of the file if it was fetched in memory, None otherwise.
+        )pbcopy");
 
   py::class_<FileFetcher, std::shared_ptr<FileFetcher>>(m, "FileFetcher")
       .def(
-          py::init<int, int, int, bool>(),
+          py::init<int, int, int, bool, int64_t, bool>(),
           py::call_guard<py::gil_scoped_release>(),
           py::arg("num_prefetch_max") = 1,
           py::arg("num_prefetch_threads") = 1,
           py::arg("num_kept_files") = 0,
-          py::arg("verbose") = false)
+          py::arg("verbose") = false,
+          py::arg("max_cached_bytes") = 0,
+          py::arg("in_memory") = false)
       .def(
           "prefetch",
           &FileFetcher::prefetch,
@@ -389,7 +454,9 @@ void init_mlx_data_core(py::module& m) {
           files is accessed by ``fetch`` then more of the prefetch file list is
           downloaded.
 
-          At any given point we keep ``num_kept_files`` in the local cache.
+          At any given point we keep ``num_kept_files`` (and at most
+          ``max_cached_bytes``) in the local cache, evicting the least
+          recently fetched files which are not in use.
 
           Args:
             filenames (list[str]): A list of filenames to be prefetched in order.
@@ -422,8 +489,350 @@ void init_mlx_data_core(py::module& m) {
 
           Args:
             filename (str): A file to erase locally.
+        )pbcopy")
+      .def(
+          "stats",
+          [](const FileFetcher& fetcher) {
+            auto stats = fetcher.stats();
+            return std::unordered_map<std::string, int64_t>{
+                {"num_hits", stats.num_hits},
+                {"num_misses", stats.num_misses},
+                {"num_evictions", stats.num_evictions},
+                {"num_cached_files", stats.num_cached_files},
+                {"num_cached_bytes", stats.num_cached_bytes}};
+          },
+          R"pbcopy(
+          Return the statistics of the local cache as a dictionary.
+
+          ``num_hits`` and ``num_misses`` count the calls to ``fetch`` which
+          found the file in the local cache or not (including files still
+          being prefetched), ``num_evictions`` the files evicted from the
+          cache, and ``num_cached_files`` and ``num_cached_bytes`` describe
+          the current content of the cache.
+        )pbcopy");
+
+  py::class_<image::ImageCache, std::shared_ptr<image::ImageCache>>(
+      m, "ImageCache")
+      .def(
+          py::init<int64_t, const std::filesystem::path&, int64_t>(),
+          py::call_guard<py::gil_scoped_release>(),
+          py::arg("max_cached_bytes"),
+          py::arg("spill_path") = "",
+          py::arg("max_spilled_bytes") = 0,
+          R"pbcopy(
+          A cache of decoded images for :meth:`Buffer.load_image`.
+
+          The least recently used images are evicted when the cached images
+          take more than ``max_cached_bytes`` in memory. If ``spill_path`` is
+          provided, evicted images are written instead to a file of at most
+          ``max_spilled_bytes`` mapped in memory (preferably on a local
+          disk). The file is removed right away and its space is released
+          when the cache is destroyed. The space is allocated upfront and
+          images are not spilled if there is not enough free disk space.
+
+          .. code-block:: python
+
+            from mlx.data.core import ImageCache
+
+            cache = ImageCache(8 << 30, "/tmp/images.cache", 64 << 30)
+            dset = dset.load_image(
+                "file", resize_smallest_side=256, cache=cache
+            )
+
+          Args:
+            max_cached_bytes (int): The memory budget of the cache.
+            spill_path (str): The file to spill the evicted images to.
+              (default: '')
+            max_spilled_bytes (int): The maximum size of the spill file.
+              (default: 0)
+        )pbcopy")
+      .def(
+          "stats",
+          [](const image::ImageCache& cache) {
+            auto stats = cache.stats();
+            return std::unordered_map<std::string, int64_t>{
+                {"num_hits", stats.num_hits},
+                {"num_spill_hits", stats.num_spill_hits},
+                {"num_misses", stats.num_misses},
+                {"num_evictions", stats.num_evictions},
+                {"num_cached_images", stats.num_cached_images},
+                {"num_cached_bytes", stats.num_cached_bytes},
+                {"num_spilled_images", stats.num_spilled_images},
+                {"num_spilled_bytes", stats.num_spilled_bytes}};
+          },
+          R"pbcopy(
+          Return the statistics of the cache as a dictionary.
+
+          ``num_hits``, ``num_spill_hits`` and ``num_misses`` count the
+          lookups which found the image in memory, in the spill file or not
+          at all, ``num_evictions`` the images evicted from memory, and the
+          other entries describe the current content of the cache.
         )pbcopy");
 
+  py::class_<
+      LocalFileFetcher,
+      FileFetcher,
+      std::shared_ptr<LocalFileFetcher>>(m, "LocalFileFetcher")
+      .def(
+          py::init([](const std::filesystem::path& prefix,
+                      const std::filesystem::path& local_prefix,
+                      int64_t buffer_size,
+                      int num_threads,
+                      bool preallocate,
+                      int num_prefetch_max,
+                      int num_prefetch_threads,
+                      int num_kept_files,
+                      int64_t max_cached_bytes,
+                      bool in_memory,
+                      bool verbose) {
+            LocalFileFetcherOptions opt = {
+                prefix,
+                local_prefix,
+                buffer_size,
+                num_threads,
+                preallocate,
+                num_prefetch_max,
+                num_prefetch_threads,
+                num_kept_files,
+                max_cached_bytes,
+                in_memory,
+                verbose};
+            return std::make_shared<LocalFileFetcher>(opt);
+          }),
+          py::arg("prefix") = "",
+          py::arg("local_prefix") = "",
+          py::arg("buffer_size") = 64 * 1024 * 1024, // 64 MB
+          py::arg("num_threads") = 4,
+          py::arg("preallocate") = false,
+          py::arg("num_prefetch_max") = 1,
+          py::arg("num_prefetch_threads") = 1,
+          py::arg("num_kept_files") = 0,
+          py::arg("max_cached_bytes") = 0,
+          py::arg("in_memory") = false,
+          py::arg("verbose") = false,
+          R"pbcopy(
+            Make a LocalFileFetcher to copy files from a slow directory (for
+            instance a network file system) to a local cache directory.
+
+            Args:
+              prefix (str): The directory to copy the requested files from. (default: '')
+              local_prefix (str): The local cache directory to copy the files
+                in. It must be different from ``prefix``. (default: '')
+              buffer_size (int): Copy the files in parts of that size. (default: 64MB)
+              num_threads (int): How many parts to copy in parallel for each
+                file. (default: 4)
+              preallocate (bool): Reserve the disk space of each file before
+                copying it. (default: false)
+              num_prefetch_max (int): How many files to prefetch from the prefetch list. (default: 1)
+              num_prefetch_threads (int): How many files to prefetch in parallel from the prefetch list. (default: 1)
+              num_kept_files (int): How many files to keep in the local cache.
+                If 0 we keep everything. (default: 0)
+              max_cached_bytes (int): How many bytes of copied files to keep
+                in the local cache. If 0 there is no limit. (default: 0)
+              in_memory (bool): Read the files in memory instead of copying
+                them in ``local_prefix``. (default: false)
+              verbose (bool): Defines whether the file fetcher should write
+                information messages to the standard output. (default: false)
+          )pbcopy");
+
+#if MLX_HAS_CURL
+  py::class_<HTTPFileFetcher, FileFetcher, std::shared_ptr<HTTPFileFetcher>>(
+      m, "HTTPFileFetcher")
+      .def(
+          py::init([](const std::string& base_url,
+                      const std::filesystem::path& prefix,
+                      const std::filesystem::path& local_prefix,
+                      const std::string& ca_bundle,
+                      bool verify_ssl,
+                      int64_t connect_timeout_ms,
+                      int64_t buffer_size,
+                      int num_threads,
+                      bool preallocate,
+                      int num_prefetch_max,
+                      int num_prefetch_threads,
+                      int num_kept_files,
+                      int64_t max_cached_bytes,
+                      bool in_memory,
+                      bool verbose) {
+            HTTPFileFetcherOptions opt = {
+                prefix,
+                local_prefix,
+                ca_bundle,
+                verify_ssl,
+                connect_timeout_ms,
+                buffer_size,
+                num_threads,
+                preallocate,
+                num_prefetch_max,
+                num_prefetch_threads,
+                num_kept_files,
+                max_cached_bytes,
+                in_memory,
+                verbose};
+            return std::make_shared<HTTPFileFetcher>(base_url, opt);
+          }),
+          py::arg("base_url"),
+          py::arg("prefix") = "",
+          py::arg("local_prefix") = "",
+          py::arg("ca_bundle") = "",
+          py::arg("verify_ssl") = true,
+          py::arg("connect_timeout_ms") = 1000,
+          py::arg("buffer_size") = 64 * 1024 * 1024, // 64 MB
+          py::arg("num_threads") = 4,
+          py::arg("preallocate") = false,
+          py::arg("num_prefetch_max") = 1,
+          py::arg("num_prefetch_threads") = 1,
+          py::arg("num_kept_files") = 0,
+          py::arg("max_cached_bytes") = 0,
+          py::arg("in_memory") = false,
+          py::arg("verbose") = false,
+          R"pbcopy(
+            Make an HTTPFileFetcher to fetch files from an HTTP(S) server with
+            parallel range requests.
+
+            Args:
+              base_url (str): The url the filenames are relative to, for
+                instance ``https://my.server.com/datasets``.
+              prefix (str): The remote prefix to use for all files requested. (default: '')
+              local_prefix (str): The local cache directory to save the downloaded files in. (default: '')
+              ca_bundle (str): The path to a certificate authority file for
+                establishing SSL/TLS connections. (default: '')
+              verify_ssl (bool): Whether we should verify SSL certificates. (default: true)
+              connect_timeout_ms (int): Assume it is a timeout after that many
+                milliseconds. (default: 1000)
+              buffer_size (int): Fetch the files in parts of that size. (default: 64MB)
+              num_threads (int): How many parts to fetch in parallel for each
+                file. Parts are written to disk as soon as they are received so
+                at most ``num_threads * buffer_size`` bytes are held in memory
+                per file. (default: 4)
+              preallocate (bool): Reserve the disk space of each file before
+                downloading it. (default: false)
+              num_prefetch_max (int): How many files to prefetch from the prefetch list. (default: 1)
+              num_prefetch_threads (int): How many files to prefetch in parallel from the prefetch list. (default: 1)
+              num_kept_files (int): How many files to keep in the local cache.
+                If 0 we keep everything. (default: 0)
+              max_cached_bytes (int): How many bytes of downloaded files to
+                keep in the local cache. If 0 there is no limit. (default: 0)
+              in_memory (bool): Keep the fetched files in memory instead of
+                writing them in ``local_prefix``. (default: false)
+              verbose (bool): Defines whether the file fetcher should write
+                information messages to the standard output. (default: false)
+          )pbcopy");
+#endif
+
+  py::class_<URLFileFetcher, FileFetcher, std::shared_ptr<URLFileFetcher>>(
+      m, "URLFileFetcher")
+      .def(
+          py::init([](const std::filesystem::path& local_prefix,
+                      int64_t buffer_size,
+                      int num_threads,
+                      bool preallocate,
+                      int num_prefetch_max,
+                      int num_prefetch_threads,
+                      int num_kept_files,
+                      int64_t max_cached_bytes,
+                      bool in_memory,
+                      bool verbose) {
+            URLFileFetcherOptions opt = {
+                local_prefix,
+                buffer_size,
+                num_threads,
+                preallocate,
+                num_prefetch_max,
+                num_prefetch_threads,
+                num_kept_files,
+                max_cached_bytes,
+                in_memory,
+                verbose};
+            return std::make_shared<URLFileFetcher>(opt);
+          }),
+          py::arg("local_prefix") = "",
+          py::arg("buffer_size") = 64 * 1024 * 1024, // 64 MB
+          py::arg("num_threads") = 4,
+          py::arg("preallocate") = false,
+          py::arg("num_prefetch_max") = 1,
+          py::arg("num_prefetch_threads") = 1,
+          py::arg("num_kept_files") = 0,
+          py::arg("max_cached_bytes") = 0,
+          py::arg("in_memory") = false,
+          py::arg("verbose") = false,
+          R"pbcopy(
+            Make a URLFileFetcher to fetch files given as urls such as
+            ``file:///nfs/data/shard-0.tar``,
+            ``https://my.server.com/data/shard-0.tar`` or
+            ``s3://my-bucket/data/shard-0.tar``.
+
+            Each url is fetched by the fetcher registered for its scheme (see
+            :meth:`register_scheme`), one per scheme and authority, while the
+            local cache and the prefetching are handled by the
+            URLFileFetcher. A file is stored in ``local_prefix / url``, such
+            that the readers find it when given the urls as filenames and the
+            same ``local_prefix``.
+
+            Args:
+              local_prefix (str): The local cache directory to save the fetched files in. (default: '')
+              buffer_size (int): Fetch the files in parts of that size. (default: 64MB)
+              num_threads (int): How many parts to fetch in parallel for each
+                file. (default: 4)
+              preallocate (bool): Reserve the disk space of each file before
+                fetching it. (default: false)
+              num_prefetch_max (int): How many files to prefetch from the prefetch list. (default: 1)
+              num_prefetch_threads (int): How many files to prefetch in parallel from the prefetch list. (default: 1)
+              num_kept_files (int): How many files to keep in the local cache.
+                If 0 we keep everything. (default: 0)
+              max_cached_bytes (int): How many bytes of fetched files to keep
+                in the local cache. If 0 there is no limit. (default: 0)
+              in_memory (bool): Keep the fetched files in memory instead of
+                writing them in ``local_prefix``. (default: false)
+              verbose (bool): Defines whether the file fetcher should write
+                information messages to the standard output. (default: false)
+          )pbcopy")
+      .def_static(
+          "register_scheme",
+          [](const std::string& scheme, py::function factory) {
+            // never released, as it may outlive the interpreter
+            auto f = new py::function(factory);
+            URLFileFetcher::register_scheme(
+                scheme,
+                [f](const std::string& authority,
+                    const std::filesystem::path& local_prefix,
+                    const URLFileFetcherOptions& opt) {
+                  py::gil_scoped_acquire gil;
+                  return (*f)(authority, local_prefix)
+                      .cast<std::shared_ptr<FileFetcher>>();
+                });
+          },
+          py::arg("scheme"),
+          py::arg("factory"),
+          R"pbcopy(
+            Register the fetcher factory of a url scheme, used by the
+            URLFileFetchers created afterwards.
+
+            The factory is called with the authority of the url (for instance
+            the host or the bucket) and the local directory where the files
+            must be stored, and returns a :class:`FileFetcher`. The path of the
+            url is passed to it as filename.
+
+            .. code-block:: python
+
+              URLFileFetcher.register_scheme(
+                  "s3",
+                  lambda bucket, local_prefix: AWSFileFetcher(
+                      bucket, endpoint=MY_ENDPOINT, local_prefix=local_prefix
+                  ),
+              )
+
+            Args:
+              scheme (str): The scheme, for instance ``s3``.
+              factory (callable): The function making the fetchers.
+          )pbcopy")
+      .def_static(
+          "schemes",
+          &URLFileFetcher::schemes,
+          R"pbcopy(
+            Return the list of the registered url schemes.
+          )pbcopy");
+
 #if MLX_HAS_AWS
   py::class_<AWSFileFetcher, FileFetcher, std::shared_ptr<AWSFileFetcher>>(
       m, "AWSFileFetcher")
@@ -448,7 +857,10 @@ void init_mlx_data_core(py::module& m) {
                       const std::string& secret_access_key,
                       const std::string& session_token,
                       const std::string& expiration,
-                      bool verbose) {
+                      bool verbose,
+                      int64_t max_cached_bytes,
+                      bool preallocate,
+                      bool in_memory) {
             AWSFileFetcherOptions opt = {
                 endpoint,
                 region,
@@ -469,7 +881,10 @@ void init_mlx_data_core(py::module& m) {
                 secret_access_key,
                 session_token,
                 expiration,
-                verbose};
+                verbose,
+                max_cached_bytes,
+                preallocate,
+                in_memory};
             return std::make_shared<AWSFileFetcher>(bucket, opt);
           }),
           py::arg("bucket"),
@@ -493,6 +908,9 @@ void init_mlx_data_core(py::module& m) {
           py::arg("session_token") = "",
           py::arg("expiration") = "",
           py::arg("verbose") = false,
+          py::arg("max_cached_bytes") = 0,
+          py::arg("preallocate") = false,
+          py::arg("in_memory") = false,
           R"pbcopy(
             Make an AWSFileFetcher to fetch files from S3.
 
@@ -516,7 +934,10 @@ void init_mlx_data_core(py::module& m) {
               num_connection_max (int): Specifies the maximum number of HTTP
                 connections to the server. (default: 25)
               buffer_size (int): Fetch the files in parts of that size. (default: 100MB)
-              num_threads (int): How many parts to fetch in parallel for each file. (default: 4)
+              num_threads (int): How many parts to fetch in parallel for each
+                file. Parts are written to disk as soon as they are received so
+                at most ``num_threads * buffer_size`` bytes are held in memory
+                per file. (default: 4)
               num_prefetch_max (int): How many files to prefetch from the prefetch list. (default: 1)
               num_prefetch_threads (int): How many files to prefetch in parallel from the prefetch list. (default: 1)
               num_kept_files (int): How many files to keep in the local cache.
@@ -532,6 +953,13 @@ void init_mlx_data_core(py::module& m) {
                 authentication credentials (default: '')
               verbose (bool): Defines whether the file fetcher should write
                 information messages to the standard output. (default: false)
+              max_cached_bytes (int): How many bytes of downloaded files to
+                keep in the local cache. If 0 there is no limit. (default: 0)
+              preallocate (bool): Reserve the disk space of each file before
+                downloading it. (default: false)
+              in_memory (bool): Keep the fetched files in memory instead of
+                writing them in ``local_prefix``. The line, csv and tar readers
+                read them from memory directly. (default: false)
           )pbcopy")
       .def(
           "update_credentials",
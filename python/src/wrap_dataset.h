@@ -160,6 +160,61 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("output_key") = "",
       "Conditional :meth:`Buffer.image_channel_reduction`.");
 
+  base.def(
+      "image_normalize",
+      &T::image_normalize,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("mean"),
+      py::arg("std"),
+      py::arg("channels_first") = false,
+      py::arg("output_key") = "",
+      R"pbdoc(
+        Convert uint8 images to float32 and normalize them per channel.
+
+        The pixel values are first scaled to [0, 1] and then normalized as
+        ``(x / 255 - mean) / std``. The conversion, normalization and
+        optional transposition to channels first happen in a single pass.
+
+        Both single images (HWC) and videos or batches of images (NHWC) are
+        supported. Applying it after :meth:`Buffer.batch` normalizes the whole
+        batch at once, and batching then copies uint8 instead of float data.
+
+        Example:
+
+        .. code-block:: python
+
+          # ImageNet normalization producing NCHW batches
+          dset = dset.batch(32).image_normalize(
+              "image",
+              mean=(0.485, 0.456, 0.406),
+              std=(0.229, 0.224, 0.225),
+              channels_first=True,
+          )
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          mean (list of float): The mean per channel or a single value for all
+            channels.
+          std (list of float): The standard deviation per channel or a single
+            value for all channels.
+          channels_first (bool): Whether to transpose the result from HWC to
+            CHW (or from NHWC to NCHW). (default: False)
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbdoc");
+  base.def(
+      "image_normalize_if",
+      &T::image_normalize_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("mean"),
+      py::arg("std"),
+      py::arg("channels_first") = false,
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.image_normalize`.");
+
   base.def(
       "image_random_area_crop",
       &T::image_random_area_crop,
@@ -338,6 +393,7 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("key"),
       py::arg("angle"),
       py::arg("crop") = false,
+      py::arg("interpolation") = "nearest",
       py::arg("output_key") = "",
       R"pbdoc(
         Rotate an image around its center point.
@@ -347,6 +403,8 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
           angle (float): The angle of rotation in degrees.
           crop (bool): Whether to crop the result to the original image's size.
             (default: False)
+          interpolation (str): How to sample the image, ``'nearest'`` or
+            ``'bilinear'``. (default: 'nearest')
           output_key (str): If it is not empty then write the result to this
             key instead of overwriting ``key``. (default: '')
       )pbdoc");
@@ -358,9 +416,232 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("key"),
       py::arg("angle"),
       py::arg("crop") = false,
+      py::arg("interpolation") = "nearest",
       py::arg("output_key") = "",
       "Conditional :meth:`Buffer.image_rotate`.");
 
+  base.def(
+      "image_affine",
+      &T::image_affine,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("matrix"),
+      py::arg("crop") = false,
+      py::arg("interpolation") = "nearest",
+      py::arg("output_key") = "",
+      R"pbdoc(
+        Apply an affine transformation to an image.
+
+        The transformation is given as a 2x3 matrix in row major order, which
+        maps the coordinates of the input pixels to the coordinates of the
+        output pixels, both relative to the center of the image. Output pixels
+        that fall outside of the input image are black.
+
+        Example:
+
+        .. code-block:: python
+
+          # Zoom in 2x and move the image 10 pixels to the right
+          dset = dset.image_affine("image", [2, 0, 10, 0, 2, 0], crop=True)
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          matrix (list of float): The 6 elements of the affine matrix.
+          crop (bool): Whether to crop the result to the original image's size
+            or to enlarge it to fit the whole transformed image.
+            (default: False)
+          interpolation (str): How to sample the image, ``'nearest'`` or
+            ``'bilinear'``. (default: 'nearest')
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbdoc");
+  base.def(
+      "image_affine_if",
+      &T::image_affine_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("matrix"),
+      py::arg("crop") = false,
+      py::arg("interpolation") = "nearest",
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.image_affine`.");
+
+  base.def(
+      "image_random_affine",
+      &T::image_random_affine,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("rotation_range"),
+      py::arg("scale_range") = std::make_pair(1.0f, 1.0f),
+      py::arg("shear_range") = std::make_pair(0.0f, 0.0f),
+      py::arg("translate_range") = std::make_pair(0.0f, 0.0f),
+      py::arg("crop") = true,
+      py::arg("interpolation") = "bilinear",
+      py::arg("output_key") = "",
+      R"pbdoc(
+        Apply a random affine transformation to an image.
+
+        The image is scaled, sheared along the x axis, rotated and translated
+        by amounts drawn uniformly from the given ranges. All the frames of a
+        video are transformed the same way.
+
+        Example:
+
+        .. code-block:: python
+
+          # Rotate by up to 15 degrees, zoom in or out by up to 10% and move
+          # the image by up to 5% of its size
+          dset = dset.image_random_affine(
+              "image", (-15, 15), (0.9, 1.1), translate_range=(-0.05, 0.05)
+          )
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          rotation_range (tuple of float): The range of the rotation angle in
+            degrees.
+          scale_range (tuple of float): The range of the scale factor.
+            (default: (1, 1))
+          shear_range (tuple of float): The range of the shear angle in
+            degrees. (default: (0, 0))
+          translate_range (tuple of float): The range of the translation as a
+            fraction of the image width and height. (default: (0, 0))
+          crop (bool): Whether to crop the result to the original image's size
+            or to enlarge it to fit the whole transformed image.
+            (default: True)
+          interpolation (str): How to sample the image, ``'nearest'`` or
+            ``'bilinear'``. (default: 'bilinear')
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbdoc");
+  base.def(
+      "image_random_affine_if",
+      &T::image_random_affine_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("rotation_range"),
+      py::arg("scale_range") = std::make_pair(1.0f, 1.0f),
+      py::arg("shear_range") = std::make_pair(0.0f, 0.0f),
+      py::arg("translate_range") = std::make_pair(0.0f, 0.0f),
+      py::arg("crop") = true,
+      py::arg("interpolation") = "bilinear",
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.image_random_affine`.");
+
+  base.def(
+      "image_random_color_jitter",
+      &T::image_random_color_jitter,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("brightness"),
+      py::arg("contrast") = 0,
+      py::arg("saturation") = 0,
+      py::arg("hue") = 0,
+      py::arg("output_key") = "",
+      R"pbdoc(
+        Randomly change the brightness, contrast, saturation and hue of an
+        image.
+
+        The brightness, contrast and saturation factors are drawn uniformly
+        from ``[max(0, 1 - x), 1 + x]`` and the hue shift from
+        ``[-hue, hue]`` (as a fraction of a full turn of the color wheel).
+        All the frames of a video are changed the same way. The image must
+        be ``uint8``, alpha channels are left untouched.
+
+        Example:
+
+        .. code-block:: python
+
+          dset = dset.image_random_color_jitter("image", 0.4, 0.4, 0.4, 0.1)
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          brightness (float): How much to change the brightness.
+          contrast (float): How much to change the contrast. (default: 0)
+          saturation (float): How much to change the saturation. (default: 0)
+          hue (float): How much to shift the hue, in ``[0, 0.5]``.
+            (default: 0)
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbdoc");
+  base.def(
+      "image_random_color_jitter_if",
+      &T::image_random_color_jitter_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("brightness"),
+      py::arg("contrast") = 0,
+      py::arg("saturation") = 0,
+      py::arg("hue") = 0,
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.image_random_color_jitter`.");
+
+  base.def(
+      "image_random_grayscale",
+      &T::image_random_grayscale,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("prob"),
+      py::arg("output_key") = "",
+      R"pbdoc(
+        Convert the image to grayscale ``prob`` percent of the time.
+
+        The image keeps its number of channels, the color channels all being
+        set to the luma. The image must be ``uint8``.
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          prob (float): The probability to convert an image.
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbdoc");
+  base.def(
+      "image_random_grayscale_if",
+      &T::image_random_grayscale_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("prob"),
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.image_random_grayscale`.");
+
+  base.def(
+      "image_gaussian_blur",
+      &T::image_gaussian_blur,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("sigma_range"),
+      py::arg("kernel_size") = 0,
+      py::arg("output_key") = "",
+      R"pbdoc(
+        Blur the image with a gaussian kernel of random standard deviation.
+
+        The standard deviation is drawn uniformly from ``sigma_range``. The
+        image must be ``uint8`` and its alpha channel, if any, is left
+        unchanged.
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          sigma_range (tuple of float): The range of the standard deviation
+            in pixels.
+          kernel_size (int): The odd size of the kernel, if 0 it is computed
+            from the standard deviation. (default: 0)
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbdoc");
+  base.def(
+      "image_gaussian_blur_if",
+      &T::image_gaussian_blur_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("sigma_range"),
+      py::arg("kernel_size") = 0,
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.image_gaussian_blur`.");
+
   base.def(
       "key_transform",
       [](const T& dataset,
@@ -470,6 +751,9 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
          int sample_rate,
          const std::string& resampling_quality,
          const std::string& info_key,
+         double offset_seconds,
+         double duration_seconds,
+         bool random_crop,
          const std::string& output_key) -> T {
         static const std::unordered_map<std::string, LoadAudioResamplingQuality>
             e_resampling_quality = {
@@ -493,6 +777,9 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
             sample_rate,
             it->second,
             info_key,
+            offset_seconds,
+            duration_seconds,
+            random_crop,
             output_key);
       },
       py::call_guard<py::gil_scoped_release>(),
@@ -504,6 +791,9 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("sample_rate") = 0,
       py::arg("resampling_quality") = "sinc-fastest",
       py::arg("info_key") = "",
+      py::arg("offset_seconds") = 0,
+      py::arg("duration_seconds") = 0,
+      py::arg("random_crop") = false,
       py::arg("output_key") = "",
       R"pbcopy(
         Load an audio file.
@@ -531,6 +821,22 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
             .sample_transform(lambda s: s if s["audio_info"] >= 10 else dict())
           )
 
+        Long recordings can be cropped while being decoded with
+        ``offset_seconds`` and ``duration_seconds``. The decoder seeks to the
+        start of the crop so only its frames are decoded. With
+        ``random_crop`` the crop starts at a random position in the audio
+        (after ``offset_seconds``), for instance to take random 10 seconds
+        crops of long recordings:
+
+        .. code-block:: python
+
+          dset = dset.load_audio("audio_file", duration_seconds=10, random_crop=True)
+
+        The number of frames stored in ``info_key`` is then the number of
+        frames of the crop, before resampling. The position of the crop in
+        the file is not reported, and ``info=True`` without ``info_key``
+        still loads the information of the whole file.
+
         Args:
           key (str): The sample key that contains the array we are operating on.
           prefix (str): The filepath prefix to use when loading the audio files.
@@ -547,6 +853,15 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
             the audio resampling quality if resampling is performed. (default:
             sinc-fastest)
           info_key (str): The key to store the audio metadata in, if desired. (default: '')
+          offset_seconds (float): The start of the audio to load in seconds.
+            (default: 0)
+          duration_seconds (float): If positive, load at most this many
+            seconds of audio from ``offset_seconds``. The audio is shorter if
+            the file ends before. (default: 0)
+          random_crop (bool): If true, the start of the loaded audio is chosen
+            uniformly at random between ``offset_seconds`` and the last
+            position where ``duration_seconds`` fit, instead of
+            ``offset_seconds``. (default: False)
           output_key (str): The key to store the result in. If it is an empty
             string then overwrite the input. (default: '')
       )pbcopy");
@@ -562,6 +877,9 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
          int sample_rate,
          const std::string& resampling_quality,
          const std::string& info_key,
+         double offset_seconds,
+         double duration_seconds,
+         bool random_crop,
          const std::string& output_key) -> T {
         static const std::unordered_map<std::string, LoadAudioResamplingQuality>
             e_resampling_quality = {
@@ -586,6 +904,9 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
             sample_rate,
             it->second,
             info_key,
+            offset_seconds,
+            duration_seconds,
+            random_crop,
             output_key);
       },
       py::call_guard<py::gil_scoped_release>(),
@@ -598,6 +919,9 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("sample_rate") = 0,
       py::arg("resampling_quality") = "sinc-fastest",
       py::arg("info_key") = "",
+      py::arg("offset_seconds") = 0,
+      py::arg("duration_seconds") = 0,
+      py::arg("random_crop") = false,
       py::arg("output_key") = "",
       "Conditional :meth:`Buffer.load_audio`.");
 
@@ -648,6 +972,9 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
         follows the metadata information returned by
         :meth:`Buffer.load_audio`.
 
+        Whatever the quality, ``n`` frames give
+        ``floor(n * sample_rate / input_sample_rate)`` frames.
+
         The following example resamples previously loaded audio to 16kHz.
 
         .. code-block:: python
@@ -715,6 +1042,161 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("output_key") = "",
       "Conditional :meth:`Buffer.resample_audio`.");
 
+  base.def(
+      "audio_mel_filterbank",
+      &T::audio_mel_filterbank,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("sample_rate"),
+      py::arg("num_filters") = 80,
+      py::arg("low_freq") = 0,
+      py::arg("high_freq") = 0,
+      py::arg("scale") = "mel",
+      py::arg("floor") = 0,
+      py::arg("log") = true,
+      py::arg("output_key") = "",
+      R"pbcopy(
+        Compute triangular filterbank energies from a spectrogram.
+
+        The spectrogram of shape ``(frames, bins)`` is typically computed with
+        :meth:`Buffer.audio_stft`. The filters are evenly spaced on the
+        frequency ``scale`` between ``low_freq`` and ``high_freq`` and are the
+        same as the ones of :func:`mlx.data.features.mfsc`. The filterbank is
+        computed once per configuration and cached.
+
+        The result is a float array of shape ``(frames, num_filters)``.
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          sample_rate (int): The sample rate of the audio in Hz.
+          num_filters (int): The number of filters. (default: 80)
+          low_freq (float): The lowest frequency of the filters in Hz. (default: 0)
+          high_freq (float): The highest frequency of the filters in Hz, if
+            0 it is ``sample_rate / 2``. (default: 0)
+          scale (mel|log10|linear): The frequency scale on which the filters
+            are evenly spaced. (default: mel)
+          floor (float): The minimum energy of a filter. (default: 0)
+          log (bool): If true, return the log of the energies. (default: True)
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbcopy");
+  base.def(
+      "audio_mel_filterbank_if",
+      &T::audio_mel_filterbank_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("sample_rate"),
+      py::arg("num_filters") = 80,
+      py::arg("low_freq") = 0,
+      py::arg("high_freq") = 0,
+      py::arg("scale") = "mel",
+      py::arg("floor") = 0,
+      py::arg("log") = true,
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.audio_mel_filterbank`.");
+
+  base.def(
+      "audio_mfcc",
+      &T::audio_mfcc,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("num_coefficients") = 13,
+      py::arg("output_key") = "",
+      R"pbcopy(
+        Compute mel-frequency cepstral coefficients (MFCCs).
+
+        The coefficients are the first ``num_coefficients`` values of the
+        orthonormal DCT-II of log filterbank energies of shape
+        ``(frames, filters)``, as computed by
+        :meth:`Buffer.audio_mel_filterbank`.
+
+        The following example computes 13 MFCCs from 16kHz audio with 25ms
+        frames every 10ms:
+
+        .. code-block:: python
+
+          dset = (
+            dset
+            .load_audio("audio")
+            .audio_stft("audio", n_fft=512, frame_length=400, hop_length=160, window="hamming", pre_emphasis=0.97)
+            .audio_mel_filterbank("audio", 16000, num_filters=40, floor=1e-10)
+            .audio_mfcc("audio", 13)
+          )
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          num_coefficients (int): The number of coefficients. (default: 13)
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbcopy");
+  base.def(
+      "audio_mfcc_if",
+      &T::audio_mfcc_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("num_coefficients") = 13,
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.audio_mfcc`.");
+
+  base.def(
+      "audio_stft",
+      &T::audio_stft,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("n_fft") = 512,
+      py::arg("frame_length") = 0,
+      py::arg("hop_length") = 0,
+      py::arg("window") = "hann",
+      py::arg("pre_emphasis") = 0,
+      py::arg("power") = 1,
+      py::arg("output_key") = "",
+      R"pbcopy(
+        Compute the spectrogram of mono audio with a short time Fourier
+        transform.
+
+        The audio must be a float array of shape ``(N,)`` or ``(N, 1)``, as
+        loaded by :meth:`Buffer.load_audio`. Frames of ``frame_length``
+        samples starting every ``hop_length`` samples are pre-emphasized,
+        windowed and zero padded to ``n_fft`` samples before their real FFT is
+        computed. The FFT twiddles and the windows are computed once per size
+        and cached.
+
+        The result is a float array of shape ``(frames, n_fft // 2 + 1)``
+        containing the magnitudes of the FFTs raised to ``power``.
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          n_fft (int): The size of the FFT, a power of 2. (default: 512)
+          frame_length (int): The number of samples per frame, if 0 it is
+            ``n_fft``. (default: 0)
+          hop_length (int): The number of samples between the starts of two
+            consecutive frames, if 0 it is ``frame_length // 4``. (default: 0)
+          window (hann|hamming|rectangular): The window applied to the
+            frames. (default: hann)
+          pre_emphasis (float): The coefficient of the pre-emphasis filter
+            ``y[i] = x[i] - pre_emphasis * x[i-1]``. (default: 0)
+          power (float): The exponent of the magnitudes, 2 for the power
+            spectrum. (default: 1)
+          output_key (str): If it is not empty then write the result to this
+            key instead of overwriting ``key``. (default: '')
+      )pbcopy");
+  base.def(
+      "audio_stft_if",
+      &T::audio_stft_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("n_fft") = 512,
+      py::arg("frame_length") = 0,
+      py::arg("hop_length") = 0,
+      py::arg("window") = "hann",
+      py::arg("pre_emphasis") = 0,
+      py::arg("power") = 1,
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.audio_stft`.");
+
   base.def(
       "load_file",
       &T::load_file,
@@ -752,6 +1234,8 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("info") = false,
       py::arg("format") = "RGB",
       py::arg("from_memory") = false,
+      py::arg("resize_smallest_side") = 0,
+      py::arg("cache") = nullptr,
       py::arg("output_key") = "",
       R"pbcopy(
         Load an image file.
@@ -772,6 +1256,16 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
             space (e.g. YCbCr) (default: RGB).
           from_memory (bool): If true assume the file contents are in the array
             instead of the file name. (default: False)
+          resize_smallest_side (int): If positive, resize the image such that
+            its smallest side is that size, as :meth:`Buffer.image_resize_smallest_side`.
+            JPEG images are then decoded directly at 1/2, 1/4 or 1/8 of their
+            size when possible, which is much faster than decoding them
+            fully and resizing them afterwards. (default: 0)
+          cache (mlx.data.core.ImageCache, optional): If provided, keep the
+            loaded (and resized) images in this cache such that they are
+            decoded only once, files being identified by their path, size
+            and modification time and in memory contents by their hash.
+            (default: None)
           output_key (str): The key to store the result in. If it is an empty
             string then overwrite the input. (default: '')
       )pbcopy");
@@ -785,9 +1279,76 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("info") = false,
       py::arg("format") = "RGB",
       py::arg("from_memory") = false,
+      py::arg("resize_smallest_side") = 0,
+      py::arg("cache") = nullptr,
       py::arg("output_key") = "",
       "Conditional :meth:`Buffer.load_image`.");
 
+  base.def(
+      "load_image_random_area_crop",
+      &T::load_image_random_area_crop,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("key"),
+      py::arg("area_range"),
+      py::arg("aspect_ratio_range"),
+      py::arg("num_trial") = 10,
+      py::arg("prefix") = "",
+      py::arg("from_memory") = false,
+      py::arg("resize_width") = 0,
+      py::arg("resize_height") = 0,
+      py::arg("output_key") = "",
+      R"pbcopy(
+        Load a random crop of an image file.
+
+        Equivalent to :meth:`Buffer.load_image` followed by
+        :meth:`Buffer.image_random_area_crop` (and :meth:`Buffer.image_resize`
+        if ``resize_width`` and ``resize_height`` are given), except that the
+        crop is drawn from the image size before decoding it. JPEG images are
+        then only decoded in the cropped area, and at 1/2, 1/4 or 1/8 of
+        their size when the crop is still larger than the target size.
+
+        Example:
+
+        .. code-block:: python
+
+          # Random resized crop, as commonly used to train on ImageNet
+          dset = dset.load_image_random_area_crop(
+              "image", (0.08, 1.0), (0.75, 1.33), resize_width=224, resize_height=224
+          )
+
+        Args:
+          key (str): The sample key that contains the array we are operating on.
+          area_range (tuple of floats): A minimum and maximum area portion for the crop.
+          aspect_ratio_range (tuple of floats): A minimum and maximum aspect
+            ratio for the crop. The aspect ratio is defined as the width
+            divided by the height of the image.
+          num_trial (int): How many rejection sampling attempts to perform. (default: 10)
+          prefix (str): The filepath prefix to use when loading the files. (default: '')
+          from_memory (bool): If true assume the file contents are in the array
+            instead of the file name. (default: False)
+          resize_width (int): If positive (with ``resize_height``), resize the
+            crop to that width. (default: 0)
+          resize_height (int): If positive (with ``resize_width``), resize the
+            crop to that height. (default: 0)
+          output_key (str): The key to store the result in. If it is an empty
+            string then overwrite the input. (default: '')
+      )pbcopy");
+  base.def(
+      "load_image_random_area_crop_if",
+      &T::load_image_random_area_crop_if,
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("cond"),
+      py::arg("key"),
+      py::arg("area_range"),
+      py::arg("aspect_ratio_range"),
+      py::arg("num_trial") = 10,
+      py::arg("prefix") = "",
+      py::arg("from_memory") = false,
+      py::arg("resize_width") = 0,
+      py::arg("resize_height") = 0,
+      py::arg("output_key") = "",
+      "Conditional :meth:`Buffer.load_image_random_area_crop`.");
+
   base.def(
       "load_numpy",
       &T::load_numpy,
@@ -826,6 +1387,12 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("prefix") = "",
       py::arg("info") = false,
       py::arg("from_memory") = false,
+      py::arg("num_frames") = 0,
+      py::arg("stride") = 0,
+      py::arg("clip_duration") = 0,
+      py::arg("random_offset") = false,
+      py::arg("resize_smallest_side") = 0,
+      py::arg("num_threads") = 1,
       py::arg("output_key") = "",
       R"pbcopy(
         Load a video file.
@@ -834,6 +1401,34 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
         is true then it, instead, reads the information of the video, namely
         width, height and number of frames.
 
+        If ``num_frames`` is positive, only that many frames of a clip are
+        loaded. The decoder seeks to the keyframe preceding them instead of
+        decoding the whole video, such that the cost depends on the number of
+        frames loaded rather than on the length of the video.
+
+        The clip lasts ``clip_duration`` seconds if it is positive, spans the
+        sampled frames if ``stride`` is positive, or is the whole video
+        otherwise. It is taken in the middle of the video or, if
+        ``random_offset`` is true, at a random position. Frames past the end
+        of the video repeat its last frame.
+
+        High resolution videos which are downscaled afterwards load much
+        faster with ``resize_smallest_side``, and with a few ``num_threads``
+        when the pipeline does not already decode as many videos in parallel
+        as there are cores.
+
+        Example:
+
+        .. code-block:: python
+
+          # 8 consecutive frames every 4 frames from a random position
+          dset = dset.load_video(
+              "file", num_frames=8, stride=4, random_offset=True
+          )
+
+          # 16 frames spread over the whole video
+          dset = dset.load_video("file", num_frames=16)
+
         Args:
           key (str): The sample key that contains the array we are operating on.
           prefix (str): The filepath prefix to use when loading the files. (default: '')
@@ -841,6 +1436,23 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
             of the video data. (default: False)
           from_memory (bool): If true assume the file contents are in the array
             instead of the file name. (default: False)
+          num_frames (int): If positive, the number of frames to load.
+            (default: 0)
+          stride (int): If positive, the distance between the loaded frames,
+            otherwise they are spread uniformly over the clip. (default: 0)
+          clip_duration (float): If positive, the duration in seconds of the
+            clip the frames are sampled from. It cannot be combined with
+            ``stride``. (default: 0)
+          random_offset (bool): If true, the clip starts at a random position
+            and, without ``stride``, a random frame is picked in each of the
+            ``num_frames`` segments of the clip instead of their middle one.
+            (default: False)
+          resize_smallest_side (int): If positive, resize the frames such
+            that their smallest side is that size while they are converted
+            to RGB, decoding them at a reduced resolution when the codec
+            supports it. (default: 0)
+          num_threads (int): The number of threads decoding the video, 0 for
+            one per core. (default: 1)
           output_key (str): The key to store the result in. If it is an empty
             string then overwrite the input. (default: '')
       )pbcopy");
@@ -853,6 +1465,12 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
       py::arg("prefix") = "",
       py::arg("info") = false,
       py::arg("from_memory") = false,
+      py::arg("num_frames") = 0,
+      py::arg("stride") = 0,
+      py::arg("clip_duration") = 0,
+      py::arg("random_offset") = false,
+      py::arg("resize_smallest_side") = 0,
+      py::arg("num_threads") = 1,
       py::arg("output_key") = "",
       "Conditional :meth:`Buffer.load_video`.");
 
@@ -1051,6 +1669,12 @@ void mlx_data_export_dataset(py::class_<T, P>& base) {
         archives), we can parallelize the indexing process using the
         ``num_threads`` argument.
 
+        Local tar archives are memory mapped and the file contents point
+        directly into a private mapping. Modifying them in place does not
+        change the archive, but the change is seen when the same file is read
+        again by this operation. Copy them first (e.g. with ``np.array``) to
+        keep the original contents.
+
         Args:
           tarkey (str): The path to the tar file or the sample key containing
             the path to the tarfile based on the value of ``from_key``.
@@ -59,6 +59,23 @@ class PyStream : public stream::Stream {
     return sample;
   }
 
+  // skips items without converting them to samples
+  virtual int64_t skip(int64_t n) const {
+    std::unique_lock lock(mutex_);
+    py::gil_scoped_acquire gil;
+    int64_t skipped = 0;
+    try {
+      for (; skipped < n; skipped++) {
+        next_();
+      }
+    } catch (py::error_already_set& e) {
+      if (!e.matches(PyExc_StopIteration)) {
+        throw;
+      }
+    }
+    return skipped;
+  }
+
  private:
   py::function iterable_factory_;
   py::function next_;
@@ -127,6 +144,23 @@ void init_mlx_data_stream(py::module& m) {
               py::call_guard<py::gil_scoped_release>(),
               py::arg("pad") = std::unordered_map<std::string, double>(),
               py::arg("dim") = std::unordered_map<std::string, int>())
+          .def(
+              "image_resize_batch",
+              &Stream::image_resize_batch,
+              py::call_guard<py::gil_scoped_release>(),
+              py::arg("batch_size"),
+              py::arg("key"),
+              py::arg("w"),
+              py::arg("h"),
+              py::arg("filter") = "bilinear",
+              py::arg("num_threads") = 0,
+              py::arg("pad") = std::unordered_map<std::string, double>(),
+              py::arg("dim") = std::unordered_map<std::string, int>(),
+              R"pbcopy(
+                Creates batches like :meth:`Stream.batch` but resizes the
+                images in ``key`` to ``w`` by ``h`` directly into the batch
+                array. See :meth:`Buffer.image_resize_batch` for details.
+              )pbcopy")
           .def(
               "csv_reader_from_key",
               &Stream::csv_reader_from_key,
@@ -325,6 +359,14 @@ void init_mlx_data_stream(py::module& m) {
                 This can be used for distributed settings where different nodes
                 should load different parts of a dataset.
 
+                The samples of the other partitions are skipped by the
+                underlying stream without being materialized, when it can.
+                This is the case for line, CSV and tar readers (also from keys),
+                streams made from buffers, python iterables, and
+                transformations on top of them which never drop samples. For
+                this reason, partition as early as possible in the pipeline,
+                in particular before any prefetching.
+
                 Args:
                   num_partitions (int): How many different partitions to split the stream into.
                   partition (int): Which partition to use (0-based).
@@ -347,9 +389,10 @@ void init_mlx_data_stream(py::module& m) {
                 Fetch samples in background threads.
 
                 This operation is the workhorse of data loading. It uses
-                ``num_threads`` background threads and fetches
+                up to ``num_threads`` background threads and fetches
                 ``prefetch_size`` samples so that they are ready to be used
-                when needed.
+                when needed. The threads come from a process-wide pool shared
+                by all the stages (see :func:`mlx.data.core.set_global_thread_count`).
 
                 Prefetch can be used both to parallelize operations but also to
                 overlap computation with data loading in a background thread.
@@ -373,7 +416,8 @@ void init_mlx_data_stream(py::module& m) {
 
                 Args:
                   prefetch_size (int): How many samples to prefetch.
-                  num_threads (int): How many background threads to launch.
+                  num_threads (int): How many background threads to use at
+                    most.
               )pbcopy")
           .def(
               "prefetch_if",
@@ -433,6 +477,94 @@ void init_mlx_data_stream(py::module& m) {
                   index_key (str): If provided, store the index of the sliding window in
                     that key. (default: "")
               )pbcopy")
+          .def(
+              "tar_reader_from_key",
+              &Stream::tar_reader_from_key,
+              py::call_guard<py::gil_scoped_release>(),
+              py::arg("key"),
+              py::arg("from_memory") = false,
+              py::arg("local_prefix") = "",
+              py::arg("file_fetcher") = nullptr,
+              R"pbcopy(
+                Read the tar archive pointed to from the array at ``key`` and
+                yield the groups of files it contains as separate samples in
+                the stream.
+
+                This operation is similar to :func:`stream_tar_reader` but
+                applied once for every sample in the stream and the samples
+                from the resulting stream are returned until exhaustion.
+
+                Args:
+                  key (str): The sample key that contains the array we are operating on.
+                  from_memory (bool): Read the archive from the contents of the
+                    array rather than treating the array as a filename. (default: False)
+                  local_prefix (str): The filepath prefix to use to read the files. (default: '')
+                  file_fetcher (mlx.data.core.FileFetcher, optional): A file fetcher to
+                    read the archives possibly from a remote location.
+              )pbcopy")
+          .def(
+              "video_clips_from_key",
+              &Stream::video_clips_from_key,
+              py::call_guard<py::gil_scoped_release>(),
+              py::arg("key"),
+              py::arg("dst_key"),
+              py::arg("clip_length"),
+              py::arg("stride") = 0,
+              py::arg("from_memory") = false,
+              py::arg("index_key") = "",
+              py::arg("resize_smallest_side") = 0,
+              py::arg("num_threads") = 1,
+              py::arg("local_prefix") = "",
+              py::arg("file_fetcher") = nullptr,
+              R"pbcopy(
+                Decode the video pointed to from the array at ``key`` and
+                yield its clips of ``clip_length`` consecutive frames as
+                separate samples in the stream in the ``dst_key``.
+
+                The video is decoded incrementally, so only the current clip
+                and the decoder state are in memory rather than the whole
+                video. A clip starts every ``stride`` frames. The frames
+                shared with the previous clip are not decoded again and,
+                when the clips do not overlap, the reader seeks over the
+                frames in between. The last clip is dropped if it is
+                incomplete.
+
+                Each clip sample contains the keys of the sample it comes
+                from, except ``key`` when reading from memory.
+
+                Example:
+
+                .. code-block:: python
+
+                  # 16 frames clips every 8 frames with their labels
+                  clips = (
+                      dx.buffer_from_vector(
+                          [{"file": b"a.mp4", "label": 0}, {"file": b"b.mp4", "label": 1}]
+                      )
+                      .to_stream()
+                      .video_clips_from_key("file", "clip", 16, stride=8)
+                      .batch(4)
+                  )
+
+                Args:
+                  key (str): The sample key that contains the array we are operating on.
+                  dst_key (str): The key to put the clips into.
+                  clip_length (int): The number of frames per clip.
+                  stride (int): The number of frames between the starts of two
+                    consecutive clips. If 0, it is ``clip_length``. (default: 0)
+                  from_memory (bool): Decode the video from the contents of the
+                    array rather than treating the array as a filename. (default: False)
+                  index_key (str): If set, the index of the clip in the video
+                    is stored in this key. (default: '')
+                  resize_smallest_side (int): If positive, the frames are
+                    resized while being decoded such that their smallest side
+                    is this size. (default: 0)
+                  num_threads (int): The number of decoding threads, 0 for one
+                    per core. (default: 1)
+                  local_prefix (str): The filepath prefix to use to read the files. (default: '')
+                  file_fetcher (mlx.data.core.FileFetcher, optional): A file fetcher to
+                    read the videos possibly from a remote location.
+              )pbcopy")
           .def(
               "to_buffer",
               &Stream::to_buffer,
@@ -585,6 +717,50 @@ void init_mlx_data_stream(py::module& m) {
             passed instead of a filename.
       )pbcopy");
 
+  m.def(
+      "stream_tar_reader",
+      [](py::object file,
+         const std::string& local_prefix,
+         std::shared_ptr<core::FileFetcher> file_fetcher,
+         std::shared_ptr<core::FileFetcherHandle> file_fetcher_handle) {
+        if (py::isinstance<py::str>(file)) {
+          return stream_tar_reader(
+              file.cast<std::string>(), local_prefix, file_fetcher);
+        } else {
+          auto in = std::make_shared<mlx::pybind::py_istream>(file, 4096);
+          return stream_tar_reader(in, file_fetcher_handle);
+        }
+      },
+      py::arg("file"),
+      py::kw_only(),
+      py::arg("local_prefix") = "",
+      py::arg("file_fetcher") = nullptr,
+      py::arg("file_fetcher_handle") = nullptr,
+      R"pbcopy(
+        Stream samples from the files of a tar archive.
+
+        The archive is read sequentially, without an index, so it can be
+        compressed (gzip, zstd, etc) and, similar to :func:`stream_csv_reader`,
+        given as a filename or a python object with a ``read()`` and a
+        ``seek()``.
+
+        Consecutive files with the same name up to the first dot of their
+        basename form one sample, where each file is stored under its
+        extension and the common name under ``"__key__"``. For instance the
+        files ``000123.jpg`` and ``000123.json`` result in the sample
+        ``{"__key__": "000123", "jpg": ..., "json": ...}``. Files without an
+        extension are ignored.
+
+        Args:
+          file (str or python readable object): The file to read the archive from.
+          local_prefix (str): The filepath prefix to use to read the files. (default: '')
+          file_fetcher (mlx.data.core.FileFetcher, optional): A file fetcher to
+            read the archive possibly from a remote location.
+          file_fetcher_handle (mlx.data.core.FileFetcherHandle, optional): A
+            handle to ensure that the file is kept on disk if a stream is
+            passed instead of a filename.
+      )pbcopy");
+
   m.def(
       "stream_csv_reader_from_string",
       &stream_csv_reader_from_string,
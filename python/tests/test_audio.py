@@ -0,0 +1,221 @@
+# Copyright © 2024 Apple Inc.
+
+import os
+import tempfile
+import unittest
+import wave
+
+import numpy as np
+
+import mlx.data as dx
+from mlx.data import core
+from mlx.data.features import audio as features
+
+
+def synthetic_audio(n, sample_rate=16000, seed=0):
+    # tones over some noise such that every filter collects some energy
+    t = np.arange(n) / sample_rate
+    x = 0.3 * np.sin(2 * np.pi * 440 * t) + 0.2 * np.sin(2 * np.pi * 3000 * t)
+    x += 0.05 * np.random.RandomState(seed).randn(n)
+    return x.astype(np.float32)
+
+
+class TestAudioFeatures(unittest.TestCase):
+    def setUp(self):
+        self.audio = synthetic_audio(8000)
+        self.dset = dx.buffer_from_vector([{"audio": self.audio}])
+
+    def test_stft(self):
+        out = self.dset.audio_stft(
+            "audio", n_fft=512, frame_length=400, hop_length=160, window="hamming"
+        )[0]["audio"]
+        frames = features.sliding_window(-1, 400, 160)(self.audio)
+        expected = features.power_spectrum(512)(
+            features.windowing(400, features.WindowType.Hamming)(frames)
+        )
+        self.assertEqual(out.shape, (len(frames), 257))
+        self.assertEqual(out.dtype, np.float32)
+        self.assertTrue(np.allclose(out, expected, atol=1e-4 * expected.max()))
+
+        # rectangular frames of the FFT size with their power
+        dset = self.dset.audio_stft("audio", 256, window="rectangular", power=2)
+        out = dset[0]["audio"]
+        frames = features.sliding_window(-1, 256, 64)(self.audio)
+        expected = np.abs(np.fft.rfft(frames)) ** 2
+        self.assertEqual(out.shape, (len(frames), 129))
+        self.assertTrue(np.allclose(out, expected, atol=1e-4 * expected.max()))
+
+    def test_mfsc(self):
+        # the same features as mlx.data.features.mfsc
+        dset = (
+            self.dset.key_transform("audio", lambda x: x * 32768)
+            .audio_stft(
+                "audio",
+                n_fft=512,
+                frame_length=400,
+                hop_length=160,
+                window="hamming",
+                pre_emphasis=0.97,
+            )
+            .audio_mel_filterbank("audio", 16000, num_filters=80, floor=1.0)
+        )
+        out = dset[0]["audio"]
+        expected = features.mfsc(80, 16000)(self.audio)
+        self.assertEqual(out.shape, expected.shape)
+        self.assertTrue(np.allclose(out, expected, atol=1e-3))
+
+        spectrogram = np.abs(
+            np.fft.rfft(features.sliding_window(-1, 512, 128)(self.audio))
+        ).astype(np.float32)
+        dset = dx.buffer_from_vector([{"spectrogram": spectrogram}])
+        for scale, name, low in (
+            (features.FrequencyScale.LINEAR, "linear", 0),
+            (features.FrequencyScale.LOG10, "log10", 100),
+        ):
+            out = dset.audio_mel_filterbank(
+                "spectrogram", 16000, 20, low, scale=name, log=False
+            )[0]["spectrogram"]
+            expected = features.tri_filterbank(20, 257, 16000, low, freqscale=scale)(
+                spectrogram
+            )
+            self.assertTrue(np.allclose(out, expected, rtol=1e-4, atol=1e-4))
+
+    def test_mfcc(self):
+        log_mel = np.log(np.random.RandomState(1).rand(10, 40) + 0.1)
+        log_mel = log_mel.astype(np.float32)
+        out = dx.buffer_from_vector([{"x": log_mel}]).audio_mfcc("x", 13)[0]["x"]
+
+        # orthonormal DCT-II
+        n = np.arange(40)
+        dct = np.cos(np.pi / 40 * (n[None, :] + 0.5) * np.arange(13)[:, None])
+        dct *= np.sqrt(2 / 40)
+        dct[0] /= np.sqrt(2)
+        self.assertEqual(out.shape, (10, 13))
+        self.assertTrue(np.allclose(out, log_mel @ dct.T, atol=1e-4))
+
+
+def write_wav(path, frames, sample_rate):
+    with wave.open(path, "wb") as f:
+        f.setnchannels(frames.shape[1])
+        f.setsampwidth(2)
+        f.setframerate(sample_rate)
+        f.writeframes(frames.astype("<i2").tobytes())
+
+
+@unittest.skipUnless(
+    core.libs_version().get("sndfile"), "mlx.data built without libsndfile"
+)
+class TestLoadAudio(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        # 1000 stereo frames at 8kHz, 80 frames per 10ms
+        cls.root = tempfile.TemporaryDirectory()
+        cls.frames = np.random.RandomState(0).randint(-(2**15), 2**15, (1000, 2))
+        write_wav(os.path.join(cls.root.name, "audio.wav"), cls.frames, 8000)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.root.cleanup()
+
+    def load(self, n=1, **kwargs):
+        dset = dx.buffer_from_vector([{"file": b"audio.wav"}] * n)
+        return dset.load_audio(
+            "file", prefix=self.root.name, info_key="info", output_key="audio", **kwargs
+        )
+
+    def test_full(self):
+        sample = self.load()[0]
+        self.assertEqual(sample["audio"].shape, (1000, 2))
+        self.assertTrue(np.allclose(sample["audio"], self.frames / 2**15))
+        self.assertEqual(sample["info"].tolist(), [1000, 2, 8000])
+
+    def test_crop(self):
+        full = self.load()[0]["audio"]
+
+        sample = self.load(offset_seconds=0.01, duration_seconds=0.02)[0]
+        self.assertTrue(np.array_equal(sample["audio"], full[80:240]))
+        self.assertEqual(sample["info"].tolist(), [160, 2, 8000])
+
+        # without a duration the crop runs to the end of the file
+        sample = self.load(offset_seconds=0.1)[0]
+        self.assertTrue(np.array_equal(sample["audio"], full[800:]))
+        self.assertEqual(sample["info"].tolist(), [200, 2, 8000])
+
+        # the crop is clipped at the end of the file
+        sample = self.load(offset_seconds=0.1, duration_seconds=0.05)[0]
+        self.assertTrue(np.array_equal(sample["audio"], full[800:]))
+        self.assertEqual(sample["info"].tolist(), [200, 2, 8000])
+
+    def test_random_crop(self):
+        full = self.load()[0]["audio"]
+        dset = self.load(
+            50, offset_seconds=0.01, duration_seconds=0.02, random_crop=True
+        )
+        starts = set()
+        for sample in dset:
+            self.assertEqual(sample["audio"].shape, (160, 2))
+            self.assertEqual(sample["info"].tolist(), [160, 2, 8000])
+            # the crops lie in [offset, frames - length]
+            matches = [
+                s
+                for s in range(80, 841)
+                if np.array_equal(sample["audio"], full[s : s + 160])
+            ]
+            self.assertEqual(len(matches), 1)
+            starts.add(matches[0])
+        self.assertGreater(len(starts), 1)
+
+
+def sine(frequency, n, sample_rate):
+    # a stereo sine with different amplitudes per channel
+    x = np.sin(2 * np.pi * frequency * np.arange(n) / sample_rate)
+    return np.stack([0.5 * x, x], -1).astype(np.float32)
+
+
+class TestResampleAudio(unittest.TestCase):
+    def resample(self, audio, src, dst, quality="sinc-fastest"):
+        dset = dx.buffer_from_vector([{"audio": audio}])
+        dset = dset.resample_audio("audio", dst, src, resampling_quality=quality)
+        return dset[0]["audio"]
+
+    def test_length(self):
+        # floor(n * dst / src) frames whatever the quality
+        qualities = ["sinc-best", "sinc-medium", "sinc-fastest"]
+        if core.libs_version().get("samplerate"):
+            qualities += ["zero-order-hold", "linear"]
+        rates = (
+            (48000, 16000, 4801),
+            (48000, 16000, 4800),
+            (44100, 16000, 4411),
+            (8000, 16000, 801),
+        )
+        for quality in qualities:
+            for src, dst, n in rates:
+                audio = np.zeros((n, 1), dtype=np.float32)
+                out = self.resample(audio, src, dst, quality)
+                self.assertEqual(out.shape, (n * dst // src, 1))
+                self.assertEqual(out.dtype, np.float32)
+
+        # the input rate may be read from the info of load_audio
+        sample = {
+            "audio": np.zeros((4801, 2), dtype=np.float32),
+            "info": np.array([4801, 2, 48000], dtype=np.int64),
+        }
+        dset = dx.buffer_from_vector([sample])
+        dset = dset.resample_audio("audio", 16000, info_key="info")
+        self.assertEqual(dset[0]["audio"].shape, (1600, 2))
+
+    def test_sine(self):
+        expected = sine(440, 1600, 16000)
+        for quality in ("sinc-best", "sinc-medium", "sinc-fastest"):
+            out = self.resample(sine(440, 4801, 48000), 48000, 16000, quality)
+            # away from the edges, where the input is implicitly zero padded
+            self.assertTrue(np.allclose(out[50:-50], expected[50:-50], atol=1e-3))
+
+            # tones above the new Nyquist frequency are filtered out
+            out = self.resample(sine(10000, 4801, 48000), 48000, 16000, quality)
+            self.assertLess(np.abs(out[50:-50]).max(), 1e-3)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,270 @@
+# Copyright © 2024 Apple Inc.
+
+import functools
+import http.server
+import io
+import os
+import tarfile
+import tempfile
+import threading
+import time
+import unittest
+
+import mlx.data as dx
+from mlx.data import core
+
+LINES = [b"first line", b"second line", b"third line"]
+CSV = b"name,value\nfoo,1\nbar,2\n"
+TAR_FILES = {"a.txt": b"contents of a", "b/c.txt": b"contents of c"}
+# larger than the parts the fetchers download in parallel
+BLOBS = {"blob0.bin": os.urandom(300_000), "blob1.bin": os.urandom(200_001)}
+
+
+def write_files(root):
+    with open(os.path.join(root, "lines.txt"), "wb") as f:
+        f.write(b"\n".join(LINES) + b"\n")
+    with open(os.path.join(root, "data.csv"), "wb") as f:
+        f.write(CSV)
+    with tarfile.open(os.path.join(root, "archive.tar"), "w") as tar:
+        for name, contents in TAR_FILES.items():
+            info = tarfile.TarInfo(name)
+            info.size = len(contents)
+            tar.addfile(info, io.BytesIO(contents))
+    for name, contents in BLOBS.items():
+        with open(os.path.join(root, name), "wb") as f:
+            f.write(contents)
+
+
+class InMemoryFetchTests:
+    """Checks that the readers read the files fetched in memory."""
+
+    def check_in_memory(self, fetcher, local_prefix):
+        handle = fetcher.fetch("lines.txt")
+        self.assertIsNotNone(handle.data)
+        self.assertEqual(bytes(handle.data), b"\n".join(LINES) + b"\n")
+
+        dset = (
+            dx.buffer_from_vector([{"file": b"lines.txt"}])
+            .to_stream()
+            .line_reader_from_key("file", "line", file_fetcher=fetcher)
+        )
+        self.assertEqual([bytes(s["line"]) for s in dset], LINES)
+
+        dset = (
+            dx.buffer_from_vector([{"file": b"data.csv"}])
+            .to_stream()
+            .csv_reader_from_key("file", file_fetcher=fetcher)
+        )
+        rows = [(bytes(s["name"]), bytes(s["value"])) for s in dset]
+        self.assertEqual(rows, [(b"foo", b"1"), (b"bar", b"2")])
+
+        dset = dx.buffer_from_vector(
+            [{"file": name.encode()} for name in TAR_FILES]
+        ).read_from_tar("archive.tar", "file", "contents", file_fetcher=fetcher)
+        for sample, contents in zip(dset, TAR_FILES.values()):
+            self.assertEqual(bytes(sample["contents"]), contents)
+
+        # nothing was written on disk
+        self.assertEqual(os.listdir(local_prefix), [])
+
+
+class CopyFetchTests:
+    """Checks the files fetched on disk and the prefetching."""
+
+    def check_copy(self, fetcher, local_prefix, name=lambda f: f):
+        # the prefetched files appear without being fetched
+        fetcher.prefetch([name(f) for f in BLOBS])
+        paths = [os.path.join(local_prefix, name(f)) for f in BLOBS]
+        deadline = time.time() + 10
+        while not all(map(os.path.exists, paths)) and time.time() < deadline:
+            time.sleep(0.01)
+        self.assertTrue(all(map(os.path.exists, paths)))
+
+        for f, contents in BLOBS.items():
+            fetcher.fetch(name(f))
+            with open(os.path.join(local_prefix, name(f)), "rb") as local:
+                self.assertEqual(local.read(), contents)
+        self.assertEqual(fetcher.stats()["num_cached_files"], len(BLOBS))
+
+        dset = dx.stream_line_reader(
+            name("lines.txt"), "line", local_prefix=local_prefix, file_fetcher=fetcher
+        )
+        self.assertEqual([bytes(s["line"]) for s in dset], LINES)
+
+
+class TestLocalFileFetcher(CopyFetchTests, InMemoryFetchTests, unittest.TestCase):
+    def setUp(self):
+        self.root = tempfile.TemporaryDirectory()
+        self.local_prefix = tempfile.TemporaryDirectory()
+        write_files(self.root.name)
+
+    def tearDown(self):
+        self.root.cleanup()
+        self.local_prefix.cleanup()
+
+    def test_copy(self):
+        fetcher = core.LocalFileFetcher(
+            prefix=self.root.name,
+            local_prefix=self.local_prefix.name,
+            buffer_size=64 * 1024,
+            num_prefetch_max=len(BLOBS),
+        )
+        self.check_copy(fetcher, self.local_prefix.name)
+
+    def test_in_memory(self):
+        fetcher = core.LocalFileFetcher(
+            prefix=self.root.name, local_prefix=self.local_prefix.name, in_memory=True
+        )
+        self.check_in_memory(fetcher, self.local_prefix.name)
+
+    def test_file_url(self):
+        fetcher = core.URLFileFetcher(
+            local_prefix=self.local_prefix.name,
+            buffer_size=64 * 1024,
+            num_prefetch_max=len(BLOBS),
+        )
+        self.assertIn("file", core.URLFileFetcher.schemes())
+        url = lambda f: "file://" + os.path.join(os.path.abspath(self.root.name), f)
+        self.check_copy(fetcher, self.local_prefix.name, url)
+
+        with self.assertRaises(RuntimeError):
+            fetcher.fetch("unknown://host/file.txt")
+
+
+class RangeRequestHandler(http.server.SimpleHTTPRequestHandler):
+    """Serves byte ranges, which SimpleHTTPRequestHandler ignores."""
+
+    def do_GET(self):
+        path = self.translate_path(self.path)
+        if not os.path.isfile(path):
+            self.send_error(404)
+            return
+        with open(path, "rb") as f:
+            data = f.read()
+        if "Range" in self.headers:
+            begin, end = self.headers["Range"].split("=")[1].split("-")
+            begin, end = int(begin), min(int(end or len(data) - 1), len(data) - 1)
+            self.send_response(206)
+            self.send_header("Content-Range", f"bytes {begin}-{end}/{len(data)}")
+            data = data[begin : end + 1]
+        else:
+            self.send_response(200)
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def log_message(self, *args):
+        pass
+
+
+class QuietRequestHandler(http.server.SimpleHTTPRequestHandler):
+    def log_message(self, *args):
+        pass
+
+
+@unittest.skipUnless(
+    hasattr(core, "HTTPFileFetcher"), "mlx.data built without HTTP support"
+)
+class TestHTTPFileFetcher(CopyFetchTests, unittest.TestCase):
+    def setUp(self):
+        self.root = tempfile.TemporaryDirectory()
+        self.local_prefix = tempfile.TemporaryDirectory()
+        write_files(self.root.name)
+        self.servers = []
+
+    def tearDown(self):
+        for server in self.servers:
+            server.shutdown()
+            server.server_close()
+        self.root.cleanup()
+        self.local_prefix.cleanup()
+
+    def serve(self, handler):
+        server = http.server.ThreadingHTTPServer(
+            ("127.0.0.1", 0), functools.partial(handler, directory=self.root.name)
+        )
+        threading.Thread(target=server.serve_forever, daemon=True).start()
+        self.servers.append(server)
+        return f"http://127.0.0.1:{server.server_address[1]}"
+
+    def test_range_requests(self):
+        fetcher = core.HTTPFileFetcher(
+            self.serve(RangeRequestHandler),
+            local_prefix=self.local_prefix.name,
+            buffer_size=64 * 1024,
+            num_prefetch_max=len(BLOBS),
+        )
+        self.check_copy(fetcher, self.local_prefix.name)
+
+    def test_ranges_ignored(self):
+        fetcher = core.HTTPFileFetcher(
+            self.serve(QuietRequestHandler),
+            local_prefix=self.local_prefix.name,
+            buffer_size=64 * 1024,
+            num_prefetch_max=len(BLOBS),
+        )
+        self.check_copy(fetcher, self.local_prefix.name)
+
+    def test_http_url(self):
+        base_url = self.serve(RangeRequestHandler)
+        fetcher = core.URLFileFetcher(
+            local_prefix=self.local_prefix.name,
+            buffer_size=64 * 1024,
+            num_prefetch_max=len(BLOBS),
+        )
+        self.check_copy(fetcher, self.local_prefix.name, lambda f: f"{base_url}/{f}")
+
+
+@unittest.skipUnless(
+    hasattr(core, "AWSFileFetcher"), "mlx.data built without AWS support"
+)
+class TestAWSInMemoryFetch(InMemoryFetchTests, unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        # moto provides a local S3-compatible server
+        try:
+            import boto3
+            from moto.server import ThreadedMotoServer
+        except ImportError:
+            raise unittest.SkipTest("boto3 and moto[server] are needed")
+
+        cls.server = ThreadedMotoServer(ip_address="127.0.0.1", port=0)
+        cls.server.start()
+        host, port = cls.server.get_host_and_port()
+        cls.endpoint = f"http://{host}:{port}"
+
+        s3 = boto3.client(
+            "s3",
+            endpoint_url=cls.endpoint,
+            region_name="us-east-1",
+            aws_access_key_id="testing",
+            aws_secret_access_key="testing",
+        )
+        s3.create_bucket(Bucket="mlx-data-test")
+        with tempfile.TemporaryDirectory() as root:
+            write_files(root)
+            for name in os.listdir(root):
+                s3.upload_file(os.path.join(root, name), "mlx-data-test", name)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.server.stop()
+
+    def test_in_memory(self):
+        with tempfile.TemporaryDirectory() as local_prefix:
+            fetcher = core.AWSFileFetcher(
+                "mlx-data-test",
+                endpoint=self.endpoint,
+                region="us-east-1",
+                local_prefix=local_prefix,
+                verify_ssl=False,
+                buffer_size=16,
+                access_key_id="testing",
+                secret_access_key="testing",
+                in_memory=True,
+            )
+            self.check_in_memory(fetcher, local_prefix)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1,5 +1,9 @@
 # Copyright © 2024 Apple Inc.
 
+import io
+import os
+import tarfile
+import tempfile
 import unittest
 
 import numpy as np
@@ -43,6 +47,47 @@ class TestGeneralOps(unittest.TestCase):
         for i, s in zip(range(20), sliced_dset):
             self.assertTrue(bytes(s["a"]) in options[i % 2])
 
+    def test_partition(self):
+        calls = []
+
+        def double(x):
+            calls.append(int(x))
+            return x * 2
+
+        dset = (
+            dx.stream_python_iterable(lambda: ({"a": i} for i in range(10)))
+            .key_transform("a", double)
+            .partition(3, 1)
+        )
+        self.assertEqual([int(s["a"]) for s in dset], [2, 8, 14])
+        # the samples of the other partitions are skipped, not transformed
+        self.assertEqual(calls, [1, 4, 7])
+
+    def test_read_from_tar_in_place(self):
+        contents = bytes(range(100))
+        with tempfile.TemporaryDirectory() as root:
+            path = os.path.join(root, "archive.tar")
+            with tarfile.open(path, "w") as tar:
+                info = tarfile.TarInfo("a.bin")
+                info.size = len(contents)
+                tar.addfile(info, io.BytesIO(contents))
+            with open(path, "rb") as f:
+                archive = f.read()
+
+            # the contents are a private mapping of the archive
+            files = dx.buffer_from_vector([{"file": b"a.bin"}])
+            x = files.read_from_tar(path, "file", "x")[0]["x"]
+            x += 1
+            self.assertEqual(bytes(x), bytes(range(1, 101)))
+
+            dset = files.read_from_tar(path, "file", "x").key_transform(
+                "x", lambda x: np.multiply(x, 2, out=x)
+            )
+            self.assertEqual(bytes(dset[0]["x"]), bytes(range(0, 200, 2)))
+
+            with open(path, "rb") as f:
+                self.assertEqual(f.read(), archive)
+
 
 if __name__ == "__main__":
     unittest.main()
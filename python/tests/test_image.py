@@ -0,0 +1,387 @@
+# Copyright © 2024 Apple Inc.
+
+import os
+import struct
+import tempfile
+import unittest
+import zlib
+
+import numpy as np
+
+import mlx.data as dx
+from mlx.data import core
+
+
+def random_image(h, w, seed=0):
+    return np.random.RandomState(seed).randint(0, 256, (h, w, 3)).astype(np.uint8)
+
+
+def write_ppm(path, image):
+    # a lossless format decoded by every build
+    h, w, _ = image.shape
+    with open(path, "wb") as f:
+        f.write(f"P6\n{w} {h}\n255\n".encode() + image.tobytes())
+
+
+def write_png(path, pixels, color_type, bit_depth=8, palette=None):
+    # unfiltered rows, enough for the decoders to go through all the formats
+    h, w = pixels.shape[:2]
+    rows = pixels.astype(">u2" if bit_depth == 16 else np.uint8).reshape(h, -1)
+    ihdr = struct.pack(">IIBBBBB", w, h, bit_depth, color_type, 0, 0, 0)
+    chunks = [(b"IHDR", ihdr)]
+    if palette is not None:
+        chunks.append((b"PLTE", palette.tobytes()))
+    idat = zlib.compress(b"".join(b"\0" + row.tobytes() for row in rows))
+    chunks += [(b"IDAT", idat), (b"IEND", b"")]
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        for tag, body in chunks:
+            f.write(struct.pack(">I", len(body)) + tag + body)
+            f.write(struct.pack(">I", zlib.crc32(tag + body)))
+
+
+# lossless 4x3 images of np.arange(36) * 7 (RGB) and np.arange(48) * 5 (RGBA)
+RGB_WEBP = bytes.fromhex(
+    "5249464634000000574542505650384c270000002f038000005f20164cce11e46f1bc354dca162"
+    "fe13db81208044219658669965964923fa1f98ee00"
+)
+RGBA_WEBP = bytes.fromhex(
+    "524946463a000000574542505650384c2e0000002f038000105f20164cae19e48f1bc3505c8142"
+    "41da062c96d0ee24e81f080248146289659659669934a2ff81e90e"
+)
+
+
+class TestImage(unittest.TestCase):
+    def setUp(self):
+        self.root = tempfile.TemporaryDirectory()
+        self.image = random_image(48, 64)
+        write_ppm(os.path.join(self.root.name, "image.ppm"), self.image)
+        self.files = dx.buffer_from_vector([{"file": b"image.ppm"}])
+
+    def tearDown(self):
+        self.root.cleanup()
+
+    def test_load_image_random_area_crop(self):
+        # the whole image
+        crop = self.files.load_image_random_area_crop(
+            "file", (1.0, 1.0), (1.0, 1.0), prefix=self.root.name
+        )[0]["file"]
+        self.assertEqual(crop.dtype, np.uint8)
+        self.assertTrue(np.array_equal(crop, self.image))
+
+        # a part of the image within the requested area
+        dset = self.files.load_image_random_area_crop(
+            "file", (0.25, 0.5), (0.75, 1.33), num_trial=100, prefix=self.root.name
+        )
+        for _ in range(5):
+            crop = dset[0]["file"]
+            h, w, c = crop.shape
+            self.assertEqual(c, 3)
+            self.assertGreaterEqual(h * w, 0.25 * 48 * 64)
+            self.assertLessEqual(h * w, 0.5 * 48 * 64)
+            found = any(
+                np.array_equal(self.image[y : y + h, x : x + w], crop)
+                for y in range(48 - h + 1)
+                for x in range(64 - w + 1)
+            )
+            self.assertTrue(found)
+
+        # resized jpeg crops decoded from memory
+        dx.buffer_from_vector([{"image": self.image, "name": b"image"}]).save_image(
+            "image", "name", self.root.name
+        )[0]
+        with open(os.path.join(self.root.name, "image.jpg"), "rb") as f:
+            contents = np.frombuffer(f.read(), dtype=np.uint8)
+        crop = dx.buffer_from_vector([{"image": contents}]).load_image_random_area_crop(
+            "image",
+            (0.08, 1.0),
+            (0.75, 1.33),
+            from_memory=True,
+            resize_width=16,
+            resize_height=12,
+        )[0]["image"]
+        self.assertEqual(crop.shape, (12, 16, 3))
+        self.assertEqual(crop.dtype, np.uint8)
+
+        # jpeg crops, decoded partially, are the same region of a full decode,
+        # down to a few pixels
+        jpeg = dx.buffer_from_vector([{"file": b"image.jpg"}])
+        full = jpeg.load_image("file", prefix=self.root.name)[0]["file"]
+        for area in ((0.25, 0.5), (0.001, 0.002)):
+            dset = jpeg.load_image_random_area_crop(
+                "file", area, (0.75, 1.33), num_trial=100, prefix=self.root.name
+            )
+            for _ in range(5):
+                crop = dset[0]["file"]
+                h, w, _ = crop.shape
+                found = any(
+                    np.array_equal(full[y : y + h, x : x + w], crop)
+                    for y in range(48 - h + 1)
+                    for x in range(64 - w + 1)
+                )
+                self.assertTrue(found)
+
+    def test_affine(self):
+        dset = dx.buffer_from_vector([{"image": self.image}])
+        for interpolation in ("nearest", "bilinear"):
+            for crop in (False, True):
+                out = dset.image_affine(
+                    "image", [1, 0, 0, 0, 1, 0], crop, interpolation
+                )[0]["image"]
+                self.assertEqual(out.dtype, np.uint8)
+                self.assertTrue(np.array_equal(out, self.image))
+
+        out = dset.image_random_affine("image", (0, 0))[0]["image"]
+        self.assertTrue(np.array_equal(out, self.image))
+
+        out = dset.image_random_affine(
+            "image", (-30, 30), (0.8, 1.2), (-10, 10), (-0.1, 0.1)
+        )[0]["image"]
+        self.assertEqual(out.shape, self.image.shape)
+        self.assertEqual(out.dtype, np.uint8)
+
+    def test_normalize(self):
+        dset = dx.buffer_from_vector([{"image": self.image}])
+        out = dset.image_normalize("image", [0], [1])[0]["image"]
+        self.assertEqual(out.dtype, np.float32)
+        self.assertTrue(np.allclose(out, self.image / 255, atol=1e-6))
+
+        mean, std = [0.5, 0.4, 0.3], [0.2, 0.3, 0.4]
+        out = dset.image_normalize("image", mean, std, channels_first=True)[0]["image"]
+        expected = ((self.image / 255 - np.array(mean)) / np.array(std)).transpose(
+            2, 0, 1
+        )
+        self.assertEqual(out.shape, (3, 48, 64))
+        self.assertTrue(np.allclose(out, expected, atol=1e-5))
+
+        # batches of images are normalized at once
+        out = dset.batch(1).image_normalize("image", mean, std)[0]["image"]
+        self.assertEqual(out.shape, (1, 48, 64, 3))
+        self.assertTrue(np.allclose(out[0], expected.transpose(1, 2, 0), atol=1e-5))
+
+    def test_batch_slots(self):
+        # the last transform before batch() writes into the batch directly
+        samples = [
+            {"image": random_image(30 + 7 * i, 40 + 3 * i, seed=i), "label": i}
+            for i in range(5)
+        ]
+        dset = dx.buffer_from_vector(samples).image_resize("image", 16, 12)
+        per_sample = [s["image"] for s in dset]
+
+        batches = list(dset.batch(2))
+        shapes = [b["image"].shape for b in batches]
+        self.assertEqual(shapes, [(2, 12, 16, 3), (2, 12, 16, 3), (1, 12, 16, 3)])
+        images = np.concatenate([b["image"] for b in batches])
+        self.assertTrue(np.array_equal(images, np.stack(per_sample)))
+        labels = np.concatenate([b["label"] for b in batches])
+        self.assertEqual(labels.tolist(), list(range(5)))
+
+        stream = dset.to_stream().image_normalize("image", [0.5], [0.25]).batch(2)
+        expected = (np.stack(per_sample) / 255 - 0.5) / 0.25
+        out = np.concatenate([b["image"] for b in stream])
+        self.assertEqual(out.dtype, np.float32)
+        self.assertTrue(np.allclose(out, expected, atol=1e-5))
+
+    def test_resize_batch(self):
+        constant = np.full((30, 50, 3), 77, dtype=np.uint8)
+        samples = [
+            {"image": constant, "label": 0},
+            {"image": self.image, "label": 1},
+            {"image": random_image(20, 90), "label": 2},
+        ]
+        dset = dx.buffer_from_vector(samples)
+        for name in ("box", "bilinear", "bicubic", "lanczos"):
+            batch = dset.image_resize_batch(3, "image", 64, 48, filter=name)[0]
+            self.assertEqual(batch["image"].shape, (3, 48, 64, 3))
+            self.assertEqual(batch["image"].dtype, np.uint8)
+            self.assertEqual(batch["label"].tolist(), [0, 1, 2])
+            self.assertTrue(np.all(batch["image"][0] == 77))
+            # images already of the target size are unchanged
+            self.assertTrue(np.array_equal(batch["image"][1], self.image))
+
+        batch = next(dset.to_stream().image_resize_batch(2, "image", 16, 12))
+        self.assertEqual(batch["image"].shape, (2, 12, 16, 3))
+
+    def test_photometric(self):
+        dset = dx.buffer_from_vector([{"image": self.image}])
+        out = dset.image_random_color_jitter("image", 0, 0, 0, 0)[0]["image"]
+        self.assertTrue(np.array_equal(out, self.image))
+        out = dset.image_random_color_jitter("image", 0.4, 0.4, 0.4, 0.1)[0]["image"]
+        self.assertEqual(out.shape, self.image.shape)
+        self.assertEqual(out.dtype, np.uint8)
+
+        out = dset.image_random_grayscale("image", 1)[0]["image"]
+        self.assertEqual(out.shape, self.image.shape)
+        self.assertTrue(np.array_equal(out[..., 0], out[..., 1]))
+        self.assertTrue(np.array_equal(out[..., 0], out[..., 2]))
+        out = dset.image_random_grayscale("image", 0)[0]["image"]
+        self.assertTrue(np.array_equal(out, self.image))
+
+        out = dset.image_gaussian_blur("image", (0.5, 2.0))[0]["image"]
+        self.assertEqual(out.shape, self.image.shape)
+        self.assertEqual(out.dtype, np.uint8)
+        constant = np.full((48, 64, 3), 77, dtype=np.uint8)
+        out = dx.buffer_from_vector([{"image": constant}]).image_gaussian_blur(
+            "image", (1.0, 3.0)
+        )[0]["image"]
+        self.assertTrue(np.array_equal(out, constant))
+
+        # the alpha channel is not blurred
+        rgba = np.random.RandomState(0).randint(0, 256, (48, 64, 4), np.uint8)
+        out = dx.buffer_from_vector([{"image": rgba}]).image_gaussian_blur(
+            "image", (1.0, 3.0)
+        )[0]["image"]
+        self.assertTrue(np.array_equal(out[..., 3], rgba[..., 3]))
+        self.assertFalse(np.array_equal(out[..., :3], rgba[..., :3]))
+
+    def test_image_cache(self):
+        names = [f"image{i}.ppm" for i in range(3)]
+        for i, name in enumerate(names):
+            write_ppm(os.path.join(self.root.name, name), random_image(48, 64, i))
+        files = dx.buffer_from_vector([{"file": name.encode()} for name in names])
+        cache = core.ImageCache(1 << 20)
+        dset = files.load_image("file", prefix=self.root.name, cache=cache)
+        first = [s["file"] for s in dset]
+        second = [s["file"] for s in dset]
+        for a, b in zip(first, second):
+            self.assertTrue(np.array_equal(a, b))
+        stats = cache.stats()
+        self.assertEqual(stats["num_misses"], 3)
+        self.assertEqual(stats["num_hits"], 3)
+
+        # images evicted from memory are read back from the spill file
+        spill_path = os.path.join(self.root.name, "images.cache")
+        cache = core.ImageCache(0, spill_path, 1 << 20)
+        dset = files.load_image("file", prefix=self.root.name, cache=cache)
+        for a, b in zip(first, dset):
+            self.assertTrue(np.array_equal(a, b["file"]))
+        self.assertEqual(cache.stats()["num_spill_hits"], 0)
+        for a, b in zip(first, dset):
+            self.assertTrue(np.array_equal(a, b["file"]))
+        self.assertEqual(cache.stats()["num_spill_hits"], 3)
+        self.assertFalse(os.path.exists(spill_path))
+
+    def test_rotate(self):
+        # the pixel centers are mapped, so right angles move pixels exactly
+        dset = dx.buffer_from_vector([{"image": self.image}])
+        expected = {
+            180: np.flip(self.image, (0, 1)),
+            90: np.rot90(self.image, -1),
+            -90: np.rot90(self.image),
+        }
+        for interpolation in ("nearest", "bilinear"):
+            for angle, rotated in expected.items():
+                out = dset.image_rotate(
+                    "image", angle, interpolation=interpolation
+                )[0]["image"]
+                self.assertEqual(out.shape, rotated.shape)
+                self.assertTrue(np.array_equal(out, rotated))
+
+    def load(self, name, **kwargs):
+        files = dx.buffer_from_vector([{"file": name.encode()}])
+        image = files.load_image("file", prefix=self.root.name, **kwargs)[0]["file"]
+        with open(os.path.join(self.root.name, name), "rb") as f:
+            contents = np.frombuffer(f.read(), dtype=np.uint8)
+        memory = dx.buffer_from_vector([{"image": contents}])
+        from_memory = memory.load_image("image", from_memory=True, **kwargs)
+        self.assertTrue(np.array_equal(image, from_memory[0]["image"]))
+        return image
+
+    def test_load_png(self):
+        rng = np.random.RandomState(1)
+        rgb = rng.randint(0, 256, (12, 16, 3)).astype(np.uint8)
+        deep = rng.randint(0, 2**16, (12, 16, 3)).astype(np.uint16)
+        gray_alpha = rng.randint(0, 256, (12, 16, 2)).astype(np.uint8)
+        rgba = rng.randint(0, 256, (12, 16, 4)).astype(np.uint8)
+        palette = rng.randint(0, 256, (16, 3)).astype(np.uint8)
+        indices = rng.randint(0, 16, (12, 16)).astype(np.uint8)
+
+        # decoded as by stb_image: 8 bits per channel, palettes expanded to RGB
+        # and the alpha channel dropped except for gray images
+        cases = (
+            ("rgb", rgb, 2, 8, None, rgb),
+            ("deep", deep, 2, 16, None, (deep >> 8).astype(np.uint8)),
+            ("gray", rgb[..., 0], 0, 8, None, rgb[..., :1]),
+            ("gray_alpha", gray_alpha, 4, 8, None, gray_alpha),
+            ("rgba", rgba, 6, 8, None, rgba[..., :3]),
+            ("palette", indices, 3, 8, palette, palette[indices]),
+        )
+        for name, pixels, color_type, bit_depth, plte, expected in cases:
+            path = os.path.join(self.root.name, name + ".png")
+            write_png(path, pixels, color_type, bit_depth, plte)
+            image = self.load(name + ".png")
+            self.assertEqual(image.dtype, np.uint8)
+            self.assertTrue(np.array_equal(image, expected), name)
+            info = self.load(name + ".png", info=True)
+            self.assertEqual(info.tolist(), [16, 12])
+
+    @unittest.skipUnless(
+        core.libs_version().get("webp"), "mlx.data built without libwebp"
+    )
+    def test_load_webp(self):
+        rgb = (np.arange(36) * 7).astype(np.uint8).reshape(3, 4, 3)
+        rgba = (np.arange(48) * 5).astype(np.uint8).reshape(3, 4, 4)
+        for name, contents, expected in (
+            ("rgb.webp", RGB_WEBP, rgb),
+            ("rgba.webp", RGBA_WEBP, rgba[..., :3]),
+        ):
+            with open(os.path.join(self.root.name, name), "wb") as f:
+                f.write(contents)
+            self.assertTrue(np.array_equal(self.load(name), expected), name)
+            self.assertEqual(self.load(name, info=True).tolist(), [4, 3])
+
+    def test_info(self):
+        # the size is read from the header, the pixels are not decoded
+        path = os.path.join(self.root.name, "image.png")
+        write_png(path, random_image(12, 16), 2)
+        with open(path, "rb") as f:
+            contents = bytearray(f.read())
+        # the image data lies between the IHDR chunk and the IDAT checksum
+        contents[41:-16] = bytes(len(contents) - 57)
+        with open(path, "wb") as f:
+            f.write(contents)
+        self.assertEqual(self.load("image.png", info=True).tolist(), [16, 12])
+        with self.assertRaises(RuntimeError):
+            self.load("image.png")
+
+        # headers cut short, the first jpeg segment ending after the data
+        dx.buffer_from_vector([{"image": self.image, "name": b"image"}]).save_image(
+            "image", "name", self.root.name
+        )[0]
+        with open(os.path.join(self.root.name, "image.jpg"), "rb") as f:
+            jpeg = f.read()
+        for contents, expected in (
+            (contents[:30], [16, 12]),
+            (contents[:20], [0, 0]),
+            (jpeg[:8], [0, 0]),
+        ):
+            dset = dx.buffer_from_vector([{"image": np.frombuffer(contents, np.uint8)}])
+            info = dset.load_image("image", from_memory=True, info=True)[0]["image"]
+            self.assertEqual(info.tolist(), expected)
+
+    def test_load_image_resize_smallest_side(self):
+        # a smooth image such that jpeg decoded at a lower scale stays close
+        y, x = np.mgrid[:75, :99]
+        c = np.arange(3)
+        image = 128 + 100 * np.sin(x[..., None] / 16 + c) * np.cos(y[..., None] / 12)
+        image = image.astype(np.uint8)
+        dx.buffer_from_vector([{"image": image, "name": b"smooth"}]).save_image(
+            "image", "name", self.root.name
+        )[0]
+        write_png(os.path.join(self.root.name, "smooth.png"), image, 2)
+
+        for name in ("smooth.jpg", "smooth.png"):
+            full = dx.buffer_from_vector([{"image": self.load(name)}])
+            for side in (40, 31, 20):
+                resized = self.load(name, resize_smallest_side=side)
+                expected = full.image_resize_smallest_side("image", side)[0]["image"]
+                self.assertEqual(resized.shape, expected.shape)
+                diff = np.abs(resized.astype(np.int32) - expected)
+                if name.endswith(".png"):
+                    self.assertEqual(diff.max(), 0)
+                else:
+                    self.assertLess(diff.mean(), 4)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,98 @@
+# Copyright © 2024 Apple Inc.
+
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+
+import numpy as np
+
+import mlx.data as dx
+from mlx.data import core
+
+NUM_FRAMES = 20
+
+
+@unittest.skipUnless(
+    core.libs_version().get("ffmpeg") and shutil.which("ffmpeg"),
+    "mlx.data built without FFmpeg or ffmpeg not found",
+)
+class TestVideoClips(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        # a keyframe every 5 frames such that distant clips are seeked to
+        cls.root = tempfile.TemporaryDirectory()
+        subprocess.run(
+            [
+                "ffmpeg",
+                "-loglevel",
+                "error",
+                "-f",
+                "lavfi",
+                "-i",
+                f"testsrc=size=32x24:rate=10:duration={NUM_FRAMES / 10}",
+                "-c:v",
+                "mpeg4",
+                "-g",
+                "5",
+                os.path.join(cls.root.name, "video.mp4"),
+            ],
+            check=True,
+        )
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.root.cleanup()
+
+    def clips(self, clip_length, stride=0):
+        return (
+            dx.buffer_from_vector([{"file": b"video.mp4", "label": 3}])
+            .to_stream()
+            .video_clips_from_key(
+                "file",
+                "clip",
+                clip_length,
+                stride=stride,
+                index_key="index",
+                local_prefix=self.root.name,
+            )
+        )
+
+    def test_clips(self):
+        # overlapping clips share their frames
+        clips = list(self.clips(4, stride=2))
+        self.assertEqual(len(clips), (NUM_FRAMES - 4) // 2 + 1)
+        for i, clip in enumerate(clips):
+            self.assertEqual(clip["clip"].shape, (4, 24, 32, 3))
+            self.assertEqual(clip["index"], i)
+            self.assertEqual(clip["label"], 3)
+        for a, b in zip(clips, clips[1:]):
+            self.assertTrue(np.array_equal(a["clip"][2:], b["clip"][:2]))
+
+        # the frames in between distant clips are skipped
+        distant = list(self.clips(4, stride=8))
+        self.assertEqual(len(distant), 3)
+        for i, clip in enumerate(distant):
+            self.assertTrue(np.array_equal(clip["clip"], clips[4 * i]["clip"]))
+
+        # the clips are skipped by partitions
+        odd = list(self.clips(4, stride=2).partition(2, 1))
+        self.assertEqual([c["index"] for c in odd], [1, 3, 5, 7])
+        for clip in odd:
+            expected = clips[int(clip["index"])]["clip"]
+            self.assertTrue(np.array_equal(clip["clip"], expected))
+
+    def test_reset(self):
+        stream = self.clips(8, stride=6)
+        first = list(stream)
+        self.assertEqual(len(first), 3)
+        stream.reset()
+        second = list(stream)
+        self.assertEqual(len(second), len(first))
+        for a, b in zip(first, second):
+            self.assertTrue(np.array_equal(a["clip"], b["clip"]))
+
+
+if __name__ == "__main__":
+    unittest.main()